@@ -0,0 +1,661 @@
+/*
+ * Name  : Benchmark
+ * Path  :
+ * Use   : End-to-end benchmark. For a set of generated meshes of
+ *         increasing size, the phases
+ *           read (sequential and parallel reader), mesh check,
+ *           face and cell geometry (per entity vs. MeshGeometry),
+ *           computational mesh build, matrix setup and solve
+ *         are timed separately. Throughput (cells/s, nnz/s) and the
+ *         peak memory are reported as text or as JSON.
+ *
+ *         With --dense, the dense LU (DenseLU) is compared with
+ *         LinearSolver::GaussElim on dense matrices instead.
+ *
+ *         Usage: Benchmark [--json] [--sizes n1,n2,...] [--threads n] [--rtol x] [--direct] [--dense n1,n2,...] [--keep] [--profile]
+ *           --json    : write JSON to stdout (for regression tracking)
+ *           --sizes   : number of quads per side, default 16,32,64,128
+ *           --threads : threads used by the parallel reader, 0 = all
+ *           --rtol    : relative residual tolerance of the solver,
+ *                       default: iterate to the update tolerance only
+ *           --direct  : solve with the sparse LU instead of SOR
+ *           --dense   : dense benchmark for matrices of order n1, n2, ...
+ *           --keep    : keep the generated mesh files
+ *           --profile : append the profiling report; reports that
+ *                       profiling was compiled out unless all projects
+ *                       are built with FV2D_ENABLE_PROFILING
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#include "FiniteVolume2DLib/ASCIIMeshReader.h"
+#include "FiniteVolume2DLib/ParallelASCIIMeshReader.h"
+#include "FiniteVolume2DLib/MeshGenerator.h"
+#include "FiniteVolume2DLib/MeshBuilder.h"
+#include "FiniteVolume2DLib/NodeManager.h"
+#include "FiniteVolume2DLib/FaceManager.h"
+#include "FiniteVolume2DLib/CellManager.h"
+#include "FiniteVolume2DLib/EntityCreatorManager.h"
+#include "FiniteVolume2DLib/Util.h"
+#include "FiniteVolume2DLib/Mesh.h"
+#include "FiniteVolume2DLib/BoundaryConditionCollection.h"
+#include "FiniteVolume2DLib/MeshChecker.h"
+#include "FiniteVolume2DLib/Profiler.h"
+#include "FiniteVolume2DLib/MeshGeometry.h"
+
+#include "FiniteVolume2D/ComputationalMesh.h"
+#include "FiniteVolume2D/ComputationalMeshBuilder.h"
+#include "FiniteVolume2D/ComputationalMeshSolverHelper.h"
+#include "FiniteVolume2D/DiffusionFluxEvaluator.h"
+#include "FiniteVolume2D/ComputationalCell.h"
+
+#include "Solver/CMatrix2D.h"
+#include "Solver/DenseLU.h"
+#include "Solver/LinearSolver.h"
+
+#include <boost/format.hpp>
+#include <boost/optional.hpp>
+#include <boost/tokenizer.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <algorithm>
+#include <cmath>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+
+
+namespace {
+
+    struct Options {
+        Options() : json(false), nthreads(0), rtol(0), direct(false), keep(false), profile(false) {}
+
+        bool                      json;
+        unsigned int              nthreads;
+        double                    rtol;
+        bool                      direct;
+        bool                      keep;
+        bool                      profile;
+        std::vector<unsigned int> sizes;
+        std::vector<unsigned int> dense_sizes;
+    };
+
+    struct DenseResult {
+        DenseResult() : n(0), t_gauss(0), t_factorize(0), t_solve(0), residual_gauss(0), residual_lu(0) {}
+
+        unsigned int n;
+        double       t_gauss;
+        double       t_factorize;
+        double       t_solve;
+        double       residual_gauss;
+        double       residual_lu;
+    };
+
+    struct Result {
+        Result() : n(0), nnodes(0), nfaces(0), ncells(0), nnz(0),
+                   t_generate(0), t_read(0), t_read_parallel(0), t_check(0), t_geometry(0), t_geometry_batch(0),
+                   t_build(0), t_setup(0), t_solve(0), iterations(0), residual(0), peak_memory(0), success(false) {}
+
+        unsigned int    n;
+        std::size_t     nnodes;
+        std::size_t     nfaces;
+        std::size_t     ncells;
+        boost::uint64_t nnz;
+
+        // wall times in seconds
+        double          t_generate;
+        double          t_read;
+        double          t_read_parallel;
+        double          t_check;
+        double          t_geometry;
+        double          t_geometry_batch;
+        double          t_build;
+        double          t_setup;
+        double          t_solve;
+
+        // solver
+        unsigned int    iterations;
+        double          residual;
+
+        // peak resident memory in bytes after this case
+        boost::uint64_t peak_memory;
+
+        bool            success;
+    };
+
+    class Timer {
+    public:
+        Timer() : start_(std::chrono::high_resolution_clock::now()) {}
+
+        double elapsed() const {
+            std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start_;
+            return diff.count();
+        }
+
+    private:
+        std::chrono::high_resolution_clock::time_point start_;
+    };
+
+    // silences std::cout for its lifetime, i.e. the mesh builder report
+    class CoutSilencer {
+    public:
+        CoutSilencer() : buf_(std::cout.rdbuf(sink_.rdbuf())) {}
+
+        ~CoutSilencer() {
+            std::cout.rdbuf(buf_);
+        }
+
+    private:
+        CoutSilencer(CoutSilencer const &);
+        CoutSilencer & operator=(CoutSilencer const &);
+
+    private:
+        std::ostringstream sink_;
+        std::streambuf *   buf_;
+    };
+
+    boost::uint64_t
+    peakMemory() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS pmc;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+            return pmc.PeakWorkingSetSize;
+        return 0;
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+#ifdef __APPLE__
+        return usage.ru_maxrss;
+#else
+        // kilobytes
+        return boost::uint64_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+    }
+
+    double
+    rate(double count, double seconds) {
+        return seconds > 0 ? count / seconds : 0;
+    }
+
+    // stores the results of the timed loops, which the compiler might drop otherwise
+    volatile double sink = 0.0;
+
+    bool
+    parseSizes(std::string const & sizes, std::vector<unsigned int> & result) {
+        typedef boost::tokenizer<boost::char_separator<char> > Tokenizer_t;
+        boost::char_separator<char> sep(",");
+        Tokenizer_t tokens(sizes, sep);
+
+        for (Tokenizer_t::const_iterator it = tokens.begin(); it != tokens.end(); ++it) {
+            try {
+                unsigned int n = boost::lexical_cast<unsigned int>(*it);
+                if (n == 0)
+                    throw boost::bad_lexical_cast();
+                result.push_back(n);
+            }
+            catch (boost::bad_lexical_cast const &) {
+                boost::format format = boost::format("Invalid size %1%!\n") % *it;
+                return Util::error(format.str());
+            }
+        }
+
+        return true;
+    }
+
+    bool
+    parseOptions(int argc, char* argv[], Options & options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg == "--json")
+                options.json = true;
+            else if (arg == "--direct")
+                options.direct = true;
+            else if (arg == "--keep")
+                options.keep = true;
+            else if (arg == "--profile")
+                options.profile = true;
+            else if (arg == "--threads" && i + 1 < argc) {
+                try {
+                    options.nthreads = boost::lexical_cast<unsigned int>(argv[++i]);
+                }
+                catch (boost::bad_lexical_cast const &) {
+                    boost::format format = boost::format("Invalid number of threads %1%!\n") % argv[i];
+                    return Util::error(format.str());
+                }
+            }
+            else if (arg == "--rtol" && i + 1 < argc) {
+                try {
+                    options.rtol = boost::lexical_cast<double>(argv[++i]);
+                }
+                catch (boost::bad_lexical_cast const &) {
+                    boost::format format = boost::format("Invalid tolerance %1%!\n") % argv[i];
+                    return Util::error(format.str());
+                }
+            }
+            else if (arg == "--sizes" && i + 1 < argc) {
+                if (!parseSizes(argv[++i], options.sizes))
+                    return false;
+            }
+            else if (arg == "--dense" && i + 1 < argc) {
+                if (!parseSizes(argv[++i], options.dense_sizes))
+                    return false;
+            }
+            else {
+                boost::format format = boost::format("Usage: %1% [--json] [--sizes n1,n2,...] [--threads n] [--rtol x] [--direct] [--dense n1,n2,...] [--keep] [--profile]\n") % argv[0];
+                return Util::error(format.str());
+            }
+        }
+
+        if (options.sizes.empty()) {
+            options.sizes.push_back(16);
+            options.sizes.push_back(32);
+            options.sizes.push_back(64);
+            options.sizes.push_back(128);
+        }
+
+        return true;
+    }
+
+    bool
+    runCase(unsigned int n, Options const & options, Result & result) {
+        result.n = n;
+
+        std::string mesh_filename = (boost::format("Benchmark_%1%x%1%.mesh") % n).str();
+
+        /*
+         * Generate the mesh file. Left side hot, right side cold,
+         * no flux through top and bottom.
+         */
+        {
+            Timer timer;
+
+            MeshGenerator generator(0.0, 0.0, 1.0, 1.0, n, n);
+            generator.setBoundaryCondition(MeshGenerator::LEFT,   BoundaryConditionCollection::DIRICHLET, 100.0);
+            generator.setBoundaryCondition(MeshGenerator::RIGHT,  BoundaryConditionCollection::DIRICHLET,   0.0);
+            generator.setBoundaryCondition(MeshGenerator::TOP,    BoundaryConditionCollection::NEUMANN,     0.0);
+            generator.setBoundaryCondition(MeshGenerator::BOTTOM, BoundaryConditionCollection::NEUMANN,     0.0);
+
+            if (!generator.write(mesh_filename)) {
+                boost::format format = boost::format("Could not write mesh file %1%!\n") % mesh_filename;
+                return Util::error(format.str());
+            }
+
+            result.nnodes = generator.getNumberOfNodes();
+            result.nfaces = generator.getNumberOfFaces();
+            result.ncells = generator.getNumberOfCells();
+
+            result.t_generate = timer.elapsed();
+        }
+
+        /*
+         * Parallel reader, timed only
+         */
+        {
+            NodeManager::Ptr node_mgr = NodeManager::create();
+            FaceManager::Ptr face_mgr = FaceManager::create();
+            CellManager::Ptr cell_mgr = CellManager::create();
+            EntityCreatorManager::Ptr entity_mgr = EntityCreatorManager::create(node_mgr, face_mgr, cell_mgr);
+            MeshBuilder mesh_builder(entity_mgr);
+            ParallelASCIIMeshReader reader(mesh_filename, mesh_builder, options.nthreads);
+
+            CoutSilencer silencer;
+
+            Timer timer;
+            bool success = reader.read();
+            result.t_read_parallel = timer.elapsed();
+
+            if (!success) {
+                boost::format format = boost::format("Could not read mesh file %1% in parallel!\n") % mesh_filename;
+                return Util::error(format.str());
+            }
+        }
+
+        /*
+         * Sequential reader, the resulting mesh is used further on
+         */
+        NodeManager::Ptr node_mgr = NodeManager::create();
+        FaceManager::Ptr face_mgr = FaceManager::create();
+        CellManager::Ptr cell_mgr = CellManager::create();
+        EntityCreatorManager::Ptr entity_mgr = EntityCreatorManager::create(node_mgr, face_mgr, cell_mgr);
+        MeshBuilder mesh_builder(entity_mgr);
+        ASCIIMeshReader reader(mesh_filename, mesh_builder);
+
+        {
+            CoutSilencer silencer;
+
+            Timer timer;
+            bool success = reader.read();
+            result.t_read = timer.elapsed();
+
+            if (!success) {
+                boost::format format = boost::format("Could not read mesh file %1%!\n") % mesh_filename;
+                return Util::error(format.str());
+            }
+        }
+
+        if (!options.keep)
+            std::remove(mesh_filename.c_str());
+
+        boost::optional<Mesh::Ptr> mesh_opt = mesh_builder.getMesh();
+        if (!mesh_opt || *mesh_opt == nullptr) {
+            boost::format format = boost::format("Unable to build mesh!\n");
+            return Util::error(format.str());
+        }
+
+        Mesh::Ptr mesh = *mesh_opt;
+        BoundaryConditionCollection const & bc = reader.getBoundaryConditions();
+
+        {
+            Timer timer;
+            bool success = MeshChecker::checkMesh(mesh, bc);
+            result.t_check = timer.elapsed();
+
+            if (!success) {
+                boost::format format = boost::format("Mesh check failed!\n");
+                return Util::error(format.str());
+            }
+        }
+
+        /*
+         * Face and cell geometry, one entity at a time vs. in batches.
+         */
+        {
+            Timer timer;
+
+            Mesh const & geometric_mesh = *mesh;
+
+            double sum = 0.0;
+            IGeometricEntity::Entity_t const face_types[] = {IGeometricEntity::INTERIOR, IGeometricEntity::BOUNDARY};
+
+            for (int t = 0; t < 2; ++t) {
+                Thread<Face> const & faces = geometric_mesh.getFaceThread(face_types[t]);
+
+                std::for_each(faces.begin(), faces.end(), [&sum](Face::Ptr const & face) {
+                    sum += face->area() + face->normal().x() + face->centroid().x();
+                });
+            }
+
+            Thread<Cell> const & cells = geometric_mesh.getCellThread();
+            std::for_each(cells.begin(), cells.end(), [&sum](Cell::Ptr const & cell) {
+                sum += cell->volume() + cell->centroid().x();
+            });
+
+            sink = sum;
+            result.t_geometry = timer.elapsed();
+        }
+
+        {
+            MeshGeometry geometry(*mesh);
+
+            Timer timer;
+            geometry.update();
+            result.t_geometry_batch = timer.elapsed();
+        }
+
+        // orthogonal diffusion flux, i.e. without cross-diffusion as in Main.cpp
+        DiffusionFluxEvaluator evaluator(*mesh, "Temperature", 1.0, DiffusionFluxEvaluator::NONE);
+
+        ComputationalMeshBuilder computational_builder(mesh, bc);
+        computational_builder.addComputationalVariable("Temperature", std::ref(evaluator));
+        computational_builder.addEvaluateCellMolecules([&evaluator](ComputationalCell::Ptr const & ccell) { return evaluator.evaluateCell(ccell); });
+
+        ComputationalMesh::CPtr cmesh = nullptr;
+
+        try {
+            Timer timer;
+            cmesh = computational_builder.build();
+            result.t_build = timer.elapsed();
+        }
+        catch (std::logic_error const & ex) {
+            std::string msg = "Failure building computational mesh!\n";
+            msg += ex.what();
+            return Util::error(msg);
+        }
+
+        ComputationalMeshSolverHelper helper(*cmesh);
+
+        LinearSolver::Control control;
+        control.relative_tolerance = options.rtol;
+        helper.setSolverControl(control);
+
+        if (options.direct)
+            helper.setSolverMethod(ComputationalMeshSolverHelper::SPARSE_LU);
+
+        {
+            Timer timer;
+            helper.setupMatrix();
+            result.t_setup = timer.elapsed();
+        }
+
+        result.nnz = helper.getNumberOfNonZeros();
+
+        {
+            Timer timer;
+            result.success = helper.solveSystem();
+            result.t_solve = timer.elapsed();
+        }
+
+        result.iterations = helper.getSolverStatistics().iterations;
+        result.residual   = helper.getSolverStatistics().residual_norm;
+
+        result.peak_memory = peakMemory();
+
+        return true;
+    }
+
+    double
+    residualNorm(CMatrix2D const & A, std::vector<double> const & x, std::vector<double> const & b) {
+        std::vector<double> y(b.size());
+        A.solve(x, y);
+
+        double sum = 0;
+        for (std::size_t i = 0; i < b.size(); ++i)
+            sum += (b[i] - y[i]) * (b[i] - y[i]);
+
+        return std::sqrt(sum);
+    }
+
+    // diagonally dominant, i.e. GaussElim needs no row exchanges
+    void
+    runDenseCase(unsigned int n, DenseResult & result) {
+        result.n = n;
+
+        CMatrix2D A(n, n);
+        std::vector<double> b(n);
+
+        for (unsigned int i = 0; i < n; ++i) {
+            for (unsigned int j = 0; j < n; ++j)
+                A(i, j) = std::sin(double(7 * i + 3 * j + 1)) + (i == j ? double(n) : 0.0);
+
+            b[i] = std::cos(double(i));
+        }
+
+        std::vector<double> x;
+
+        {
+            Timer timer;
+            std::tie(std::ignore, std::ignore, x) = LinearSolver::GaussElim(A, b);
+            result.t_gauss = timer.elapsed();
+        }
+
+        result.residual_gauss = residualNorm(A, x, b);
+
+        DenseLU lu;
+
+        {
+            Timer timer;
+            lu.factorize(A);
+            result.t_factorize = timer.elapsed();
+        }
+
+        {
+            Timer timer;
+            lu.solve(b, x);
+            result.t_solve = timer.elapsed();
+        }
+
+        result.residual_lu = residualNorm(A, x, b);
+    }
+
+    void
+    writeDenseText(std::vector<DenseResult> const & results, std::ostream & out) {
+        out << boost::format("%|6| %|10| %|10| %|10| %|9| %|12| %|12|\n")
+            % "n" % "gauss" % "factorize" % "solve" % "speedup" % "res_gauss" % "res_lu";
+
+        std::for_each(results.begin(), results.end(), [&out](DenseResult const & r) {
+            out << boost::format("%|6| %|10.4f| %|10.4f| %|10.6f| %|9.1f| %|12.3g| %|12.3g|\n")
+                % r.n % r.t_gauss % r.t_factorize % r.t_solve
+                % (r.t_gauss / std::max(r.t_factorize + r.t_solve, 1E-12))
+                % r.residual_gauss % r.residual_lu;
+        });
+    }
+
+    void
+    writeDenseJSON(std::vector<DenseResult> const & results, std::ostream & out) {
+        out << "{\n  \"benchmark\": \"DenseLU\",\n  \"cases\": [";
+
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            DenseResult const & r = results[i];
+
+            out << (i ? ",\n" : "\n");
+            out << boost::format("    {\"n\": %1%, \"seconds\": {\"gauss\": %2$.6f, \"factorize\": %3$.6f, \"solve\": %4$.6f}, \"residual\": {\"gauss\": %5$.6g, \"lu\": %6$.6g}}")
+                % r.n % r.t_gauss % r.t_factorize % r.t_solve % r.residual_gauss % r.residual_lu;
+        }
+
+        out << "\n  ]\n}\n";
+    }
+
+    void
+    writeText(std::vector<Result> const & results, std::ostream & out) {
+        out << boost::format("%|6| %|9| %|9| %|8| %|8| %|8| %|8| %|8| %|8| %|8| %|8| %|7| %|12| %|12| %|9|\n")
+            % "n" % "cells" % "nnz" % "read" % "read_par" % "check" % "geom" % "geom_soa" % "build" % "setup" % "solve" % "iters" % "cells/s" % "nnz/s" % "peak_MB";
+
+        std::for_each(results.begin(), results.end(), [&out](Result const & r) {
+            double t_total = r.t_read + r.t_check + r.t_build + r.t_setup + r.t_solve;
+
+            out << boost::format("%|6| %|9| %|9| %|8.3f| %|8.3f| %|8.3f| %|8.4f| %|8.4f| %|8.3f| %|8.3f| %|8.3f| %|7| %|12.4g| %|12.4g| %|9.1f|%|s|\n")
+                % r.n % r.ncells % r.nnz
+                % r.t_read % r.t_read_parallel % r.t_check % r.t_geometry % r.t_geometry_batch % r.t_build % r.t_setup % r.t_solve % r.iterations
+                % rate(double(r.ncells), t_total) % rate(double(r.nnz), r.t_setup)
+                % (double(r.peak_memory) / (1024.0 * 1024.0))
+                % (r.success ? "" : "  (solver did not converge)");
+        });
+    }
+
+    void
+    writeJSON(std::vector<Result> const & results, bool profile, std::ostream & out) {
+        out << "{\n  \"benchmark\": \"FiniteVolume2D\",\n  \"cases\": [";
+
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            Result const & r = results[i];
+
+            out << (i ? ",\n" : "\n");
+            out << "    {\n";
+            out << boost::format("      \"n\": %1%, \"nodes\": %2%, \"faces\": %3%, \"cells\": %4%, \"nnz\": %5%,\n")
+                % r.n % r.nnodes % r.nfaces % r.ncells % r.nnz;
+            out << boost::format("      \"seconds\": {\"generate\": %.6f, \"read\": %.6f, \"read_parallel\": %.6f, \"check\": %.6f, \"geometry\": %.6f, \"geometry_batch\": %.6f, \"build\": %.6f, \"setup\": %.6f, \"solve\": %.6f},\n")
+                % r.t_generate % r.t_read % r.t_read_parallel % r.t_check % r.t_geometry % r.t_geometry_batch % r.t_build % r.t_setup % r.t_solve;
+            out << boost::format("      \"throughput\": {\"read_cells_per_s\": %.6g, \"read_parallel_cells_per_s\": %.6g, \"check_cells_per_s\": %.6g, \"build_cells_per_s\": %.6g, \"setup_nnz_per_s\": %.6g, \"solve_nnz_per_s\": %.6g},\n")
+                % rate(double(r.ncells), r.t_read) % rate(double(r.ncells), r.t_read_parallel) % rate(double(r.ncells), r.t_check)
+                % rate(double(r.ncells), r.t_build) % rate(double(r.nnz), r.t_setup) % rate(double(r.nnz), r.t_solve);
+            out << boost::format("      \"solver\": {\"iterations\": %1%, \"residual\": %2$.6g, \"converged\": %3%},\n")
+                % r.iterations % r.residual % (r.success ? "true" : "false");
+            out << boost::format("      \"peak_memory_bytes\": %1%\n") % r.peak_memory;
+            out << "    }";
+        }
+
+        out << "\n  ]";
+
+        if (profile) {
+            out << ",\n  \"profile\": ";
+
+            if (Profiler::isCompiledIn())
+                Profiler::instance().reportJSON(out);
+            else
+                out << "null\n";
+        }
+        else
+            out << "\n";
+
+        out << "}\n";
+    }
+
+}
+
+
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 1;
+
+    Profiler::instance().enable(options.profile);
+
+    if (options.profile && !Profiler::isCompiledIn())
+        std::cerr << "warning: --profile: profiling was compiled out, build with FV2D_ENABLE_PROFILING defined" << std::endl;
+
+    if (!options.dense_sizes.empty()) {
+        std::vector<DenseResult> results;
+
+        for (std::size_t i = 0; i < options.dense_sizes.size(); ++i) {
+            DenseResult result;
+            runDenseCase(options.dense_sizes[i], result);
+            results.push_back(result);
+        }
+
+        if (options.json)
+            writeDenseJSON(results, std::cout);
+        else
+            writeDenseText(results, std::cout);
+
+        return 0;
+    }
+
+    std::vector<Result> results;
+
+    for (std::size_t i = 0; i < options.sizes.size(); ++i) {
+        Result result;
+
+        if (!runCase(options.sizes[i], options, result))
+            return 1;
+
+        results.push_back(result);
+
+        if (!options.json)
+            std::cerr << boost::format("n = %1% done\n") % result.n;
+    }
+
+    if (options.json)
+        writeJSON(results, options.profile, std::cout);
+    else {
+        writeText(results, std::cout);
+
+        if (options.profile) {
+            std::cout << std::endl;
+
+            if (Profiler::isCompiledIn())
+                Profiler::instance().report(std::cout);
+            else
+                std::cout << "profiling was compiled out, build with FV2D_ENABLE_PROFILING defined" << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "AttributeRegistry.h"
+
+#include <algorithm>
+
+
+AttributeRegistry::AttributeRegistry() {
+    std::fill(sizes_, sizes_ + END, std::size_t(0));
+}
+
+void
+AttributeRegistry::resize(Location location, std::size_t n) {
+    if (location >= END)
+        throw std::out_of_range("AttributeRegistry::resize(): Unknown location");
+
+    sizes_[location] = n;
+
+    resize(doubles_[location], n);
+    resize(ints_[location], n);
+    resize(vectors_[location], n);
+    resize(vertices_[location], n);
+}
+
+std::size_t
+AttributeRegistry::size(Location location) const {
+    if (location >= END)
+        throw std::out_of_range("AttributeRegistry::size(): Unknown location");
+
+    return sizes_[location];
+}
+
+bool
+AttributeRegistry::contains(Location location, std::string const & name) const {
+    if (location >= END)
+        return false;
+
+    return contains(doubles_[location], name) || contains(ints_[location], name) ||
+           contains(vectors_[location], name) || contains(vertices_[location], name);
+}
+
+template <typename T>
+void
+AttributeRegistry::resize(Storage<T> & data, std::size_t n) {
+    for (std::size_t slot = 0; slot < data.arrays.size(); ++slot)
+        data.arrays[slot].resize(n, data.initial[slot]);
+}
+
+template <typename T>
+bool
+AttributeRegistry::contains(Storage<T> const & data, std::string const & name) {
+    return std::find(data.names.begin(), data.names.end(), name) != data.names.end();
+}
@@ -0,0 +1,204 @@
+/*
+ * Name  : AttributeRegistry
+ * Path  :
+ * Use   : Typed user-defined values per face or per cell, e.g. mesh
+ *         quality measures or gradients computed during the flux
+ *         evaluation.
+ *         An attribute is declared once by name and type (double, int,
+ *         Vector or Vertex) and stored in one contiguous array with an
+ *         entry per face or cell, indexed by ComputationalFace::index()
+ *         and ComputationalCell::index(). Access is through the typed
+ *         handle returned by declare(), i.e. without a lookup by name
+ *         and without boost::any (see ComputationalFace::addUserDefValue).
+ *         Attributes are usually declared on the ComputationalMeshBuilder,
+ *         which sizes the arrays when the mesh is built.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include "ComputationalFace.h"
+#include "ComputationalCell.h"
+
+#include "FiniteVolume2DLib/Vector.h"
+#include "FiniteVolume2DLib/Vertex.h"
+#include "FiniteVolume2DLib/Util.h"
+
+#include <boost/optional.hpp>
+#include <boost/format.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cassert>
+#include <stdexcept>
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2D AttributeRegistry {
+public:
+    typedef std::shared_ptr<AttributeRegistry> Ptr;
+
+    enum Location {FACE, CELL, END};
+
+    template <typename T>
+    class Handle {
+    public:
+        Handle() : location_(END), slot_(0) {}
+
+        bool     valid() const { return location_ != END; }
+        Location location() const { return location_; }
+
+    private:
+        friend class AttributeRegistry;
+
+        Handle(Location location, std::size_t slot) : location_(location), slot_(slot) {}
+
+    private:
+        Location    location_;
+        std::size_t slot_;
+    };
+
+public:
+    AttributeRegistry();
+
+    // number of faces or cells, all arrays of the location are resized
+    void             resize(Location location, std::size_t n);
+    std::size_t      size(Location location) const;
+
+    bool             contains(Location location, std::string const & name) const;
+
+    /* New array of size(location) values initial. Throws std::logic_error
+     * if an attribute of that name already exists at the location and
+     * std::out_of_range for an unknown location.
+     * There is no default for Vector, i.e. initial must be given.
+     */
+    template <typename T>
+    Handle<T>
+    declare(Location location, std::string const & name, T const & initial = T()) {
+        if (location >= END)
+            throw std::out_of_range("AttributeRegistry::declare(): Unknown location");
+
+        if (contains(location, name)) {
+            boost::format format = boost::format("AttributeRegistry::declare: Attribute %1% already declared!\n") % name;
+            Util::error(format.str());
+            throw std::logic_error(format.str().c_str());
+        }
+
+        Storage<T> & data = storage(location, Tag<T>());
+
+        data.names.push_back(name);
+        data.initial.push_back(initial);
+        data.arrays.push_back(std::vector<T>(sizes_[location], initial));
+
+        return Handle<T>(location, data.arrays.size() - 1);
+    }
+
+    template <typename T>
+    boost::optional<Handle<T>>
+    find(Location location, std::string const & name) const {
+        if (location >= END)
+            return boost::optional<Handle<T>>();
+
+        Storage<T> const & data = storage(location, Tag<T>());
+
+        for (std::size_t slot = 0; slot < data.names.size(); ++slot)
+            if (data.names[slot] == name)
+                return Handle<T>(location, slot);
+
+        return boost::optional<Handle<T>>();
+    }
+
+    /* The whole array, for loops over all faces or cells. Throws
+     * std::out_of_range for a default constructed handle.
+     */
+    template <typename T>
+    std::vector<T> &
+    array(Handle<T> const & handle) {
+        check(handle);
+        return storage(handle.location_, Tag<T>()).arrays.at(handle.slot_);
+    }
+
+    template <typename T>
+    std::vector<T> const &
+    array(Handle<T> const & handle) const {
+        check(handle);
+        return storage(handle.location_, Tag<T>()).arrays.at(handle.slot_);
+    }
+
+    template <typename T>
+    T &
+    operator()(Handle<T> const & handle, ComputationalFace const & cface) {
+        assert(handle.location_ == FACE);
+        return storage(FACE, Tag<T>()).arrays[handle.slot_][cface.index()];
+    }
+
+    template <typename T>
+    T &
+    operator()(Handle<T> const & handle, ComputationalCell const & ccell) {
+        assert(handle.location_ == CELL);
+        return storage(CELL, Tag<T>()).arrays[handle.slot_][ccell.index()];
+    }
+
+    template <typename T>
+    T const &
+    operator()(Handle<T> const & handle, ComputationalFace const & cface) const {
+        assert(handle.location_ == FACE);
+        return storage(FACE, Tag<T>()).arrays[handle.slot_][cface.index()];
+    }
+
+    template <typename T>
+    T const &
+    operator()(Handle<T> const & handle, ComputationalCell const & ccell) const {
+        assert(handle.location_ == CELL);
+        return storage(CELL, Tag<T>()).arrays[handle.slot_][ccell.index()];
+    }
+
+private:
+    template <typename T>
+    struct Storage {
+        std::vector<std::string>    names;
+        std::vector<T>              initial;
+        std::vector<std::vector<T>> arrays;
+    };
+
+    // select the storage by type
+    template <typename T>
+    struct Tag {};
+
+    Storage<double> &       storage(Location location, Tag<double>)       { return doubles_[location]; }
+    Storage<int> &          storage(Location location, Tag<int>)          { return ints_[location]; }
+    Storage<Vector> &       storage(Location location, Tag<Vector>)       { return vectors_[location]; }
+    Storage<Vertex> &       storage(Location location, Tag<Vertex>)       { return vertices_[location]; }
+    Storage<double> const & storage(Location location, Tag<double>) const { return doubles_[location]; }
+    Storage<int> const &    storage(Location location, Tag<int>) const    { return ints_[location]; }
+    Storage<Vector> const & storage(Location location, Tag<Vector>) const { return vectors_[location]; }
+    Storage<Vertex> const & storage(Location location, Tag<Vertex>) const { return vertices_[location]; }
+
+    template <typename T>
+    static void             check(Handle<T> const & handle) {
+        if (!handle.valid())
+            throw std::out_of_range("AttributeRegistry::array(): Invalid handle");
+    }
+
+    template <typename T>
+    static void             resize(Storage<T> & data, std::size_t n);
+
+    template <typename T>
+    static bool             contains(Storage<T> const & data, std::string const & name);
+
+private:
+    std::size_t     sizes_[END];
+
+    Storage<double> doubles_[END];
+    Storage<int>    ints_[END];
+    Storage<Vector> vectors_[END];
+    Storage<Vertex> vertices_[END];
+};
+
+#pragma warning(default:4251)
@@ -0,0 +1,114 @@
+#include "CellSourceTerms.h"
+
+#include "ComputationalMesh.h"
+#include "ComputationalMeshSolverHelper.h"
+#include "ComputationalVariableManager.h"
+
+#include "FiniteVolume2DLib/Mesh.h"
+#include "FiniteVolume2DLib/MeshGeometry.h"
+#include "FiniteVolume2DLib/ParallelFor.hpp"
+#include "FiniteVolume2DLib/Profiler.h"
+#include "FiniteVolume2DLib/Util.h"
+
+#include <boost/format.hpp>
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+
+CellSourceTerms::CellSourceTerms(ComputationalMesh const & cmesh, Mesh const & mesh, unsigned int nthreads)
+    :
+    cmesh_(cmesh),
+    nthreads_(ParallelFor::numberOfThreads(nthreads)) {
+
+    MeshGeometry geometry(mesh);
+
+    if (geometry.getNumberOfCells() != cmesh_.getCellThread().size()) {
+        boost::format format = boost::format("CellSourceTerms: Mesh does not match the computational mesh!\n");
+        Util::error(format.str());
+        throw std::logic_error(format.str().c_str());
+    }
+
+    volume_ = geometry.cellVolume();
+    std::for_each(volume_.begin(), volume_.end(), [](double & v) { v = std::fabs(v); });
+}
+
+void
+CellSourceTerms::set(std::string const & var_name, Array_t const & su, Array_t const & sp) {
+    short base_index = cmesh_.getComputationalVariableManager().getBaseIndex(var_name);
+
+    if (base_index < 0) {
+        boost::format format = boost::format("CellSourceTerms: Unknown computational variable %1%!\n") % var_name;
+        Util::error(format.str());
+        throw std::logic_error(format.str().c_str());
+    }
+
+    if (su.size() != volume_.size() || (!sp.empty() && sp.size() != volume_.size()))
+        throw std::out_of_range("CellSourceTerms::set(): Wrong number of cells");
+
+    Source & source = sources_[var_name];
+    source.base_index = base_index;
+    source.su = su;
+    source.sp = sp;
+}
+
+void
+CellSourceTerms::remove(std::string const & var_name) {
+    sources_.erase(var_name);
+}
+
+bool
+CellSourceTerms::contains(std::string const & var_name) const {
+    return sources_.find(var_name) != sources_.end();
+}
+
+std::size_t
+CellSourceTerms::getNumberOfCells() const {
+    return volume_.size();
+}
+
+CellSourceTerms::Array_t const &
+CellSourceTerms::getCellVolumes() const {
+    return volume_;
+}
+
+void
+CellSourceTerms::assemble(ComputationalMeshSolverHelper & helper) const {
+    FV2D_PROFILE_SCOPE("CellSourceTerms::assemble");
+
+    if (sources_.empty())
+        return;
+
+    CSparseMatrixImpl & A   = helper.modifySparseMatrix();
+    LinearSolver::RHS_t & b = helper.modifyRHS();
+
+    Array_t diagonal;
+    A.getDiagonal(diagonal);
+
+    std::size_t nvars = cmesh_.getComputationalVariableManager().size();
+    std::size_t ncells = volume_.size();
+
+    double const * volume = volume_.data();
+
+    // rows cell * nvars + base_index, i.e. a chunk of cells writes its own rows
+    std::for_each(sources_.begin(), sources_.end(), [&](Sources_t::value_type const & entry) {
+        Source const & source = entry.second;
+
+        double * rhs  = b.data() + source.base_index;
+        double * diag = diagonal.data() + source.base_index;
+        double const * su = source.su.data();
+        double const * sp = source.sp.empty() ? nullptr : source.sp.data();
+
+        ParallelFor::forEachChunk(ncells, nthreads_, [=](std::size_t begin, std::size_t end) {
+            for (std::size_t cell = begin; cell < end; ++cell)
+                rhs[cell * nvars] += su[cell] * volume[cell];
+
+            if (sp)
+                for (std::size_t cell = begin; cell < end; ++cell)
+                    diag[cell * nvars] -= sp[cell] * volume[cell];
+        });
+    });
+
+    A.setDiagonal(diagonal);
+}
@@ -0,0 +1,83 @@
+/*
+ * Name  : CellSourceTerms
+ * Path  :
+ * Use   : Volumetric sources of the variables of a computational mesh,
+ *         linearised as S = S_u + S_p \phi per unit volume (Patankar;
+ *         S_p <= 0 keeps the matrix diagonally dominant), given as one
+ *         array per variable over all cells instead of per cell in a
+ *         cell evaluator (see SourceTerm). assemble() adds S_u V to the
+ *         r.h.s. and -S_p V to the diagonal of the assembled system in
+ *         one pass over the cell volumes, split between several threads.
+ *         Cells are in the order of MeshGeometry, V is the unsigned
+ *         cell volume.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+
+class Mesh;
+class ComputationalMesh;
+class ComputationalMeshSolverHelper;
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2D CellSourceTerms {
+public:
+    typedef std::vector<double> Array_t;
+
+public:
+    /* mesh: the geometric mesh cmesh was built from.
+     * nthreads = 0: one thread per core.
+     * Throws std::logic_error if the meshes do not match.
+     */
+    CellSourceTerms(ComputationalMesh const & cmesh, Mesh const & mesh, unsigned int nthreads = 0);
+
+    /* Per cell and unit volume; sp empty: no linearised part. Replaces
+     * the source of the variable. Throws std::logic_error if the
+     * variable is unknown and std::out_of_range if a size does not match.
+     */
+    void            set(std::string const & var_name, Array_t const & su, Array_t const & sp = Array_t());
+    void            remove(std::string const & var_name);
+
+    bool            contains(std::string const & var_name) const;
+    std::size_t     getNumberOfCells() const;
+
+    // unsigned, per cell
+    Array_t const & getCellVolumes() const;
+
+    // adds the sources to the system assembled by helper (after setupMatrix())
+    void            assemble(ComputationalMeshSolverHelper & helper) const;
+
+private:
+    CellSourceTerms(CellSourceTerms const & in);
+    CellSourceTerms & operator=(CellSourceTerms const & in);
+
+private:
+    struct Source {
+        short   base_index;
+        Array_t su;
+        Array_t sp;
+    };
+
+    typedef std::map<std::string, Source> Sources_t;
+
+private:
+    ComputationalMesh const & cmesh_;
+    unsigned int              nthreads_;
+
+    Array_t                   volume_;
+
+    Sources_t                 sources_;
+};
+
+#pragma warning(default:4251)
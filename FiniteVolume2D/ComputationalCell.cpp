@@ -10,7 +10,7 @@
 
 ComputationalCell::ComputationalCell(Cell::Ptr const & geometric_cell, EntityCollection<ComputationalFace> const & faces)
     :
-    geometric_cell_(geometric_cell), faces_(faces) {
+    geometric_cell_(geometric_cell), faces_(faces), index_(0) {
 
     // extract nodes
     std::for_each(faces.begin(), faces.end(), [this](ComputationalFace::Ptr const & cface) {
@@ -66,6 +66,11 @@ ComputationalCell::geometricEntity() const {
     return geometric_cell_;
 }
 
+std::size_t
+ComputationalCell::index() const {
+    return index_;
+}
+
 EntityCollection<ComputationalNode> const &
 ComputationalCell::getComputationalNodes() const {
     return nodes_;
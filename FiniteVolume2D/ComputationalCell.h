@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <map>
+#include <cstddef>
 
 
 #pragma warning(disable:4251)
@@ -27,6 +28,9 @@
 
 
 class DECL_SYMBOLS_2D ComputationalCell : public ICell {
+
+    friend class ComputationalMesh;
+
 public:
     typedef std::shared_ptr<ComputationalCell>       Ptr;
 
@@ -47,6 +51,9 @@ public:
 
     Cell::Ptr const &              geometricEntity() const;
 
+    // linear index in the mesh, see ComputationalMesh::getCellIndex()
+    std::size_t                    index() const;
+
 
     EntityCollection<ComputationalNode> const & getComputationalNodes() const;
     EntityCollection<ComputationalFace> const & getComputationalFaces() const;
@@ -75,6 +82,9 @@ private:
      * for both active and passive variables.
      */
     ComputationalMolecules_t            cm_;
+
+    // set by the ComputationalMesh
+    std::size_t                         index_;
 };
 
 #pragma warning(default:4275)
@@ -12,7 +12,7 @@
 
 ComputationalFace::ComputationalFace(Face::Ptr const & geometric_face, EntityCollection<ComputationalNode> const & cnodes)
     :
-    geometric_face_(geometric_face), cnodes_(cnodes) , bc_(nullptr) {
+    geometric_face_(geometric_face), cnodes_(cnodes) , bc_(nullptr), index_(0) {
     assert(cnodes_.size() == 2);
 }
 
@@ -72,6 +72,11 @@ ComputationalFace::geometricEntity() const {
     return geometric_face_;
 }
 
+std::size_t
+ComputationalFace::index() const {
+    return index_;
+}
+
 BoundaryCondition::Ptr const &
 ComputationalFace::getBoundaryCondition() const {
     return bc_;
@@ -21,6 +21,7 @@
 #include <memory>
 #include <map>
 #include <string>
+#include <cstddef>
 
 
 class FluxComputationalMolecule;
@@ -31,6 +32,9 @@ class FluxComputationalMolecule;
 
 
 class DECL_SYMBOLS_2D ComputationalFace : public IFace {
+
+    friend class ComputationalMesh;
+
 public:
     typedef std::shared_ptr<ComputationalFace>       Ptr;
     typedef std::shared_ptr<ComputationalFace const> CPtr;
@@ -58,6 +62,11 @@ public:
 
     Face::Ptr const &              geometricEntity() const;
 
+    /* Linear index in the mesh: the interior faces, then the boundary
+     * faces, as in MeshGeometry. See AttributeRegistry.
+     */
+    std::size_t                    index() const;
+
     BoundaryCondition::Ptr const & getBoundaryCondition() const;
     void                           setBoundaryCondition(BoundaryCondition::Ptr const & bc);
 
@@ -92,6 +101,9 @@ private:
 
     // boundary conditions, in case this is a boundary face
     BoundaryCondition::Ptr             bc_;
+
+    // set by the ComputationalMesh
+    std::size_t                        index_;
 };
 
 #pragma warning(default:4275)
@@ -2,10 +2,14 @@
 
 #include "ComputationalVariableManager.h"
 #include "ComputationalMeshSolverHelper.h"
+#include "IComputationalGridAccessor.h"
 
 #include "FiniteVolume2DLib/Util.h"
+#include "FiniteVolume2DLib/Profiler.h"
 
 #include <cassert>
+#include <algorithm>
+#include <stdexcept>
 
 #include <boost/format.hpp>
 
@@ -22,7 +26,8 @@ template class Thread<Cell>;
 ComputationalMesh::ComputationalMesh(IMeshConnectivity const & mesh_connectivity, ComputationalVariableManager::Ptr const & cvar_mgr)
     :
     mesh_connectivity_(mesh_connectivity),
-    cvar_mgr_(cvar_mgr) {}
+    cvar_mgr_(cvar_mgr),
+    attributes_(std::make_shared<AttributeRegistry>()) {}
 
 IMeshConnectivity const &
 ComputationalMesh::getMeshConnectivity() const {
@@ -34,6 +39,12 @@ ComputationalMesh::getComputationalVariableManager() const {
     return *cvar_mgr_;
 }
 
+AttributeRegistry &
+ComputationalMesh::getAttributes() const {
+    // the attribute values are not part of the logical state of the mesh
+    return *attributes_;
+}
+
 Thread<ComputationalNode> const &
 ComputationalMesh::getNodeThread(IGeometricEntity::Entity_t entity_type) const {
     if (entity_type == IGeometricEntity::BOUNDARY)
@@ -132,6 +143,83 @@ ComputationalMesh::solve() const {
     helper.solve();
 }
 
+std::vector<size_t>
+ComputationalMesh::reevaluate(std::vector<ComputationalFace::Ptr> const & cfaces, std::vector<ComputationalCell::Ptr> const & ccells) const {
+    FV2D_PROFILE_SCOPE("ComputationalMesh::reevaluate");
+
+    if (!cell_molecule_evaluator_) {
+        boost::format format = boost::format("ComputationalMesh::reevaluate: No comp. cell evaluator set!\n");
+        Util::error(format.str());
+        throw std::logic_error(format.str().c_str());
+    }
+
+    // affected cells
+    std::vector<size_t> cell_indices;
+
+    std::for_each(cfaces.begin(), cfaces.end(), [&](ComputationalFace::Ptr const & cface) {
+        boost::optional<EntityCollection<Cell>> cells = mesh_connectivity_.getCellsAttachedToFace(cface->geometricEntity());
+        if (!cells)
+            return;
+
+        std::for_each(cells->begin(), cells->end(), [&](Cell::Ptr const & cell) {
+            cell_indices.push_back(getCellIndex(mapper_.getComputationalCell(cell)));
+        });
+    });
+
+    std::for_each(ccells.begin(), ccells.end(), [&](ComputationalCell::Ptr const & ccell) {
+        cell_indices.push_back(getCellIndex(ccell));
+    });
+
+    std::sort(cell_indices.begin(), cell_indices.end());
+    cell_indices.erase(std::unique(cell_indices.begin(), cell_indices.end()), cell_indices.end());
+
+
+    // start from empty face and cell molecules, the solution values are kept
+    for (std::vector<size_t>::size_type i = 0; i < cell_indices.size(); ++i) {
+        ComputationalCell::Ptr const & ccell = cell_thread_.getEntityAt(cell_indices[i]);
+
+        EntityCollection<ComputationalFace> const & cell_faces = ccell->getComputationalFaces();
+
+        ComputationalVariableManager::Iterator_t it     = cvar_mgr_->begin();
+        ComputationalVariableManager::Iterator_t it_end = cvar_mgr_->end();
+
+        for (; it != it_end; ++it) {
+            ccell->getComputationalMolecule(it->name).clear();
+
+            std::for_each(cell_faces.begin(), cell_faces.end(), [&it](ComputationalFace::Ptr const & cface) {
+                cface->getComputationalMolecule(it->name).clear();
+            });
+        }
+    }
+
+    /* As in ComputationalMeshBuilder::build, visit the cells in
+     * increasing order for both the face fluxes and the cell molecules.
+     * A face flux is thus evaluated with the first cell adding it to
+     * its molecule, which the cell evaluators rely on.
+     */
+    IComputationalGridAccessor grid_accessor(mesh_connectivity_, mapper_);
+
+    for (std::vector<size_t>::size_type i = 0; i < cell_indices.size(); ++i) {
+        ComputationalCell::Ptr const & ccell = cell_thread_.getEntityAt(cell_indices[i]);
+
+        EntityCollection<ComputationalFace> const & cell_faces = ccell->getComputationalFaces();
+        std::for_each(cell_faces.begin(), cell_faces.end(), [&](ComputationalFace::Ptr const & cface) {
+            ComputationalVariableManager::Iterator_t it     = cvar_mgr_->begin();
+            ComputationalVariableManager::Iterator_t it_end = cvar_mgr_->end();
+
+            for (; it != it_end; ++it)
+                (it->flux_eval)(grid_accessor, ccell, cface);
+        });
+    }
+
+    for (std::vector<size_t>::size_type i = 0; i < cell_indices.size(); ++i)
+        cell_molecule_evaluator_(cell_thread_.getEntityAt(cell_indices[i]));
+
+    FV2D_PROFILE_COUNT("reevaluate/cells", cell_indices.size());
+
+    return cell_indices;
+}
+
 void
 ComputationalMesh::addNode(Node::Ptr const & node, ComputationalNode::Ptr const & cnode) {
     Thread<ComputationalNode> & thread = getNodeThread(cnode->getEntityType());
@@ -143,6 +231,9 @@ ComputationalMesh::addNode(Node::Ptr const & node, ComputationalNode::Ptr const
 void
 ComputationalMesh::addFace(Face::Ptr const & face, ComputationalFace::Ptr const & cface) {
     Thread<ComputationalFace> & thread = getFaceThread(face->getEntityType());
+
+    // the builder adds all interior faces first
+    cface->index_ = interior_face_thread_.size() + boundary_face_thread_.size();
     thread.insert(cface);
 
     mapper_.addFace(face, cface);
@@ -158,6 +249,7 @@ ComputationalMesh::addCell(Cell::Ptr const & cell, ComputationalCell::Ptr const
      * ComputationalMeshSolverHelper.
      */
     ccell_index_map_[ccell->id()] = cell_index;
+    ccell->index_ = cell_index;
 
     mapper_.addCell(cell, ccell);
 }
@@ -18,8 +18,11 @@
 #include "ComputationalCell.h"
 #include "ComputationalFace.h"
 #include "ComputationalNode.h"
+#include "AttributeRegistry.h"
 
 #include <memory>
+#include <vector>
+#include <functional>
 #include <unordered_map>
 
 #include <boost/cstdint.hpp>
@@ -41,6 +44,9 @@ public:
     typedef std::shared_ptr<ComputationalMesh>       Ptr;
     typedef std::shared_ptr<ComputationalMesh const> CPtr;
 
+    // see ComputationalMeshBuilder::addEvaluateCellMolecules
+    typedef std::function<bool (std::shared_ptr<ComputationalCell> const & cell)> CellMoleculeEvaluator_t;
+
 public:
     explicit ComputationalMesh(IMeshConnectivity const & mesh_connectivity, std::shared_ptr<ComputationalVariableManager> const & cvar_mgr);
 
@@ -58,12 +64,26 @@ public:
 
     GeometricalEntityMapper const &   getMapper() const;
 
+    // the face and cell attributes declared on the ComputationalMeshBuilder
+    AttributeRegistry &               getAttributes() const;
+
     size_t                            getCellIndex(ComputationalCell::Ptr const & ccell) const;
 
     bool                              setSolution(boost::uint64_t cell_index, boost::uint64_t cvar_index, double value) const;
 
     void                              solve() const;
 
+    /* Re-evaluate the molecules affected by a change of the given faces
+     * (e.g. a new BoundaryCondition) or cells (e.g. a new source term)
+     * instead of rebuilding the mesh. The cells attached to the faces
+     * and the given cells are re-evaluated together with all of their
+     * faces. The flux through the other faces must not have changed.
+     * Returns the sorted indices of the re-evaluated cells, i.e. the
+     * rows to update, see ComputationalMeshSolverHelper::updateRows().
+     */
+    std::vector<size_t>               reevaluate(std::vector<ComputationalFace::Ptr> const & cfaces,
+                                                 std::vector<ComputationalCell::Ptr> const & ccells = std::vector<ComputationalCell::Ptr>()) const;
+
 private:
     // make the non-const access routines private
     Thread<ComputationalNode> & getNodeThread(IGeometricEntity::Entity_t entity_type);
@@ -98,6 +118,12 @@ private:
 
     /* for mapping ComputationalCells into linear indices */
     std::unordered_map<IGeometricEntity::Id_t, size_t> ccell_index_map_;
+
+    // set by the ComputationalMeshBuilder, needed by reevaluate()
+    CellMoleculeEvaluator_t   cell_molecule_evaluator_;
+
+    // shared with the ComputationalMeshBuilder
+    AttributeRegistry::Ptr    attributes_;
 };
 
 #pragma warning(default:4275)
@@ -7,6 +7,7 @@
 #include "FiniteVolume2DLib/Util.h"
 #include "FiniteVolume2DLib/Thread.hpp"
 #include "FiniteVolume2DLib/Node.h"
+#include "FiniteVolume2DLib/Profiler.h"
 
 #include <boost/format.hpp>
 
@@ -15,7 +16,8 @@ ComputationalMeshBuilder::ComputationalMeshBuilder(Mesh::Ptr const & geometrical
     :
     geometrical_mesh_(geometrical_mesh),
     bc_(bc),
-    cvar_mgr_(std::make_shared<ComputationalVariableManager>()) {}
+    cvar_mgr_(std::make_shared<ComputationalVariableManager>()),
+    attributes_(std::make_shared<AttributeRegistry>()) {}
 
 bool
 ComputationalMeshBuilder::addComputationalVariable(std::string const & var_name, FluxEvaluator_t const & flux_evaluator) {
@@ -113,8 +115,15 @@ ComputationalMeshBuilder::addPassiveComputationalCellVariable(std::string const
     return add(cvar_mgr_, cell_vars_, var_name);
 }
 
+AttributeRegistry &
+ComputationalMeshBuilder::getAttributes() const {
+    return *attributes_;
+}
+
 ComputationalMesh::Ptr
 ComputationalMeshBuilder::build() const {
+    FV2D_PROFILE_SCOPE("ComputationalMeshBuilder::build");
+
     if (cvar_mgr_->size() == 0) {
         boost::format format = boost::format("ComputationalMeshBuilder::build: No computational variables defined!\n");
         Util::error(format.str());
@@ -133,18 +142,27 @@ ComputationalMeshBuilder::build() const {
      * Also, insert computational variables and boundary conditions.
      */
     insertComputationalEntities(cmesh);
-    
+
+    // one attribute value per face / cell
+    attributes_->resize(AttributeRegistry::FACE, cmesh->getFaceThread(IGeometricEntity::INTERIOR).size() + cmesh->getFaceThread(IGeometricEntity::BOUNDARY).size());
+    attributes_->resize(AttributeRegistry::CELL, cmesh->getCellThread().size());
+    cmesh->attributes_ = attributes_;
+
     // compute the face fluxes
     computeFaceFluxes(cmesh);
 
     // add face fluxes to the cell molecule
     evaluateCellMolecules(cmesh);
 
+    cmesh->cell_molecule_evaluator_ = cell_molecule_evaluator_;
+
     return cmesh;
 }
 
 void
 ComputationalMeshBuilder::insertComputationalEntities(ComputationalMesh::Ptr & cmesh) const {
+    FV2D_PROFILE_SCOPE("ComputationalMeshBuilder::build/insertComputationalEntities");
+
     GeometricalEntityMapper const & mapper = cmesh->getMapper();
 
     /*
@@ -260,6 +278,10 @@ ComputationalMeshBuilder::insertComputationalEntities(ComputationalMesh::Ptr & c
 
         cmesh->addCell(cell_thread.getEntityAt(i), ccell);
     }
+
+    FV2D_PROFILE_COUNT("alloc/ComputationalNode", interior_node_thread.size() + boundary_node_thread.size());
+    FV2D_PROFILE_COUNT("alloc/ComputationalFace", interior_face_thread.size() + boundary_face_thread.size());
+    FV2D_PROFILE_COUNT("alloc/ComputationalCell", cell_thread.size());
 }
 
 void
@@ -348,6 +370,8 @@ ComputationalMeshBuilder::computeFaceFluxes(ComputationalMesh::Ptr & cmesh) cons
     /* For all cells, fill in the ComputationalMolecules for the
      * ComputationalVariables.
      */
+    FV2D_PROFILE_SCOPE("ComputationalMeshBuilder::build/computeFaceFluxes");
+
     IComputationalGridAccessor grid_accessor(cmesh->getMeshConnectivity(), cmesh->getMapper());
 
     Thread<ComputationalCell> const & cell_thread = cmesh->getCellThread();
@@ -378,6 +402,8 @@ ComputationalMeshBuilder::evaluateCellMolecules(ComputationalMesh::Ptr & cmesh)
      * (see for example p. 331, eq. 11.59, in Versteeg and
      * Malalasekera, where the r.h.s. is zero.
      */
+    FV2D_PROFILE_SCOPE("ComputationalMeshBuilder::build/evaluateCellMolecules");
+
     Thread<ComputationalCell> const & cell_thread = cmesh->getCellThread();
     for (Thread<ComputationalCell>::size_type i = 0; i < cell_thread.size(); ++i) {
         ComputationalCell::Ptr const & ccell = cell_thread.getEntityAt(i);
@@ -20,6 +20,7 @@
 #include "FiniteVolume2DLib/BoundaryConditionCollection.h"
 
 #include "ComputationalMesh.h"
+#include "AttributeRegistry.h"
 
 #include <functional>
 #include <set>
@@ -32,7 +33,7 @@ class DECL_SYMBOLS_2D ComputationalMeshBuilder {
 public:
     typedef ComputationalVariableManager::FluxEvaluator_t FluxEvaluator_t;
 
-    typedef std::function<bool (std::shared_ptr<ComputationalCell> const & cell)> CellMoleculeEvaluator_t;
+    typedef ComputationalMesh::CellMoleculeEvaluator_t    CellMoleculeEvaluator_t;
 
 public:
     explicit ComputationalMeshBuilder(Mesh::Ptr const & mesh, BoundaryConditionCollection const & bc);
@@ -42,6 +43,25 @@ public:
     bool                   addPassiveComputationalNodeVariable(std::string const & var_name);
     bool                   addPassiveComputationalFaceVariable(std::string const & var_name);
     bool                   addPassiveComputationalCellVariable(std::string const & var_name);
+
+    /* Typed attributes per face / cell, see AttributeRegistry. The arrays
+     * are sized by build(), i.e. they can already be written by the flux
+     * evaluators through the returned handle and getAttributes().
+     */
+    template <typename T>
+    AttributeRegistry::Handle<T>
+    addFaceAttribute(std::string const & name, T const & initial = T()) {
+        return attributes_->declare<T>(AttributeRegistry::FACE, name, initial);
+    }
+
+    template <typename T>
+    AttributeRegistry::Handle<T>
+    addCellAttribute(std::string const & name, T const & initial = T()) {
+        return attributes_->declare<T>(AttributeRegistry::CELL, name, initial);
+    }
+
+    AttributeRegistry &    getAttributes() const;
+
     ComputationalMesh::Ptr build() const;
 
 private:
@@ -77,6 +97,9 @@ private:
     PassiveCellVars_t                             cell_vars_;
 
     CellMoleculeEvaluator_t                       cell_molecule_evaluator_;
+
+    // shared with the ComputationalMesh built
+    AttributeRegistry::Ptr                        attributes_;
 };
 
 #pragma warning(default:4251)
@@ -3,20 +3,34 @@
 #include "FiniteVolume2D/ComputationalCell.h"
 #include "FiniteVolume2D/IComputationalMesh.h"
 #include "FiniteVolume2D/ComputationalVariableManager.h"
+#include "FiniteVolume2D/BoundaryCondition.h"
+
+#include "FiniteVolume2DLib/BoundaryConditionCollection.h"
 
 #include "FiniteVolume2DLib/Thread.hpp"
+#include "FiniteVolume2DLib/Profiler.h"
+#include "FiniteVolume2DLib/Util.h"
 
 #include "Solver/CSparseMatrixImpl.h"
 
 #include <string>
 #include <tuple>
+#include <cmath>
 #include <map>
 #include <algorithm>
+#include <stdexcept>
+
+#include <boost/format.hpp>
+
 
+double const ComputationalMeshSolverHelper::DIRECT_TOLERANCE = 1E-8;
 
 ComputationalMeshSolverHelper::ComputationalMeshSolverHelper(IComputationalMesh const & cmesh)
     :
-    cmesh_(cmesh) {}
+    cmesh_(cmesh),
+    warm_start_(true),
+    method_(SOR),
+    lu_valid_(false) {}
 
 
 void
@@ -28,7 +42,10 @@ ComputationalMeshSolverHelper::insertSolutionIntoCMesh(LinearSolver::RHS_t const
         * Row 3: Cell 3, Temperature
         * Row 4: Cell 3, Pressure
         * ...
+        * 
+        * i.e. row = cell_index * nvars + base_index.
         */
+    FV2D_PROFILE_SCOPE("ComputationalMeshSolverHelper::insertSolutionIntoCMesh");
 
     // find number of ComputationalVariables to solve for per cell
     ComputationalVariableManager const & cvar_manager = cmesh_.getComputationalVariableManager();
@@ -54,23 +71,199 @@ ComputationalMeshSolverHelper::insertSolutionIntoCMesh(LinearSolver::RHS_t const
 
 bool
 ComputationalMeshSolverHelper::solve() {
+    FV2D_PROFILE_SCOPE("ComputationalMeshSolverHelper::solve");
+
     /* Setup the matrix by inserting the computational
      * molecules for each computational cell.
      */
     setupMatrix();
 
-    // allocate right hand side
+    return solveSystem();
+}
+
+bool
+ComputationalMeshSolverHelper::solveSystem() {
+    if (!m_)
+        throw std::logic_error("ComputationalMeshSolverHelper::solveSystem(): Matrix not yet set up");
+
+    return solveSystem(*m_, rhs_);
+}
+
+bool
+ComputationalMeshSolverHelper::solveSystem(CSparseMatrixImpl const & A, LinearSolver::RHS_t const & b) {
+    /* Start from the solution currently stored in the mesh,
+     * e.g. the one of the previous time step or nonlinear iteration.
+     */
+    LinearSolver::RHS_t x0(b.size(), 0.0);
+    if (warm_start_)
+        gatherSolutionFromCMesh(x0);
+
     LinearSolver::RHS_t x;
-    x.resize(rhs_.size());
+    bool success;
+
+    if (method_ == SPARSE_LU) {
+        success = solveDirect(A, b, x);
+    }
+    else {
+        // solve using SOR approach
+        FV2D_PROFILE_SCOPE("ComputationalMeshSolverHelper::solveSystem/sparseSOR");
+        std::tie(success, x) = LinearSolver::sparseSOR(A, b, x0, 1.05, control_, stats_);
+    }
 
-    // solve using SOR approach
-    std::tie(std::ignore, x) = LinearSolver::sparseSOR(*m_, rhs_, 1.05);
+    FV2D_PROFILE_SAMPLE("solver/iterations", stats_.iterations);
+    FV2D_PROFILE_SAMPLE("solver/update norm", stats_.update_norm);
+    FV2D_PROFILE_SAMPLE("solver/residual", stats_.residual_norm);
 
     // insert the solution, x, into the ComputationalMolecule
     // of the corresponding ComputationalCell
     insertSolutionIntoCMesh(x);
 
-    return true;
+    return success;
+}
+
+bool
+ComputationalMeshSolverHelper::solveSystems(LinearSolver::RHSBlock_t const & b, LinearSolver::RHSBlock_t & x) {
+    if (!m_)
+        throw std::logic_error("ComputationalMeshSolverHelper::solveSystems(): Matrix not yet set up");
+
+    LinearSolver::RHS_t x0(rhs_.size(), 0.0);
+    if (warm_start_)
+        gatherSolutionFromCMesh(x0);
+
+    bool success = true;
+
+    if (method_ == SPARSE_LU) {
+        // one factorization for all
+        x.resize(b.size());
+        block_stats_.resize(b.size());
+
+        for (LinearSolver::RHSBlock_t::size_type k = 0; k < b.size(); ++k) {
+            success = solveDirect(*m_, b[k], x[k]) && success;
+            block_stats_[k] = stats_;
+        }
+    }
+    else {
+        FV2D_PROFILE_SCOPE("ComputationalMeshSolverHelper::solveSystems/sparseSOR");
+        std::tie(success, x) = LinearSolver::sparseSOR(*m_, b, LinearSolver::RHSBlock_t(b.size(), x0), 1.05, control_, block_stats_);
+    }
+
+    FV2D_PROFILE_COUNT("solver/r.h.s.", b.size());
+
+    return success;
+}
+
+bool
+ComputationalMeshSolverHelper::solveDirect(CSparseMatrixImpl const & A, LinearSolver::RHS_t const & b, LinearSolver::RHS_t & x) {
+    bool assembled = (&A == m_.get());
+
+    stats_ = LinearSolver::Statistics();
+
+    if (!assembled || !lu_valid_) {
+        FV2D_PROFILE_SCOPE("ComputationalMeshSolverHelper::solveDirect/factorize");
+
+        lu_valid_ = false;
+
+        // only the numeric factorization if the pattern did not change
+        try {
+            lu_.refactorize(A);
+        }
+        catch (std::exception const &) {
+            // pivot too small, keep the solution
+            gatherSolutionFromCMesh(x);
+            stats_.reason = LinearSolver::DIRECT_FAILED;
+            return false;
+        }
+
+        lu_valid_ = assembled;
+
+        FV2D_PROFILE_COUNT("alloc/factor elements", lu_.nonZeros());
+    }
+
+    {
+        FV2D_PROFILE_SCOPE("ComputationalMeshSolverHelper::solveDirect/solve");
+        lu_.solve(b, x);
+    }
+
+    // the residual for the statistics and the check below
+    LinearSolver::RHS_t r(b.size());
+    A.multiply(x, r);
+
+    double residual = 0;
+    double rhs_norm = 0;
+    for (LinearSolver::RHS_t::size_type i = 0; i < b.size(); ++i) {
+        residual += (b[i] - r[i]) * (b[i] - r[i]);
+        rhs_norm += b[i] * b[i];
+    }
+
+    stats_.residual_norm = std::sqrt(residual);
+    stats_.rhs_norm      = std::sqrt(rhs_norm);
+
+    // e.g. growth of the factor without pivoting (also NaN)
+    bool success = stats_.residual_norm <= DIRECT_TOLERANCE * stats_.rhs_norm;
+
+    stats_.reason = success ? LinearSolver::SOLVED_DIRECT : LinearSolver::DIRECT_FAILED;
+
+    return success;
+}
+
+void
+ComputationalMeshSolverHelper::setWarmStart(bool warm_start) {
+    warm_start_ = warm_start;
+}
+
+bool
+ComputationalMeshSolverHelper::getWarmStart() const {
+    return warm_start_;
+}
+
+void
+ComputationalMeshSolverHelper::gatherSolutionFromCMesh(LinearSolver::RHS_t & x) const {
+    // inverse of insertSolutionIntoCMesh
+    Thread<ComputationalCell> const & cell_thread = cmesh_.getCellThread();
+
+    ComputationalVariableManager const & cvar_manager = cmesh_.getComputationalVariableManager();
+    ComputationalVariableManager::size_type nvars = cvar_manager.size();
+
+    x.resize(cell_thread.size() * nvars);
+
+    for (Thread<ComputationalCell>::size_type cell_index = 0; cell_index < cell_thread.size(); ++cell_index) {
+        ComputationalCell::Ptr const & ccell = cell_thread.getEntityAt(cell_index);
+
+        ComputationalVariableManager::Iterator_t it     = cvar_manager.begin();
+        ComputationalVariableManager::Iterator_t it_end = cvar_manager.end();
+
+        for (; it != it_end; ++it) {
+            short base_index = cvar_manager.getBaseIndex(it->name);
+
+            boost::uint64_t row = cell_index * nvars + base_index;
+            x[row] = ccell->getComputationalMolecule(it->name).getValue();
+        }
+    }
+}
+
+void
+ComputationalMeshSolverHelper::setSolverMethod(Method method) {
+    method_ = method;
+}
+
+ComputationalMeshSolverHelper::Method
+ComputationalMeshSolverHelper::getSolverMethod() const {
+    return method_;
+}
+
+void
+ComputationalMeshSolverHelper::setSolverControl(LinearSolver::Control const & control) {
+    control_ = control;
+}
+
+LinearSolver::Control const &
+ComputationalMeshSolverHelper::getSolverControl() const {
+    return control_;
+}
+
+LinearSolver::Statistics const &
+ComputationalMeshSolverHelper::getSolverStatistics() const {
+    return stats_;
 }
 
 void
@@ -95,7 +288,7 @@ ComputationalMeshSolverHelper::fillRow(boost::uint64_t row, ComputationalMolecul
         cvar_mapper_.insert(cell_index, base_index, unsigned int(cvar_index));
 
 
-        boost::uint64_t col = cell_index + base_index;
+        boost::uint64_t col = cell_index * cvar_manager.size() + base_index;
         A(row, col) = weight;
     }
 }
@@ -106,6 +299,7 @@ ComputationalMeshSolverHelper::setupMatrix() {
      * each ComputationalMolecule constitutes one
      * equation and hence one row in the linear system.
      */
+    FV2D_PROFILE_SCOPE("ComputationalMeshSolverHelper::setupMatrix");
 
     // find number of ComputationalCells
     Thread<ComputationalCell> const & cell_thread = cmesh_.getCellThread();
@@ -124,12 +318,14 @@ ComputationalMeshSolverHelper::setupMatrix() {
     m_.reset(new CSparseMatrixImpl(ncols));
     CSparseMatrixImpl & A = *m_;
 
+    lu_valid_ = false;
+
 
 
     for (Thread<ComputationalCell>::size_type cell_index = 0; cell_index < cell_thread.size(); ++cell_index) {
         ComputationalCell::Ptr const & ccell = cell_thread.getEntityAt(cell_index);
 
-        boost::uint64_t base_row = cell_index;
+        boost::uint64_t base_row = cell_index * nvars;
 
 
         ComputationalVariableManager::Iterator_t it     = cvar_manager.begin();
@@ -154,6 +350,165 @@ ComputationalMeshSolverHelper::setupMatrix() {
     }
 
     A.finalize();
+
+    FV2D_PROFILE_COUNT("alloc/matrix elements", A.nonZeros());
+}
+
+void
+ComputationalMeshSolverHelper::patchRows(boost::uint64_t cell_index) {
+    ComputationalCell::Ptr const & ccell = cmesh_.getCellThread().getEntityAt(cell_index);
+
+    ComputationalVariableManager const & cvar_manager = cmesh_.getComputationalVariableManager();
+    ComputationalVariableManager::size_type nvars = cvar_manager.size();
+
+    CSparseMatrixImpl & A = *m_;
+
+    lu_valid_ = false;
+
+    ComputationalVariableManager::Iterator_t it     = cvar_manager.begin();
+    ComputationalVariableManager::Iterator_t it_end = cvar_manager.end();
+
+    for (; it != it_end; ++it) {
+        boost::uint64_t row = cell_index * nvars + cvar_manager.getBaseIndex(it->name);
+
+        ComputationalMolecule const & cm = ccell->getComputationalMolecule(it->name);
+
+        A.setZero(row);
+
+        ComputationalMolecule::Iterator_t cm_it  = cm.begin();
+        ComputationalMolecule::Iterator_t cm_end = cm.end();
+
+        for (; cm_it != cm_end; ++cm_it) {
+            ComputationalVariable::Ptr const & cvar = cvar_manager.getComputationalVariable(cm_it->first);
+
+            boost::uint64_t col = cmesh_.getCellIndex(cvar->getCell()) * nvars + cvar_manager.getBaseIndex(cvar->getName());
+            A.at(row, col) = cm_it->second;
+        }
+
+        rhs_[row] = cm.getSourceTerm().value();
+    }
+}
+
+void
+ComputationalMeshSolverHelper::updateMatrix() {
+    FV2D_PROFILE_SCOPE("ComputationalMeshSolverHelper::updateMatrix");
+
+    if (!m_) {
+        setupMatrix();
+        return;
+    }
+
+    try {
+        Thread<ComputationalCell>::size_type ncells = cmesh_.getCellThread().size();
+
+        for (Thread<ComputationalCell>::size_type cell_index = 0; cell_index < ncells; ++cell_index)
+            patchRows(cell_index);
+    }
+    catch (std::out_of_range const &) {
+        // the sparsity pattern changed
+        setupMatrix();
+    }
+}
+
+void
+ComputationalMeshSolverHelper::updateRows(std::vector<size_t> const & cell_indices) {
+    FV2D_PROFILE_SCOPE("ComputationalMeshSolverHelper::updateRows");
+
+    if (!m_) {
+        setupMatrix();
+        return;
+    }
+
+    try {
+        std::for_each(cell_indices.begin(), cell_indices.end(), [this](size_t cell_index) {
+            patchRows(cell_index);
+        });
+    }
+    catch (std::out_of_range const &) {
+        // the sparsity pattern changed
+        setupMatrix();
+    }
+}
+
+void
+ComputationalMeshSolverHelper::updateRHS(std::vector<size_t> const & cell_indices) {
+    if (!m_)
+        throw std::logic_error("ComputationalMeshSolverHelper::updateRHS(): Matrix not yet set up");
+
+    Thread<ComputationalCell> const & cell_thread = cmesh_.getCellThread();
+
+    ComputationalVariableManager const & cvar_manager = cmesh_.getComputationalVariableManager();
+    ComputationalVariableManager::size_type nvars = cvar_manager.size();
+
+    std::for_each(cell_indices.begin(), cell_indices.end(), [&](size_t cell_index) {
+        ComputationalCell::Ptr const & ccell = cell_thread.getEntityAt(cell_index);
+
+        ComputationalVariableManager::Iterator_t it     = cvar_manager.begin();
+        ComputationalVariableManager::Iterator_t it_end = cvar_manager.end();
+
+        for (; it != it_end; ++it) {
+            boost::uint64_t row = cell_index * nvars + cvar_manager.getBaseIndex(it->name);
+            rhs_[row] = ccell->getComputationalMolecule(it->name).getSourceTerm().value();
+        }
+    });
+}
+
+bool
+ComputationalMeshSolverHelper::updateBoundaryConditions(BoundaryConditionCollection const & bc) {
+    FV2D_PROFILE_SCOPE("ComputationalMeshSolverHelper::updateBoundaryConditions");
+
+    if (!m_)
+        throw std::logic_error("ComputationalMeshSolverHelper::updateBoundaryConditions(): Matrix not yet set up");
+
+    std::vector<ComputationalFace::Ptr> changed;
+    bool type_changed = false;
+
+    Thread<ComputationalFace> const & bfaces = cmesh_.getFaceThread(IGeometricEntity::BOUNDARY);
+
+    std::for_each(bfaces.begin(), bfaces.end(), [&](ComputationalFace::Ptr const & cface) {
+        boost::optional<BoundaryConditionCollection::Pair> face_bc = bc.find(cface->geometricEntity()->meshId());
+        if (!face_bc)
+            return;
+
+        BoundaryCondition::Ptr const & old_bc = cface->getBoundaryCondition();
+
+        if (old_bc && old_bc->type() == std::get<0>(*face_bc) && old_bc->getValue() == std::get<1>(*face_bc))
+            return;
+
+        if (!old_bc || old_bc->type() != std::get<0>(*face_bc))
+            type_changed = true;
+
+        cface->setBoundaryCondition(std::make_shared<BoundaryCondition>(*face_bc));
+        changed.push_back(cface);
+    });
+
+    if (changed.empty())
+        return true;
+
+    std::vector<size_t> cell_indices = cmesh_.reevaluate(changed, std::vector<ComputationalCell::Ptr>());
+
+    FV2D_PROFILE_COUNT("boundary update/faces", changed.size());
+
+    if (type_changed) {
+        updateRows(cell_indices);
+        return false;
+    }
+
+    updateRHS(cell_indices);
+
+    return true;
+}
+
+std::vector<LinearSolver::Statistics> const &
+ComputationalMeshSolverHelper::getBlockStatistics() const {
+    return block_stats_;
+}
+
+boost::uint64_t
+ComputationalMeshSolverHelper::getNumberOfNonZeros() const {
+    if (!m_)
+        return 0;
+    return m_->nonZeros();
 }
 
 IMatrix2D const &
@@ -161,6 +516,42 @@ ComputationalMeshSolverHelper::getMatrix() const {
     return *(m_.get());
 }
 
+CSparseMatrixImpl const &
+ComputationalMeshSolverHelper::getSparseMatrix() const {
+    if (!m_)
+        throw std::logic_error("ComputationalMeshSolverHelper::getSparseMatrix(): Matrix not yet set up");
+    return *m_;
+}
+
+CSparseMatrixImpl &
+ComputationalMeshSolverHelper::modifySparseMatrix() {
+    if (!m_) {
+        boost::format format = boost::format("ComputationalMeshSolverHelper::modifySparseMatrix: Matrix not yet set up!\n");
+        Util::error(format.str());
+        throw std::logic_error(format.str().c_str());
+    }
+
+    lu_valid_ = false;
+
+    return *m_;
+}
+
+LinearSolver::RHS_t &
+ComputationalMeshSolverHelper::modifyRHS() {
+    if (!m_) {
+        boost::format format = boost::format("ComputationalMeshSolverHelper::modifyRHS: Matrix not yet set up!\n");
+        Util::error(format.str());
+        throw std::logic_error(format.str().c_str());
+    }
+
+    return rhs_;
+}
+
+boost::uint64_t
+ComputationalMeshSolverHelper::getRow(boost::uint64_t cell_index, short base_index) const {
+    return cell_index * cmesh_.getComputationalVariableManager().size() + base_index;
+}
+
 LinearSolver::RHS_t const &
 ComputationalMeshSolverHelper::getRHS() const {
     return rhs_;
@@ -14,6 +14,7 @@
 
 #include "Solver/CSparseMatrixImpl.h"
 #include "Solver/LinearSolver.h"
+#include "Solver/SparseLU.h"
 
 #include <memory>
 #include <vector>
@@ -22,6 +23,7 @@
 
 
 class IComputationalMesh;
+class BoundaryConditionCollection;
 class IMatrix2D;
 class ComputationalMolecule;
 class ComputationalVariableManager;
@@ -34,10 +36,123 @@ class DECL_SYMBOLS_2D ComputationalMeshSolverHelper {
 
     friend class ComputationalMeshSolverHelperTest;
 
+public:
+    /* SOR: iterative, see setSolverControl() and setWarmStart().
+     * SPARSE_LU: direct; the factor of the assembled matrix is kept
+     * until the matrix changes, i.e. repeated solves, e.g. of a
+     * boundary value sweep, only cost the triangular solves.
+     * Neither method pivots, both rely on a dominant diagonal. It is
+     * for diffusion and upwinded convection, but not e.g. for CENTRAL
+     * convection at cell Peclet numbers above 2 or with inflow through
+     * a von Neumann face (see ConvectionScheme). Then SOR may diverge,
+     * and SPARSE_LU fails (LinearSolver::DIRECT_FAILED) if a pivot is
+     * too small (see SparseLU::setPivotTolerance()) or the residual
+     * too large (see DIRECT_TOLERANCE).
+     */
+    enum Method {SOR, SPARSE_LU};
+
+    // SPARSE_LU: largest l2 norm of the residual relative to the one of the r.h.s.
+    static double const DIRECT_TOLERANCE;
+
 public:
     ComputationalMeshSolverHelper(IComputationalMesh const & cmesh);
 
-    bool solve();
+    // setupMatrix() followed by solveSystem()
+    bool              solve();
+
+    // assemble the linear system from the cell molecules
+    void              setupMatrix();
+
+    /* Re-assemble after the cell molecules have been re-evaluated,
+     * e.g. with solution dependent coefficients. The values are written
+     * into the existing sparsity pattern; if a molecule refers to an
+     * element not in the pattern, the system is set up from scratch.
+     */
+    void              updateMatrix();
+
+    // as updateMatrix(), only for the rows of the given cells, see ComputationalMesh::reevaluate()
+    void              updateRows(std::vector<size_t> const & cell_indices);
+
+    // as updateRows(), only the r.h.s.
+    void              updateRHS(std::vector<size_t> const & cell_indices);
+
+    /* Apply new boundary values, e.g. in a parametric sweep, without
+     * rebuilding the mesh (after setupMatrix()). Only the cells at
+     * boundary faces whose condition changed are re-evaluated. Faces
+     * not in bc keep their condition.
+     * If only the values changed, only the r.h.s. is updated and true
+     * is returned, i.e. the matrix and anything derived from it can be
+     * reused. This assumes the flux evaluators are linear in the
+     * boundary values, i.e. the weights depend on the type only.
+     * If a type changed, the matrix rows are updated as well and false
+     * is returned.
+     */
+    bool              updateBoundaryConditions(BoundaryConditionCollection const & bc);
+
+    /* Solve the assembled system and insert the solution into the mesh.
+     * Returns false if the solver did not converge or the direct solver
+     * failed, see getSolverStatistics() for the reason. If the
+     * factorization failed, the solution in the mesh is kept.
+     */
+    bool              solveSystem();
+
+    /* Solve a modified system, e.g. including a time derivative, with
+     * the same layout as the assembled one and insert the solution into
+     * the mesh.
+     */
+    bool              solveSystem(CSparseMatrixImpl const & A, LinearSolver::RHS_t const & b);
+
+    /* Solve the assembled matrix for several r.h.s. at once, e.g. the
+     * cases of a parametric sweep (see getRHS() and updateBoundaryConditions()).
+     * The solutions are returned in x and not inserted into the mesh;
+     * all start from the solution stored in the mesh (warm start) or
+     * from zero. Returns false if any did not converge, see
+     * getBlockStatistics().
+     */
+    bool              solveSystems(LinearSolver::RHSBlock_t const & b, LinearSolver::RHSBlock_t & x);
+
+    // assembled system (after setupMatrix())
+    CSparseMatrixImpl const &   getSparseMatrix() const;
+    LinearSolver::RHS_t const & getRHS() const;
+
+    /* Write access to the assembled system, e.g. for terms added face
+     * by face within the sparsity pattern (see ConvectionScheme). The
+     * cached factor is dropped; the changes are lost by the next
+     * setupMatrix() or update. Both throw std::logic_error before the
+     * matrix is set up.
+     */
+    CSparseMatrixImpl &         modifySparseMatrix();
+    LinearSolver::RHS_t &       modifyRHS();
+
+    // row of the variable with base index base_index of cell cell_index
+    boost::uint64_t   getRow(boost::uint64_t cell_index, short base_index) const;
+
+    // transfer between the mesh and vectors in the system layout
+    void              insertSolutionIntoCMesh(LinearSolver::RHS_t const & x);
+    void              gatherSolutionFromCMesh(LinearSolver::RHS_t & x) const;
+
+    /* Start the iterative solver from the values currently stored
+     * in the cell molecules (default) instead of from zero.
+     */
+    void                             setWarmStart(bool warm_start);
+    bool                             getWarmStart() const;
+
+    // default SOR
+    void                             setSolverMethod(Method method);
+    Method                           getSolverMethod() const;
+
+    // termination criteria, residual monitor
+    void                             setSolverControl(LinearSolver::Control const & control);
+    LinearSolver::Control const &    getSolverControl() const;
+
+    // of the last solve
+    LinearSolver::Statistics const & getSolverStatistics() const;
+
+    // of the last solveSystems(), one per r.h.s.
+    std::vector<LinearSolver::Statistics> const & getBlockStatistics() const;
+
+    // number of non-zero matrix elements (after setupMatrix())
+    boost::uint64_t   getNumberOfNonZeros() const;
 
 private:
 
@@ -69,16 +184,19 @@ private:
     ComputationalMeshSolverHelper(ComputationalMeshSolverHelper const & in);
     ComputationalMeshSolverHelper & operator=(ComputationalMeshSolverHelper const & in);
 
-    // setup matrix
-    void              setupMatrix();
-
     void              fillRow(boost::uint64_t row, ComputationalMolecule const & cm, CSparseMatrixImpl & A, ComputationalVariableManager const & cvar_manager);
 
-    void              insertSolutionIntoCMesh(LinearSolver::RHS_t const & x);
+    // overwrite the rows of a cell within the sparsity pattern, throws std::out_of_range if it does not fit
+    void              patchRows(boost::uint64_t cell_index);
+
+    /* x = A^{-1} b by SparseLU, the factor of m_ is cached. Returns
+     * false if the factorization failed (x is the solution in the
+     * mesh) or the residual is too large.
+     */
+    bool              solveDirect(CSparseMatrixImpl const & A, LinearSolver::RHS_t const & b, LinearSolver::RHS_t & x);
 
     // for unit testing
     IMatrix2D const &           getMatrix() const;
-    LinearSolver::RHS_t const & getRHS() const;
 
 private:
     IComputationalMesh const &         cmesh_;
@@ -88,6 +206,18 @@ private:
     LinearSolver::RHS_t                rhs_;
 
     ComputationalVariableMapper        cvar_mapper_;
+
+    bool                               warm_start_;
+
+    Method                             method_;
+    SparseLU                           lu_;
+
+    // lu_ holds the factor of m_
+    bool                               lu_valid_;
+
+    LinearSolver::Control              control_;
+    LinearSolver::Statistics           stats_;
+    std::vector<LinearSolver::Statistics> block_stats_;
 };
 
 #pragma warning(default:4251)
@@ -5,11 +5,13 @@
 
 ComputationalMolecule::ComputationalMolecule()
     :
-    ComputationalMoleculeImpl("undef") {}
+    ComputationalMoleculeImpl("undef"),
+    value_(0) {}
 
 ComputationalMolecule::ComputationalMolecule(std::string const & var_name)
     :
-    ComputationalMoleculeImpl(var_name) {}
+    ComputationalMoleculeImpl(var_name),
+    value_(0) {}
 
 bool
 ComputationalMolecule::addMolecule(FluxComputationalMolecule const & in) {
@@ -27,7 +27,7 @@ public:
     // add the contributions of flux molecules to this one
     bool addMolecule(FluxComputationalMolecule const & in);
 
-    // insert a solution value
+    // insert a solution value, not affected by clear()
     void   setValue(double value);
     double getValue() const;
 
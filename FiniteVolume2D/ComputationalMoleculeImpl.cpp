@@ -106,6 +106,12 @@ ComputationalMoleculeImpl::empty() const {
     return data_.empty();
 }
 
+void
+ComputationalMoleculeImpl::clear() {
+    data_.clear();
+    source_term_ = SourceTerm();
+}
+
 SourceTerm &
 ComputationalMoleculeImpl::getSourceTerm() {
     return source_term_;
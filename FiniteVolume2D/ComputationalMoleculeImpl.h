@@ -56,6 +56,9 @@ public:
     size_type               size() const;
     bool                    empty() const;
 
+    // remove all weights and the source term, e.g. to re-evaluate the molecule
+    void                    clear();
+
     SourceTerm const &      getSourceTerm() const;
     SourceTerm &            getSourceTerm();
 
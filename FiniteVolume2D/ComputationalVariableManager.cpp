@@ -37,8 +37,11 @@ ComputationalVariableManager::create(ComputationalCell::Ptr const & cell, std::s
         return false;
     }
 
-    // create the unique id for the comp. variable
-    ComputationalVariable::Id_t cvar_id = cell->id() + getBaseIndex(name);
+    /* create the unique id for the comp. variable; the variables
+     * of one cell are consecutive so that the ids of neighboring
+     * cells do not overlap
+     */
+    ComputationalVariable::Id_t cvar_id = cell->id() * variables_.size() + getBaseIndex(name);
 
     ComputationalVariable::Ptr cvar = ComputationalVariable::create(cell, name, cvar_id);
 
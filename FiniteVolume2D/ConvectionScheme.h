@@ -0,0 +1,128 @@
+/*
+ * Name  : ConvectionScheme
+ * Path  :
+ * Use   : Convection term div(F \phi) of one variable for a given mass
+ *         flux F per face, added to the system assembled from the
+ *         diffusion term of the variable (see DiffusionFluxEvaluator)
+ *         in one pass over the faces, without flux molecules.
+ *         In the form of Patankar, with D = \gamma |E| / |d| of the face
+ *         and the Peclet number P = F / D, the neighbour coefficient of
+ *         the face is a_N = D A(|P|) + max(-F, 0) and a_P = \sum a_N +
+ *         \sum F. Versteeg, Malalasekera, p. 157:
+ *         - UPWIND:    A = 1
+ *         - CENTRAL:   A = 1 - 0.5 |P|
+ *         - HYBRID:    A = max(0, 1 - 0.5 |P|)
+ *         - POWER_LAW: A = max(0, (1 - 0.1 |P|)^5)
+ *         - TVD:       upwind in the matrix, the limited high order part
+ *                      F \psi(r) (\phi_D - \phi_C) / 2 of the face value
+ *                      is a deferred correction (see correction() and
+ *                      DeferredCorrectionSolver::setConvection()), with
+ *                      r = (\phi_C - \phi_U) / (\phi_D - \phi_C) for the
+ *                      virtual far upwind value \phi_U = \phi_D - 2
+ *                      (\grad \phi)_C . d_CD on unstructured meshes,
+ *                      Darwish, Moukalled (2003), bounded by the
+ *                      neighbours of C to keep the solution bounded.
+ *         Boundary faces are upwind: the inflow through a Dirichlet face
+ *         carries the boundary value, all other faces the cell value.
+ *         The matrix is diagonally dominant (bounded solution, stable
+ *         SparseLU without pivoting, converging SOR) for all schemes but
+ *         CENTRAL at cell Peclet numbers |P| > 2, and only if no flow
+ *         enters through a von Neumann face (the inflow lowers the
+ *         diagonal) and the mass flux is conservative. Otherwise either
+ *         solver may fail, i.e. check the result of the solve.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include "Solver/LinearSolver.h"
+
+#include <vector>
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+
+
+class Mesh;
+class ComputationalMesh;
+class ComputationalMeshSolverHelper;
+class DiffusionFluxEvaluator;
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2D ConvectionScheme {
+public:
+    typedef std::vector<double> Array_t;
+
+    enum Scheme {UPWIND, CENTRAL, HYBRID, POWER_LAW, TVD};
+    enum Limiter {MINMOD, VAN_LEER, VAN_ALBADA, SUPERBEE, UMIST};
+
+public:
+    /* mesh: the geometric mesh cmesh was built from.
+     * diffusion: the flux evaluator of the variable, must outlive the scheme.
+     * The mass flux is zero until set.
+     * Throws std::logic_error if the variable is unknown or the meshes
+     * do not match.
+     */
+    ConvectionScheme(ComputationalMesh const & cmesh, Mesh const & mesh, DiffusionFluxEvaluator const & diffusion,
+                     Scheme scheme = UPWIND, Limiter limiter = VAN_LEER);
+
+    Scheme                         getScheme() const;
+    Limiter                        getLimiter() const;
+    DiffusionFluxEvaluator const & getDiffusionFluxEvaluator() const;
+
+    /* Per face (ComputationalFace::index()), out of the first cell of
+     * DiffusionFluxEvaluator::faceCells(). Throws std::out_of_range if
+     * the size does not match.
+     */
+    void                           setMassFlux(Array_t const & mass_flux);
+    Array_t const &                getMassFlux() const;
+
+    // F = (u, v) . S, unit density
+    void                           setVelocity(double u, double v);
+
+    /* Adds the convection term to the system assembled by helper (after
+     * setupMatrix()). The couplings of the faces must be in the sparsity
+     * pattern, i.e. a diffusion term is required (\gamma may be zero),
+     * otherwise std::out_of_range is thrown.
+     */
+    void                           assemble(ComputationalMeshSolverHelper & helper) const;
+
+    /* TVD only: adds the explicit part of the face values for the
+     * solution phi (system layout) with the cell gradients gx, gy (see
+     * CellGradient) to c.
+     */
+    void                           correction(ComputationalMeshSolverHelper const & helper, LinearSolver::RHS_t const & phi,
+                                              Array_t const & gx, Array_t const & gy, LinearSolver::RHS_t & c) const;
+
+    // \psi(r)
+    static double                  limit(Limiter limiter, double r);
+
+    static char const *            toString(Scheme scheme);
+
+private:
+    ConvectionScheme(ConvectionScheme const & in);
+    ConvectionScheme & operator=(ConvectionScheme const & in);
+
+private:
+    ComputationalMesh const &      cmesh_;
+    DiffusionFluxEvaluator const & diffusion_;
+
+    Scheme                         scheme_;
+    Limiter                        limiter_;
+    short                          base_index_;
+
+    // per face: S out of the first cell, centroid of the second - first
+    Array_t                        sx_;
+    Array_t                        sy_;
+    Array_t                        dx_;
+    Array_t                        dy_;
+
+    Array_t                        mass_flux_;
+};
+
+#pragma warning(default:4251)
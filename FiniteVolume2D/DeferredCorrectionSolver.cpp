@@ -0,0 +1,247 @@
+#include "DeferredCorrectionSolver.h"
+
+#include "DiffusionFluxEvaluator.h"
+#include "ConvectionScheme.h"
+#include "CellSourceTerms.h"
+#include "ComputationalMesh.h"
+#include "ComputationalVariableManager.h"
+#include "BoundaryCondition.h"
+
+#include "FiniteVolume2DLib/Mesh.h"
+#include "FiniteVolume2DLib/MeshGeometry.h"
+#include "FiniteVolume2DLib/Thread.hpp"
+#include "FiniteVolume2DLib/Profiler.h"
+#include "FiniteVolume2DLib/Util.h"
+
+#include <boost/format.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+
+
+DeferredCorrectionSolver::DeferredCorrectionSolver(ComputationalMesh const & cmesh, Mesh const & mesh, DiffusionFluxEvaluator const & evaluator,
+                                                   CellGradient::Method method, unsigned int nthreads)
+    :
+    cmesh_(cmesh),
+    evaluator_(evaluator),
+    convection_(nullptr),
+    source_(nullptr),
+    geometry_(mesh),
+    method_(method),
+    nthreads_(nthreads),
+    base_index_(cmesh.getComputationalVariableManager().getBaseIndex(evaluator.getVariableName())),
+    helper_(cmesh) {
+
+    if (base_index_ < 0) {
+        boost::format format = boost::format("DeferredCorrectionSolver: Unknown computational variable %1%!\n") % evaluator.getVariableName();
+        Util::error(format.str());
+        throw std::logic_error(format.str().c_str());
+    }
+
+    if (geometry_.getNumberOfCells() != cmesh_.getCellThread().size() || geometry_.getNumberOfFaces() != evaluator_.getNumberOfFaces()) {
+        boost::format format = boost::format("DeferredCorrectionSolver: Mesh does not match the computational mesh or the flux evaluator!\n");
+        Util::error(format.str());
+        throw std::logic_error(format.str().c_str());
+    }
+
+    gatherBoundaryConditions();
+}
+
+void
+DeferredCorrectionSolver::setControl(Control const & control) {
+    control_ = control;
+}
+
+DeferredCorrectionSolver::Control const &
+DeferredCorrectionSolver::getControl() const {
+    return control_;
+}
+
+void
+DeferredCorrectionSolver::setSolverMethod(ComputationalMeshSolverHelper::Method method) {
+    helper_.setSolverMethod(method);
+}
+
+void
+DeferredCorrectionSolver::setSolverControl(LinearSolver::Control const & control) {
+    helper_.setSolverControl(control);
+}
+
+DeferredCorrectionSolver::Statistics const &
+DeferredCorrectionSolver::getStatistics() const {
+    return stats_;
+}
+
+void
+DeferredCorrectionSolver::setConvection(ConvectionScheme const * convection) {
+    if (convection && convection->getDiffusionFluxEvaluator().getVariableName() != evaluator_.getVariableName()) {
+        boost::format format = boost::format("DeferredCorrectionSolver: Convection of %1% instead of %2%!\n")
+            % convection->getDiffusionFluxEvaluator().getVariableName() % evaluator_.getVariableName();
+        Util::error(format.str());
+        throw std::logic_error(format.str().c_str());
+    }
+
+    convection_ = convection;
+}
+
+void
+DeferredCorrectionSolver::setSource(CellSourceTerms const * source) {
+    source_ = source;
+}
+
+ComputationalMeshSolverHelper &
+DeferredCorrectionSolver::getHelper() {
+    return helper_;
+}
+
+void
+DeferredCorrectionSolver::gatherBoundaryConditions() {
+    std::vector<int> bc_type(evaluator_.getNumberOfFaces(), -1);
+    bc_value_.assign(evaluator_.getNumberOfFaces(), 0.0);
+
+    Thread<ComputationalFace> const & face_thread = cmesh_.getFaceThread(IGeometricEntity::BOUNDARY);
+
+    std::for_each(face_thread.begin(), face_thread.end(), [&](ComputationalFace::Ptr const & cface) {
+        BoundaryCondition::Ptr const & bc = cface->getBoundaryCondition();
+        if (!bc)
+            return;
+
+        bc_type[cface->index()]   = bc->type();
+        bc_value_[cface->index()] = bc->getValue();
+    });
+
+    if (gradient_ && bc_type == bc_type_)
+        return;
+
+    bc_type_.swap(bc_type);
+
+    // the value at all boundary faces but the Dirichlet ones follows from the gradient
+    MeshGeometry::Index_t const & face_cells = geometry_.faceCells();
+
+    std::vector<bool> extrapolated(bc_type_.size(), false);
+    for (std::size_t face = 0; face < bc_type_.size(); ++face)
+        extrapolated[face] = face_cells[2 * face + 1] == MeshGeometry::NO_CELL && bc_type_[face] != BoundaryConditionCollection::DIRICHLET;
+
+    gradient_.reset(new CellGradient(geometry_, method_, nthreads_, extrapolated));
+}
+
+void
+DeferredCorrectionSolver::correction(LinearSolver::RHS_t const & phi, LinearSolver::RHS_t & c) {
+    FV2D_PROFILE_SCOPE("DeferredCorrectionSolver::correction");
+
+    std::size_t ncells = geometry_.getNumberOfCells();
+    std::size_t nfaces = geometry_.getNumberOfFaces();
+
+    MeshGeometry::Index_t const & face_cells = evaluator_.faceCells();
+    DiffusionFluxEvaluator::Array_t const & tx = evaluator_.correctionX();
+    DiffusionFluxEvaluator::Array_t const & ty = evaluator_.correctionY();
+    DiffusionFluxEvaluator::Array_t const & g  = evaluator_.interpolation();
+
+    CellGradient::Array_t cell_values(ncells);
+    for (std::size_t cell = 0; cell < ncells; ++cell)
+        cell_values[cell] = phi[helper_.getRow(cell, base_index_)];
+
+    gradient_->compute(cell_values, bc_value_, gx_, gy_);
+
+    double gamma = evaluator_.getDiffusionCoefficient();
+
+    c.assign(phi.size(), 0.0);
+
+    for (std::size_t face = 0; face < nfaces; ++face) {
+        boost::uint64_t c1 = face_cells[2 * face];
+        boost::uint64_t c2 = face_cells[2 * face + 1];
+
+        if (c2 == MeshGeometry::NO_CELL) {
+            // the flux through a von Neumann face is given
+            if (bc_type_[face] != BoundaryConditionCollection::DIRICHLET)
+                continue;
+
+            c[helper_.getRow(c1, base_index_)] += gamma * (tx[face] * gx_[c1] + ty[face] * gy_[c1]);
+            continue;
+        }
+
+        double fgx = g[face] * gx_[c1] + (1.0 - g[face]) * gx_[c2];
+        double fgy = g[face] * gy_[c1] + (1.0 - g[face]) * gy_[c2];
+
+        // T points out of the first cell
+        double flux = gamma * (tx[face] * fgx + ty[face] * fgy);
+
+        c[helper_.getRow(c1, base_index_)] += flux;
+        c[helper_.getRow(c2, base_index_)] -= flux;
+    }
+
+    if (convection_)
+        convection_->correction(helper_, phi, gx_, gy_, c);
+}
+
+bool
+DeferredCorrectionSolver::solve() {
+    FV2D_PROFILE_SCOPE("DeferredCorrectionSolver::solve");
+
+    stats_ = Statistics();
+
+    gatherBoundaryConditions();
+
+    // the compact stencil, assembled (and factorized) once
+    helper_.setupMatrix();
+
+    if (convection_)
+        convection_->assemble(helper_);
+
+    if (source_)
+        source_->assemble(helper_);
+
+    LinearSolver::RHS_t const b = helper_.getRHS();
+    CSparseMatrixImpl const & A = helper_.getSparseMatrix();
+
+    LinearSolver::RHS_t phi;
+    LinearSolver::RHS_t phi_new;
+    LinearSolver::RHS_t rhs;
+    LinearSolver::RHS_t y(b.size());
+    helper_.gatherSolutionFromCMesh(phi);
+
+    double update = 0.0;
+
+    for (;;) {
+        correction(phi, rhs);
+        for (LinearSolver::RHS_t::size_type i = 0; i < b.size(); ++i)
+            rhs[i] += b[i];
+
+        A.multiply(phi, y);
+
+        double residual = 0.0;
+        for (LinearSolver::RHS_t::size_type i = 0; i < b.size(); ++i)
+            residual += (rhs[i] - y[i]) * (rhs[i] - y[i]);
+        residual = std::sqrt(residual);
+
+        FV2D_PROFILE_SAMPLE("deferred correction/residual", residual);
+
+        if (stop(control_, stats_, residual, update))
+            break;
+
+        // same matrix, i.e. the factor is reused; warm started from phi otherwise
+        bool success = helper_.solveSystem(A, rhs);
+
+        stats_.linear_iterations += helper_.getSolverStatistics().iterations;
+
+        if (!success) {
+            stats_.reason = LINEAR_SOLVER_FAILED;
+            break;
+        }
+
+        helper_.gatherSolutionFromCMesh(phi_new);
+
+        update = 0.0;
+        for (LinearSolver::RHS_t::size_type i = 0; i < phi.size(); ++i)
+            update = std::max(update, std::fabs(phi_new[i] - phi[i]));
+
+        stats_.update_norm = update;
+
+        phi.swap(phi_new);
+
+        stats_.iterations++;
+    }
+
+    return stats_.converged();
+}
@@ -0,0 +1,127 @@
+/*
+ * Name  : DeferredCorrectionSolver
+ * Path  :
+ * Use   : Deferred correction for the non-orthogonal part of a
+ *         diffusion term set up with a DiffusionFluxEvaluator.
+ *         The matrix keeps the compact two point stencil along the
+ *         line between the cell centroids; it is assembled once and
+ *         reused, i.e. with SPARSE_LU it is factorized once. The cross-
+ *         diffusion \gamma T . (\grad \phi)_f of all faces is evaluated
+ *         from the current solution (gradients by CellGradient,
+ *         interpolated linearly to the faces) and added to the r.h.s.,
+ *             A \phi^{k+1} = b + c(\phi^k),
+ *         until the residual b + c(\phi) - A \phi or the change of the
+ *         solution is small enough. At von Neumann faces the flux is
+ *         given, i.e. there is no correction; the face value for the
+ *         gradients is extrapolated from the cell (see CellGradient).
+ *         Other variables of the mesh are solved along, without
+ *         correction. A convection term (see ConvectionScheme) and
+ *         volumetric sources (see CellSourceTerms) are added to the
+ *         system once, the TVD part of the convection is corrected along.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include "ComputationalMeshSolverHelper.h"
+#include "OuterIteration.h"
+
+#include "Solver/LinearSolver.h"
+
+#include "FiniteVolume2DLib/CellGradient.h"
+#include "FiniteVolume2DLib/MeshGeometry.h"
+
+#include <memory>
+#include <vector>
+
+
+class Mesh;
+class ComputationalMesh;
+class DiffusionFluxEvaluator;
+class ConvectionScheme;
+class CellSourceTerms;
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2D DeferredCorrectionSolver : public OuterIteration {
+public:
+    // Control, Statistics: the residual is the l2 norm of b + c(phi) - A phi
+
+    /* mesh: the geometric mesh cmesh was built from.
+     * evaluator: the flux evaluator of the variable, must outlive the solver.
+     * nthreads: for the gradients, 0: one thread per core.
+     * Throws std::logic_error if the variable is unknown or the meshes
+     * do not match.
+     */
+    DeferredCorrectionSolver(ComputationalMesh const & cmesh, Mesh const & mesh, DiffusionFluxEvaluator const & evaluator,
+                             CellGradient::Method method = CellGradient::LEAST_SQUARES, unsigned int nthreads = 0);
+
+    void                             setControl(Control const & control);
+    Control const &                  getControl() const;
+
+    // for the linear solves, see ComputationalMeshSolverHelper
+    void                             setSolverMethod(ComputationalMeshSolverHelper::Method method);
+    void                             setSolverControl(LinearSolver::Control const & control);
+
+    Statistics const &               getStatistics() const;
+
+    /* Convection of the variable, must outlive the solver; nullptr:
+     * none (default). Throws std::logic_error if the scheme is for
+     * another variable.
+     */
+    void                             setConvection(ConvectionScheme const * convection);
+
+    // sources of the variables, must outlive the solver; nullptr: none (default)
+    void                             setSource(CellSourceTerms const * source);
+
+    // starting from the values in the cell molecules
+    bool                             solve();
+
+    /* Explicit correction c(phi) in the system layout (see
+     * ComputationalMeshSolverHelper::getRow()) for the solution phi.
+     */
+    void                             correction(LinearSolver::RHS_t const & phi, LinearSolver::RHS_t & c);
+
+    ComputationalMeshSolverHelper &  getHelper();
+
+private:
+    DeferredCorrectionSolver(DeferredCorrectionSolver const & in);
+    DeferredCorrectionSolver & operator=(DeferredCorrectionSolver const & in);
+
+    /* Boundary conditions per face, as currently set in the mesh; the
+     * gradient weights are recomputed if a type changed.
+     */
+    void                             gatherBoundaryConditions();
+
+private:
+    ComputationalMesh const &        cmesh_;
+    DiffusionFluxEvaluator const &   evaluator_;
+    ConvectionScheme const *         convection_;
+    CellSourceTerms const *          source_;
+
+    MeshGeometry                     geometry_;
+    CellGradient::Method             method_;
+    unsigned int                     nthreads_;
+    std::unique_ptr<CellGradient>    gradient_;
+    short                            base_index_;
+
+    ComputationalMeshSolverHelper    helper_;
+
+    // per face: -1 interior, else BoundaryConditionCollection::Type
+    std::vector<int>                 bc_type_;
+    CellGradient::Array_t            bc_value_;
+
+    // cell gradients of the last correction()
+    CellGradient::Array_t            gx_;
+    CellGradient::Array_t            gy_;
+
+    Control                          control_;
+
+    Statistics                       stats_;
+};
+
+#pragma warning(default:4251)
@@ -0,0 +1,209 @@
+#include "DiffusionFluxEvaluator.h"
+
+#include "IComputationalGridAccessor.h"
+#include "FluxComputationalMolecule.h"
+#include "ComputationalMolecule.h"
+#include "ComputationalVariable.h"
+#include "BoundaryCondition.h"
+#include "SourceTerm.h"
+
+#include "FiniteVolume2DLib/Mesh.h"
+#include "FiniteVolume2DLib/Util.h"
+
+#include <boost/format.hpp>
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+
+DiffusionFluxEvaluator::DiffusionFluxEvaluator(Mesh const & mesh, std::string const & var_name, double gamma, Correction correction)
+    :
+    var_name_(var_name),
+    gamma_(gamma),
+    correction_(correction) {
+
+    MeshGeometry geometry(mesh);
+
+    face_cells_ = geometry.faceCells();
+
+    MeshGeometry::Array_t const & ccx = geometry.cellCentroidX();
+    MeshGeometry::Array_t const & ccy = geometry.cellCentroidY();
+    MeshGeometry::Array_t const & fcx = geometry.faceCentroidX();
+    MeshGeometry::Array_t const & fcy = geometry.faceCentroidY();
+    MeshGeometry::Array_t const & nx  = geometry.faceNormalX();
+    MeshGeometry::Array_t const & ny  = geometry.faceNormalY();
+
+    std::size_t nfaces = geometry.getNumberOfFaces();
+
+    coefficient_.resize(nfaces);
+    distance_.resize(nfaces);
+    tx_.resize(nfaces);
+    ty_.resize(nfaces);
+    interpolation_.resize(nfaces);
+
+    for (std::size_t face = 0; face < nfaces; ++face) {
+        boost::uint64_t c1 = face_cells_[2 * face];
+        boost::uint64_t c2 = face_cells_[2 * face + 1];
+
+        bool boundary = c2 == MeshGeometry::NO_CELL;
+
+        double dx = (boundary ? fcx[face] : ccx[c2]) - ccx[c1];
+        double dy = (boundary ? fcy[face] : ccy[c2]) - ccy[c1];
+
+        // S points away from the first cell
+        double sx = nx[face];
+        double sy = ny[face];
+        if (sx * (fcx[face] - ccx[c1]) + sy * (fcy[face] - ccy[c1]) < 0) {
+            sx = -sx;
+            sy = -sy;
+        }
+
+        double dd = dx * dx + dy * dy;
+        double ds = dx * sx + dy * sy;
+        double ss = sx * sx + sy * sy;
+
+        double dist = std::sqrt(dd);
+
+        // E = factor d
+        double factor = 0.0;
+        switch (correction_) {
+        case NONE:
+        case ORTHOGONAL_CORRECTION:
+            factor = std::sqrt(ss) / dist;
+            break;
+        case MINIMUM_CORRECTION:
+            factor = ds / dd;
+            break;
+        case OVER_RELAXED:
+            factor = ss / ds;
+            break;
+        }
+
+        // |E| / |d|
+        coefficient_[face] = gamma_ * factor;
+        distance_[face]    = dist;
+
+        tx_[face] = correction_ == NONE ? 0.0 : sx - factor * dx;
+        ty_[face] = correction_ == NONE ? 0.0 : sy - factor * dy;
+
+        // projection of the face centroid onto d
+        interpolation_[face] = boundary ? 1.0 : ((ccx[c2] - fcx[face]) * dx + (ccy[c2] - fcy[face]) * dy) / dd;
+    }
+}
+
+bool
+DiffusionFluxEvaluator::operator()(IComputationalGridAccessor const & cgrid, ComputationalCell::Ptr const & ccell, ComputationalFace::Ptr const & cface) const {
+    FluxComputationalMolecule & flux_molecule = cface->getComputationalMolecule(var_name_);
+
+    // flux through face already computed?
+    if (!flux_molecule.empty())
+        return true;
+
+    std::size_t face = cface->index();
+    if (face >= coefficient_.size()) {
+        boost::format format = boost::format("DiffusionFluxEvaluator: Face %1% not in the mesh the weights were computed for!\n") % face;
+        Util::error(format.str());
+        throw std::logic_error(format.str().c_str());
+    }
+
+    flux_molecule.setCell(ccell);
+
+    ComputationalVariable::Ptr const & cvar = ccell->getComputationalVariable(var_name_);
+
+    double weight = coefficient_[face];
+
+    BoundaryCondition::Ptr const & bc = cface->getBoundaryCondition();
+
+    if (bc) {
+        if (bc->type() == BoundaryConditionCollection::DIRICHLET) {
+            // the boundary value contributes as a source term
+            flux_molecule.getSourceTerm() += weight * bc->getValue();
+
+            // insert with opposite sign (convention)
+            flux_molecule.add(*cvar, weight);
+        }
+        else
+            // the boundary flux contributes as a source term
+            flux_molecule.getSourceTerm() += bc->getValue();
+
+        return true;
+    }
+
+    ComputationalCell::Ptr const & cell_nbr = cgrid.getOtherCell(cface, ccell);
+
+    // insert with opposite sign (convention)
+    flux_molecule.add(*cvar, weight);
+    flux_molecule.add(*cell_nbr->getComputationalVariable(var_name_), -weight);
+
+    return true;
+}
+
+bool
+DiffusionFluxEvaluator::evaluateCell(ComputationalCell::Ptr const & ccell) const {
+    EntityCollection<ComputationalFace> const & cface_coll = ccell->getComputationalFaces();
+
+    ComputationalMolecule & cmolecule = ccell->getComputationalMolecule(var_name_);
+
+    std::for_each(cface_coll.begin(), cface_coll.end(), [&](ComputationalFace::Ptr const & cface) {
+        FluxComputationalMolecule & flux_molecule = cface->getComputationalMolecule(var_name_);
+
+        // negate the weights if they were calculated with the neighboring cell
+        if (flux_molecule.getCell() != ccell)
+            flux_molecule = -flux_molecule;
+
+        cmolecule += flux_molecule;
+    });
+
+    return true;
+}
+
+std::string const &
+DiffusionFluxEvaluator::getVariableName() const {
+    return var_name_;
+}
+
+double
+DiffusionFluxEvaluator::getDiffusionCoefficient() const {
+    return gamma_;
+}
+
+DiffusionFluxEvaluator::Correction
+DiffusionFluxEvaluator::getCorrection() const {
+    return correction_;
+}
+
+std::size_t
+DiffusionFluxEvaluator::getNumberOfFaces() const {
+    return coefficient_.size();
+}
+
+MeshGeometry::Index_t const &
+DiffusionFluxEvaluator::faceCells() const {
+    return face_cells_;
+}
+
+DiffusionFluxEvaluator::Array_t const &
+DiffusionFluxEvaluator::coefficient() const {
+    return coefficient_;
+}
+
+DiffusionFluxEvaluator::Array_t const &
+DiffusionFluxEvaluator::distance() const {
+    return distance_;
+}
+
+DiffusionFluxEvaluator::Array_t const &
+DiffusionFluxEvaluator::correctionX() const {
+    return tx_;
+}
+
+DiffusionFluxEvaluator::Array_t const &
+DiffusionFluxEvaluator::correctionY() const {
+    return ty_;
+}
+
+DiffusionFluxEvaluator::Array_t const &
+DiffusionFluxEvaluator::interpolation() const {
+    return interpolation_;
+}
@@ -0,0 +1,103 @@
+/*
+ * Name  : DiffusionFluxEvaluator
+ * Path  :
+ * Use   : Flux evaluator for the diffusion term \gamma \grad \phi of one
+ *         variable, see ComputationalMeshBuilder::addComputationalVariable.
+ *         The face vector S (normal with the length of the face, pointing
+ *         away from the first cell of the face) is split into E along
+ *         d, the line between the cell centroids (boundary faces: cell
+ *         centroid -> face centroid), and the rest T = S - E.
+ *         The part along E is implicit, \gamma |E| / |d| (\phi_N - \phi_P),
+ *         the cross-diffusion \gamma T . (\grad \phi)_f has to be added
+ *         explicitly (deferred correction). Versteeg, Malalasekera,
+ *         p. 319 ff.; Jasak (1996):
+ *         - NONE:                  E = S, T = 0, i.e. the mesh is assumed
+ *                                  to be orthogonal (as Main.cpp)
+ *         - MINIMUM_CORRECTION:    E = (d . S) / (d . d) d
+ *         - ORTHOGONAL_CORRECTION: E = |S| / |d| d
+ *         - OVER_RELAXED:          E = (S . S) / (d . S) d
+ *         All weights are computed once from the geometric mesh, by
+ *         ComputationalFace::index(), i.e. the evaluation per face is
+ *         only a lookup.
+ *         Dirichlet boundary faces use the half-cell approximation,
+ *         the value of a von Neumann boundary condition is the flux.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include "ComputationalCell.h"
+#include "ComputationalFace.h"
+
+#include "FiniteVolume2DLib/MeshGeometry.h"
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+
+class Mesh;
+class IComputationalGridAccessor;
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2D DiffusionFluxEvaluator {
+public:
+    typedef std::vector<double> Array_t;
+
+    enum Correction {NONE, MINIMUM_CORRECTION, ORTHOGONAL_CORRECTION, OVER_RELAXED};
+
+public:
+    // mesh: the geometric mesh the computational mesh is built from
+    DiffusionFluxEvaluator(Mesh const & mesh, std::string const & var_name, double gamma = 1.0, Correction correction = OVER_RELAXED);
+
+    // see ComputationalMeshBuilder::addComputationalVariable
+    bool                          operator()(IComputationalGridAccessor const & cgrid, ComputationalCell::Ptr const & ccell, ComputationalFace::Ptr const & cface) const;
+
+    /* Sums the face fluxes into the cell molecule of the variable,
+     * see ComputationalMeshBuilder::addEvaluateCellMolecules.
+     */
+    bool                          evaluateCell(ComputationalCell::Ptr const & ccell) const;
+
+    std::string const &           getVariableName() const;
+    double                        getDiffusionCoefficient() const;
+    Correction                    getCorrection() const;
+    std::size_t                   getNumberOfFaces() const;
+
+    /* Per face (ComputationalFace::index()), oriented from the first
+     * cell of faceCells().
+     */
+    MeshGeometry::Index_t const & faceCells() const;
+    Array_t const &               coefficient() const;
+    Array_t const &               distance() const;
+    Array_t const &               correctionX() const;
+    Array_t const &               correctionY() const;
+
+    // weight of the first cell in the value at the face
+    Array_t const &               interpolation() const;
+
+private:
+    std::string           var_name_;
+    double                gamma_;
+    Correction            correction_;
+
+    MeshGeometry::Index_t face_cells_;
+
+    // \gamma |E| / |d|
+    Array_t               coefficient_;
+
+    // |d|
+    Array_t               distance_;
+
+    // T
+    Array_t               tx_;
+    Array_t               ty_;
+
+    Array_t               interpolation_;
+};
+
+#pragma warning(default:4251)
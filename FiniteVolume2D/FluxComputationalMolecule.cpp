@@ -27,6 +27,12 @@ FluxComputationalMolecule::addMolecule(ComputationalMolecule & in) const {
     return ComputationalMoleculeImpl::addMolecule(in);
 }
 
+void
+FluxComputationalMolecule::clear() {
+    ComputationalMoleculeImpl::clear();
+    ccell_.reset();
+}
+
 void
 FluxComputationalMolecule::negate() {
     ComputationalMoleculeImpl::negate();
@@ -35,6 +35,9 @@ public:
 
     bool                                       addMolecule(ComputationalMolecule & in) const;
 
+    // also forgets the cell the flux was evaluated with
+    void                                       clear();
+
 private:
     void negate();
 
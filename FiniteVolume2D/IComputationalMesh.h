@@ -13,6 +13,8 @@
 #include "FiniteVolume2DLib/IGeometricEntity.h"
 #include "FiniteVolume2DLib/Thread.hpp"
 
+#include <vector>
+
 #include <boost/cstdint.hpp>
 
 
@@ -28,4 +30,6 @@ public:
     virtual ComputationalVariableManager const & getComputationalVariableManager() const = 0;
     virtual size_t                               getCellIndex(ComputationalCell::Ptr const & ccell) const = 0;
     virtual bool                                 setSolution(boost::uint64_t cell_index, boost::uint64_t cvar_index, double value) const = 0;
+    virtual std::vector<size_t>                  reevaluate(std::vector<ComputationalFace::Ptr> const & cfaces,
+                                                            std::vector<ComputationalCell::Ptr> const & ccells) const = 0;
 };
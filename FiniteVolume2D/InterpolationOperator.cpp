@@ -0,0 +1,192 @@
+#include "InterpolationOperator.h"
+
+#include "FiniteVolume2DLib/MeshGeometry.h"
+#include "FiniteVolume2DLib/ParallelFor.hpp"
+#include "FiniteVolume2DLib/Util.h"
+
+#include <boost/format.hpp>
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace {
+    typedef MeshGeometry::Index_t Cells_t;
+
+    void
+    inverseDistanceWeights(double x, double y, Cells_t const & cells, MeshGeometry const & geometry, std::vector<double> & weights) {
+        MeshGeometry::Array_t const & ccx = geometry.cellCentroidX();
+        MeshGeometry::Array_t const & ccy = geometry.cellCentroidY();
+
+        weights.assign(cells.size(), 0.0);
+
+        double sum = 0.0;
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            double dist = std::sqrt((ccx[cells[i]] - x) * (ccx[cells[i]] - x) + (ccy[cells[i]] - y) * (ccy[cells[i]] - y));
+
+            // the point is the centroid
+            if (dist == 0.0) {
+                weights.assign(cells.size(), 0.0);
+                weights[i] = 1.0;
+                return;
+            }
+
+            weights[i] = 1.0 / dist;
+            sum += weights[i];
+        }
+
+        std::for_each(weights.begin(), weights.end(), [sum](double & w) { w /= sum; });
+    }
+
+    // false if the cells do not determine the weights
+    bool
+    pseudoLaplacianWeights(double x, double y, Cells_t const & cells, MeshGeometry const & geometry, std::vector<double> & weights) {
+        MeshGeometry::Array_t const & ccx = geometry.cellCentroidX();
+        MeshGeometry::Array_t const & ccy = geometry.cellCentroidY();
+
+        double rx = 0.0, ry = 0.0, ixx = 0.0, iyy = 0.0, ixy = 0.0;
+
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            double dx = ccx[cells[i]] - x;
+            double dy = ccy[cells[i]] - y;
+
+            rx  += dx;
+            ry  += dy;
+            ixx += dx * dx;
+            iyy += dy * dy;
+            ixy += dx * dy;
+        }
+
+        double det = ixx * iyy - ixy * ixy;
+        if (!(det > 1E-12 * (ixx + iyy) * (ixx + iyy)))
+            return false;
+
+        double lambda_x = (ixy * ry - iyy * rx) / det;
+        double lambda_y = (ixy * rx - ixx * ry) / det;
+
+        weights.resize(cells.size());
+
+        double sum = 0.0;
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            weights[i] = 1.0 + lambda_x * (ccx[cells[i]] - x) + lambda_y * (ccy[cells[i]] - y);
+            sum += weights[i];
+        }
+
+        if (!(std::fabs(sum) > 1E-12))
+            return false;
+
+        std::for_each(weights.begin(), weights.end(), [sum](double & w) { w /= sum; });
+
+        return true;
+    }
+
+}
+
+InterpolationOperator::InterpolationOperator(MeshGeometry const & geometry, Location location, Weighting weighting, unsigned int nthreads)
+    :
+    location_(location),
+    weighting_(weighting),
+    nthreads_(ParallelFor::numberOfThreads(nthreads)),
+    nrows_(location == NODE ? geometry.getNumberOfNodes() : geometry.getNumberOfFaces()),
+    ncells_(geometry.getNumberOfCells()),
+    m_(new CSparseMatrixImpl(geometry.getNumberOfCells())) {
+
+    MeshGeometry::Index_t const & cell_start = geometry.cellStart();
+    MeshGeometry::Index_t const & cell_nodes = geometry.cellNodes();
+    MeshGeometry::Index_t const & face_nodes = geometry.faceNodes();
+    MeshGeometry::Index_t const & face_cells = geometry.faceCells();
+
+    // cells per node
+    std::vector<Cells_t> node_cells(geometry.getNumberOfNodes());
+    for (std::size_t cell = 0; cell < ncells_; ++cell)
+        for (boost::uint64_t i = cell_start[cell]; i < cell_start[cell + 1]; ++i)
+            node_cells[cell_nodes[i]].push_back(cell);
+
+    Cells_t cells;
+    std::vector<double> weights;
+
+    for (std::size_t row = 0; row < nrows_; ++row) {
+        double x, y;
+
+        cells.clear();
+
+        if (location_ == NODE) {
+            x = geometry.nodeX()[row];
+            y = geometry.nodeY()[row];
+
+            cells = node_cells[row];
+        }
+        else {
+            x = geometry.faceCentroidX()[row];
+            y = geometry.faceCentroidY()[row];
+
+            if (weighting_ == INVERSE_DISTANCE) {
+                cells.push_back(face_cells[2 * row]);
+                if (face_cells[2 * row + 1] != MeshGeometry::NO_CELL)
+                    cells.push_back(face_cells[2 * row + 1]);
+            }
+            else {
+                Cells_t const & cells0 = node_cells[face_nodes[2 * row]];
+                Cells_t const & cells1 = node_cells[face_nodes[2 * row + 1]];
+
+                cells = cells0;
+                cells.insert(cells.end(), cells1.begin(), cells1.end());
+
+                std::sort(cells.begin(), cells.end());
+                cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+            }
+        }
+
+        // the compressed storage has no empty rows
+        if (cells.empty()) {
+            boost::format format = boost::format("InterpolationOperator: No cell at %1% %2%!\n") % (location_ == NODE ? "node" : "face") % row;
+            Util::error(format.str());
+            throw std::logic_error(format.str().c_str());
+        }
+
+        if (weighting_ != PSEUDO_LAPLACIAN || !pseudoLaplacianWeights(x, y, cells, geometry, weights))
+            inverseDistanceWeights(x, y, cells, geometry, weights);
+
+        for (std::size_t i = 0; i < cells.size(); ++i)
+            (*m_)(row, cells[i]) = weights[i];
+    }
+
+    m_->finalize();
+}
+
+InterpolationOperator::Location
+InterpolationOperator::getLocation() const {
+    return location_;
+}
+
+InterpolationOperator::Weighting
+InterpolationOperator::getWeighting() const {
+    return weighting_;
+}
+
+std::size_t
+InterpolationOperator::getNumberOfRows() const {
+    return nrows_;
+}
+
+std::size_t
+InterpolationOperator::getNumberOfCells() const {
+    return ncells_;
+}
+
+CSparseMatrixImpl const &
+InterpolationOperator::getMatrix() const {
+    return *m_;
+}
+
+void
+InterpolationOperator::apply(Array_t const & cell_values, Array_t & values) const {
+    if (cell_values.size() != ncells_)
+        throw std::out_of_range("InterpolationOperator::apply(): Wrong number of cell values");
+
+    values.resize(nrows_);
+
+    CSparseMatrixImpl const & m = *m_;
+    ParallelFor::forEachChunk(nrows_, nthreads_, [&](std::size_t begin, std::size_t end) { m.multiply(cell_values, values, begin, end); });
+}
@@ -0,0 +1,78 @@
+/*
+ * Name  : InterpolationOperator
+ * Path  :
+ * Use   : Interpolation of cell values to the nodes or the faces of
+ *         a whole mesh as one sparse matrix (one row per node or face,
+ *         one column per cell), built once from a MeshGeometry.
+ *         Interpolating a field is then a single matrix vector product,
+ *         split between several threads, instead of evaluating a node
+ *         molecule (see addPassiveComputationalNodeVariable) per node.
+ *         Weights, normalized to a sum of one:
+ *         - INVERSE_DISTANCE: 1 / |x_c - x|,
+ *         - PSEUDO_LAPLACIAN: 1 + \lambda . (x_c - x), with \lambda such
+ *           that the weighted sum of x_c - x vanishes, i.e. linear
+ *           fields are reproduced exactly; Holmes, Connell (1989).
+ *           Falls back to the inverse distance if the cells do not
+ *           span the plane, e.g. at a corner node with a single cell.
+ *         Nodes use the cells sharing the node. Faces use their one or
+ *         two cells with INVERSE_DISTANCE and all cells sharing a node
+ *         of the face with PSEUDO_LAPLACIAN.
+ *         Nodes, faces and cells are in the order of MeshGeometry.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include "Solver/CSparseMatrixImpl.h"
+
+#include <memory>
+#include <vector>
+
+
+class MeshGeometry;
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2D InterpolationOperator {
+public:
+    typedef std::vector<double> Array_t;
+
+    enum Location {NODE, FACE};
+    enum Weighting {INVERSE_DISTANCE, PSEUDO_LAPLACIAN};
+
+public:
+    // nthreads = 0: one thread per core
+    InterpolationOperator(MeshGeometry const & geometry, Location location, Weighting weighting = PSEUDO_LAPLACIAN, unsigned int nthreads = 0);
+
+    Location                  getLocation() const;
+    Weighting                 getWeighting() const;
+
+    // number of nodes or faces, and of cells
+    std::size_t               getNumberOfRows() const;
+    std::size_t               getNumberOfCells() const;
+
+    CSparseMatrixImpl const & getMatrix() const;
+
+    // values = M cell_values
+    void                      apply(Array_t const & cell_values, Array_t & values) const;
+
+private:
+    InterpolationOperator(InterpolationOperator const & in);
+    InterpolationOperator & operator=(InterpolationOperator const & in);
+
+private:
+    Location                           location_;
+    Weighting                          weighting_;
+    unsigned int                       nthreads_;
+
+    std::size_t                        nrows_;
+    std::size_t                        ncells_;
+
+    std::unique_ptr<CSparseMatrixImpl> m_;
+};
+
+#pragma warning(default:4251)
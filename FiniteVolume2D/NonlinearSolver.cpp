@@ -0,0 +1,193 @@
+#include "NonlinearSolver.h"
+
+#include "FiniteVolume2D/ComputationalMesh.h"
+#include "FiniteVolume2D/ComputationalVariableManager.h"
+#include "FiniteVolume2D/IComputationalGridAccessor.h"
+
+#include "FiniteVolume2DLib/Thread.hpp"
+#include "FiniteVolume2DLib/Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+NonlinearSolver::Control::Control()
+    :
+    eisenstat_walker(true),
+    eta_initial(0.5),
+    eta_max(0.9),
+    gamma(0.9),
+    alpha(2.0) {}
+
+NonlinearSolver::NonlinearSolver(ComputationalMesh const & cmesh, CellMoleculeEvaluator_t const & cell_molecule_evaluator)
+    :
+    cmesh_(cmesh),
+    cell_molecule_evaluator_(cell_molecule_evaluator),
+    helper_(cmesh) {}
+
+void
+NonlinearSolver::setControl(Control const & control) {
+    control_ = control;
+}
+
+NonlinearSolver::Control const &
+NonlinearSolver::getControl() const {
+    return control_;
+}
+
+void
+NonlinearSolver::setSolverControl(LinearSolver::Control const & control) {
+    linear_control_ = control;
+}
+
+NonlinearSolver::Statistics const &
+NonlinearSolver::getStatistics() const {
+    return stats_;
+}
+
+void
+NonlinearSolver::evaluate() {
+    FV2D_PROFILE_SCOPE("NonlinearSolver::evaluate");
+
+    ComputationalVariableManager const & cvar_mgr = cmesh_.getComputationalVariableManager();
+
+    /* The flux evaluators only evaluate empty face molecules and the
+     * cell evaluators accumulate, hence start from empty molecules.
+     * The solution values of the cell molecules are kept.
+     */
+    IGeometricEntity::Entity_t const entity_types[] = { IGeometricEntity::INTERIOR, IGeometricEntity::BOUNDARY };
+
+    for (int k = 0; k < 2; ++k) {
+        Thread<ComputationalFace> const & face_thread = cmesh_.getFaceThread(entity_types[k]);
+
+        std::for_each(face_thread.begin(), face_thread.end(), [&cvar_mgr](ComputationalFace::Ptr const & cface) {
+            ComputationalVariableManager::Iterator_t it     = cvar_mgr.begin();
+            ComputationalVariableManager::Iterator_t it_end = cvar_mgr.end();
+
+            for (; it != it_end; ++it)
+                cface->getComputationalMolecule(it->name).clear();
+        });
+    }
+
+    Thread<ComputationalCell> const & cell_thread = cmesh_.getCellThread();
+
+    std::for_each(cell_thread.begin(), cell_thread.end(), [&cvar_mgr](ComputationalCell::Ptr const & ccell) {
+        ComputationalVariableManager::Iterator_t it     = cvar_mgr.begin();
+        ComputationalVariableManager::Iterator_t it_end = cvar_mgr.end();
+
+        for (; it != it_end; ++it)
+            ccell->getComputationalMolecule(it->name).clear();
+    });
+
+
+    // as in ComputationalMeshBuilder::build
+    IComputationalGridAccessor grid_accessor(cmesh_.getMeshConnectivity(), cmesh_.getMapper());
+
+    for (Thread<ComputationalCell>::size_type i = 0; i < cell_thread.size(); ++i) {
+        ComputationalCell::Ptr const & ccell = cell_thread.getEntityAt(i);
+
+        EntityCollection<ComputationalFace> const & cfaces = ccell->getComputationalFaces();
+        std::for_each(cfaces.begin(), cfaces.end(), [&](ComputationalFace::Ptr const & cface) {
+            ComputationalVariableManager::Iterator_t it     = cvar_mgr.begin();
+            ComputationalVariableManager::Iterator_t it_end = cvar_mgr.end();
+
+            for (; it != it_end; ++it)
+                (it->flux_eval)(grid_accessor, ccell, cface);
+        });
+    }
+
+    for (Thread<ComputationalCell>::size_type i = 0; i < cell_thread.size(); ++i)
+        cell_molecule_evaluator_(cell_thread.getEntityAt(i));
+}
+
+double
+NonlinearSolver::residualNorm(LinearSolver::RHS_t const & phi) const {
+    LinearSolver::RHS_t const & b = helper_.getRHS();
+
+    LinearSolver::RHS_t y(b.size());
+    helper_.getSparseMatrix().multiply(phi, y);
+
+    double norm = 0.0;
+    for (LinearSolver::RHS_t::size_type i = 0; i < b.size(); ++i)
+        norm += (b[i] - y[i]) * (b[i] - y[i]);
+
+    return std::sqrt(norm);
+}
+
+bool
+NonlinearSolver::solve() {
+    FV2D_PROFILE_SCOPE("NonlinearSolver::solve");
+
+    stats_ = Statistics();
+
+    LinearSolver::RHS_t phi;
+    LinearSolver::RHS_t phi_new;
+    helper_.gatherSolutionFromCMesh(phi);
+
+    double eta = control_.eta_initial;
+    double residual_old = 0.0;
+    double update = 0.0;
+
+    for (;;) {
+        // coefficients at the current solution
+        evaluate();
+        helper_.updateMatrix();
+
+        double residual = residualNorm(phi);
+
+        FV2D_PROFILE_SAMPLE("nonlinear/residual", residual);
+
+        if (stop(control_, stats_, residual, update))
+            break;
+
+
+        if (control_.eisenstat_walker && stats_.iterations > 0) {
+            double eta_old = eta;
+            eta = control_.gamma * std::pow(residual / residual_old, control_.alpha);
+
+            // do not tighten too fast while eta is large
+            double eta_safe = control_.gamma * std::pow(eta_old, control_.alpha);
+            if (eta_safe > 0.1)
+                eta = std::max(eta, eta_safe);
+
+            // no need to solve beyond the nonlinear tolerance
+            double target = std::max(control_.absolute_tolerance, control_.relative_tolerance * stats_.initial_residual);
+            if (target > 0)
+                eta = std::max(eta, 0.5 * target / residual);
+
+            eta = std::min(eta, control_.eta_max);
+        }
+
+
+        // inexact linear solve, warm started from phi
+        LinearSolver::Control linear_control = linear_control_;
+        linear_control.absolute_tolerance = eta * residual;
+        linear_control.relative_tolerance = 0;
+        helper_.setSolverControl(linear_control);
+
+        bool success = helper_.solveSystem();
+
+        stats_.linear_iterations += helper_.getSolverStatistics().iterations;
+        stats_.eta = eta;
+
+        if (!success) {
+            stats_.reason = LINEAR_SOLVER_FAILED;
+            break;
+        }
+
+        helper_.gatherSolutionFromCMesh(phi_new);
+
+        update = 0.0;
+        for (LinearSolver::RHS_t::size_type i = 0; i < phi.size(); ++i)
+            update = std::max(update, std::fabs(phi_new[i] - phi[i]));
+
+        stats_.update_norm = update;
+
+        phi.swap(phi_new);
+        residual_old = residual;
+
+        stats_.iterations++;
+    }
+
+    return stats_.converged();
+}
@@ -0,0 +1,98 @@
+/*
+ * Name  : NonlinearSolver
+ * Path  :
+ * Use   : Picard iteration for solution dependent coefficients,
+ *         e.g. a temperature dependent conductivity.
+ *         Each iteration re-evaluates the face fluxes (through the
+ *         flux evaluators of the computational variables) and the
+ *         cell molecules from the current solution, writes them into
+ *         the existing sparsity pattern and solves the linear system
+ *         inexactly. The linear tolerance follows Eisenstat and
+ *         Walker (choice 2), i.e. it is tightened as the nonlinear
+ *         residual drops. The computational mesh is not rebuilt.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include "ComputationalMeshBuilder.h"
+#include "ComputationalMeshSolverHelper.h"
+#include "OuterIteration.h"
+
+#include "Solver/LinearSolver.h"
+
+
+class ComputationalMesh;
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2D NonlinearSolver : public OuterIteration {
+public:
+    typedef ComputationalMeshBuilder::CellMoleculeEvaluator_t CellMoleculeEvaluator_t;
+
+    /* The residual is the l2 norm of the nonlinear residual
+     * b(phi) - A(phi) phi.
+     */
+    struct DECL_SYMBOLS_2D Control : OuterIteration::Control {
+        Control();
+
+        /* Linear tolerance eta, i.e. the linear solver stops once its
+         * residual drops below eta * (nonlinear residual):
+         *   eta_0 = eta_initial,
+         *   eta_k = gamma * (r_k / r_{k-1})^alpha, limited by eta_max.
+         * Without eisenstat_walker, eta_initial is used throughout.
+         */
+        bool         eisenstat_walker;
+        double       eta_initial;
+        double       eta_max;
+        double       gamma;
+        double       alpha;
+    };
+
+    struct Statistics : OuterIteration::Statistics {
+        Statistics() : eta(0) {}
+
+        // of the last linear solve
+        double       eta;
+    };
+
+public:
+    NonlinearSolver(ComputationalMesh const & cmesh, CellMoleculeEvaluator_t const & cell_molecule_evaluator);
+
+    void                             setControl(Control const & control);
+    Control const &                  getControl() const;
+
+    // for the linear solves; the tolerances are set per iteration
+    void                             setSolverControl(LinearSolver::Control const & control);
+
+    Statistics const &               getStatistics() const;
+
+    // starting from the values in the cell molecules
+    bool                             solve();
+
+    // re-evaluate all face fluxes and cell molecules from the current solution
+    void                             evaluate();
+
+private:
+    NonlinearSolver(NonlinearSolver const & in);
+    NonlinearSolver & operator=(NonlinearSolver const & in);
+
+    double                           residualNorm(LinearSolver::RHS_t const & phi) const;
+
+private:
+    ComputationalMesh const &        cmesh_;
+    CellMoleculeEvaluator_t          cell_molecule_evaluator_;
+
+    ComputationalMeshSolverHelper    helper_;
+
+    Control                          control_;
+    LinearSolver::Control            linear_control_;
+
+    Statistics                       stats_;
+};
+
+#pragma warning(default:4251)
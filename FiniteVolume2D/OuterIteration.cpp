@@ -0,0 +1,46 @@
+#include "OuterIteration.h"
+
+
+OuterIteration::Control::Control()
+    :
+    max_iterations(50),
+    absolute_tolerance(1E-10),
+    relative_tolerance(1E-8),
+    update_tolerance(0) {}
+
+bool
+OuterIteration::stop(Control const & control, Statistics & stats, double residual, double update) {
+    if (stats.iterations == 0)
+        stats.initial_residual = residual;
+
+    stats.residual_norm = residual;
+
+    if (control.absolute_tolerance > 0 && residual <= control.absolute_tolerance)
+        stats.reason = CONVERGED_ABSOLUTE;
+    else if (control.relative_tolerance > 0 && residual <= control.relative_tolerance * stats.initial_residual)
+        stats.reason = CONVERGED_RELATIVE;
+    else if (stats.iterations > 0 && control.update_tolerance > 0 && update <= control.update_tolerance)
+        stats.reason = CONVERGED_UPDATE;
+    else if (control.monitor && !control.monitor(stats.iterations, residual, update))
+        stats.reason = ABORTED;
+    else if (stats.iterations >= control.max_iterations)
+        stats.reason = MAX_ITERATIONS;
+    else
+        return false;
+
+    return true;
+}
+
+char const *
+OuterIteration::toString(Reason reason) {
+    switch (reason) {
+    case NOT_RUN:              return "not run";
+    case CONVERGED_ABSOLUTE:   return "converged (absolute residual)";
+    case CONVERGED_RELATIVE:   return "converged (relative residual)";
+    case CONVERGED_UPDATE:     return "converged (update)";
+    case MAX_ITERATIONS:       return "maximum number of iterations reached";
+    case LINEAR_SOLVER_FAILED: return "linear solver failed";
+    case ABORTED:              return "aborted by monitor";
+    }
+    return "unknown";
+}
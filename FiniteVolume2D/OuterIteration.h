@@ -0,0 +1,81 @@
+/*
+ * Name  : OuterIteration
+ * Path  :
+ * Use   : Termination criteria, statistics and reasons for stopping
+ *         shared by the iterations around the linear solver, see
+ *         NonlinearSolver and DeferredCorrectionSolver. The residual
+ *         is defined by the derived solver.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include <functional>
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2D OuterIteration {
+public:
+    // A tolerance <= 0 disables the corresponding criterion.
+    struct DECL_SYMBOLS_2D Control {
+        // called before each linear solve; return false to abort
+        typedef std::function<bool (unsigned int iteration, double residual_norm, double update_norm)> Monitor_t;
+
+        Control();
+
+        unsigned int max_iterations;
+
+        // l2 norm of the residual
+        double       absolute_tolerance;
+
+        // relative to the residual of the initial guess
+        double       relative_tolerance;
+
+        // max norm of the change of the solution
+        double       update_tolerance;
+
+        Monitor_t    monitor;
+    };
+
+    enum Reason {NOT_RUN, CONVERGED_ABSOLUTE, CONVERGED_RELATIVE, CONVERGED_UPDATE, MAX_ITERATIONS, LINEAR_SOLVER_FAILED, ABORTED};
+
+    struct Statistics {
+        Statistics() : iterations(0), linear_iterations(0), initial_residual(0), residual_norm(0), update_norm(0), reason(NOT_RUN) {}
+
+        bool         converged() const {
+            return reason == CONVERGED_ABSOLUTE || reason == CONVERGED_RELATIVE || reason == CONVERGED_UPDATE;
+        }
+
+        // linear solves, i.e. outer iterations
+        unsigned int iterations;
+
+        // sum over all linear solves
+        unsigned int linear_iterations;
+
+        double       initial_residual;
+        double       residual_norm;
+        double       update_norm;
+
+        Reason       reason;
+    };
+
+public:
+    static char const * toString(Reason reason);
+
+protected:
+    OuterIteration() {}
+
+    /* Records the residual of the current solution (the initial one
+     * at the first iteration) and checks the criteria of control:
+     * absolute, relative and update tolerance, monitor and
+     * max_iterations. Returns true and sets stats.reason if the
+     * iteration has to stop.
+     */
+    static bool         stop(Control const & control, Statistics & stats, double residual, double update);
+};
+
+#pragma warning(default:4251)
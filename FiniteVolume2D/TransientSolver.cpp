@@ -0,0 +1,373 @@
+#include "TransientSolver.h"
+
+#include "FiniteVolume2D/IComputationalMesh.h"
+#include "FiniteVolume2D/ComputationalCell.h"
+#include "FiniteVolume2D/ComputationalVariableManager.h"
+
+#include "FiniteVolume2DLib/Thread.hpp"
+#include "FiniteVolume2DLib/Util.h"
+#include "FiniteVolume2DLib/Profiler.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include <boost/format.hpp>
+
+
+TransientSolver::AdaptiveControl::AdaptiveControl()
+    :
+    relative_tolerance(1E-3),
+    absolute_tolerance(1E-6),
+    dt_min(1E-12),
+    dt_max(0),
+    safety(0.9),
+    min_shrink(0.2),
+    max_growth(2.0),
+    steady_tolerance(0),
+    max_steps(0) {}
+
+TransientSolver::TransientSolver(IComputationalMesh const & cmesh, Scheme scheme)
+    :
+    cmesh_(cmesh),
+    scheme_(scheme),
+    capacity_(1.0),
+    output_interval_(0),
+    helper_(cmesh),
+    initialized_(false),
+    time_(0.0),
+    step_(0),
+    dt_old_(0.0) {}
+
+TransientSolver::Scheme
+TransientSolver::getScheme() const {
+    return scheme_;
+}
+
+void
+TransientSolver::setCapacity(double capacity) {
+    capacity_ = capacity;
+
+    // the mass term has to be recomputed
+    initialized_ = false;
+}
+
+void
+TransientSolver::setOutput(OutputCallback_t const & output, unsigned int output_interval) {
+    output_ = output;
+    output_interval_ = output_interval;
+}
+
+void
+TransientSolver::setSolverControl(LinearSolver::Control const & control) {
+    helper_.setSolverControl(control);
+}
+
+LinearSolver::Statistics const &
+TransientSolver::getSolverStatistics() const {
+    return helper_.getSolverStatistics();
+}
+
+void
+TransientSolver::setTime(double time) {
+    time_ = time;
+}
+
+double
+TransientSolver::getTime() const {
+    return time_;
+}
+
+unsigned int
+TransientSolver::getStep() const {
+    return step_;
+}
+
+void
+TransientSolver::initialize() {
+    FV2D_PROFILE_SCOPE("TransientSolver::initialize");
+
+    // the steady system, A phi = b
+    helper_.setupMatrix();
+    b_ = helper_.getRHS();
+
+    A_.reset(new CSparseMatrixImpl(helper_.getSparseMatrix()));
+
+    // Crank-Nicolson: (c V / dt + A / 2) phi^{n+1} = b + (c V / dt - A / 2) phi^n
+    if (scheme_ == CRANK_NICOLSON)
+        A_->scale(0.5);
+
+    A_->getDiagonal(diagonal_);
+
+
+    // mass term per row
+    Thread<ComputationalCell> const & cell_thread = cmesh_.getCellThread();
+    ComputationalVariableManager const & cvar_manager = cmesh_.getComputationalVariableManager();
+
+    mass_.assign(b_.size(), 0.0);
+
+    for (Thread<ComputationalCell>::size_type cell_index = 0; cell_index < cell_thread.size(); ++cell_index) {
+        double volume = std::fabs(cell_thread.getEntityAt(cell_index)->volume());
+
+        for (ComputationalVariableManager::size_type base_index = 0; base_index < cvar_manager.size(); ++base_index)
+            mass_[helper_.getRow(cell_index, short(base_index))] = capacity_ * volume;
+    }
+
+
+    // initial condition
+    if (phi_.empty())
+        helper_.gatherSolutionFromCMesh(phi_);
+
+    initialized_ = true;
+}
+
+bool
+TransientSolver::solveStep(Scheme scheme, double dt, LinearSolver::RHS_t & phi) {
+    LinearSolver::RHS_t::size_type const n = b_.size();
+
+    // coefficient of c V / dt phi^{n+1}
+    double c0 = 1.0;
+
+    LinearSolver::RHS_t rhs(n);
+
+    if (scheme == BDF2 && dt_old_ > 0) {
+        /* variable step BDF2 with omega = dt / dt_old:
+         * (1 + 2 omega) / (1 + omega) phi^{n+1} - (1 + omega) phi^n + omega^2 / (1 + omega) phi^{n-1}
+         */
+        double omega = dt / dt_old_;
+        c0 = (1.0 + 2.0 * omega) / (1.0 + omega);
+
+        double c1 = 1.0 + omega;
+        double c2 = omega * omega / (1.0 + omega);
+
+        for (LinearSolver::RHS_t::size_type i = 0; i < n; ++i)
+            rhs[i] = b_[i] + mass_[i] / dt * (c1 * phi_[i] - c2 * phi_old_[i]);
+    }
+    else if (scheme != CRANK_NICOLSON) {
+        // backward Euler, also the first BDF2 step
+        for (LinearSolver::RHS_t::size_type i = 0; i < n; ++i)
+            rhs[i] = b_[i] + mass_[i] / dt * phi_[i];
+    }
+
+
+    // only the diagonal of the system matrix changes with dt
+    LinearSolver::RHS_t diagonal(n);
+    for (LinearSolver::RHS_t::size_type i = 0; i < n; ++i)
+        diagonal[i] = diagonal_[i] + c0 * mass_[i] / dt;
+
+    A_->setDiagonal(diagonal);
+
+
+    if (scheme == CRANK_NICOLSON) {
+        /* With y = (c V / dt + A / 2) phi^n, the r.h.s.
+         * b + (c V / dt - A / 2) phi^n is b + 2 c V / dt phi^n - y.
+         */
+        LinearSolver::RHS_t y(n);
+        A_->multiply(phi_, y);
+
+        for (LinearSolver::RHS_t::size_type i = 0; i < n; ++i)
+            rhs[i] = b_[i] + 2.0 * mass_[i] / dt * phi_[i] - y[i];
+    }
+
+
+    if (!helper_.solveSystem(*A_, rhs)) {
+        // keep the old time level
+        helper_.insertSolutionIntoCMesh(phi_);
+        return false;
+    }
+
+    helper_.gatherSolutionFromCMesh(phi);
+
+    return true;
+}
+
+void
+TransientSolver::accept(double dt, LinearSolver::RHS_t & phi) {
+    phi_old_.swap(phi_);
+    phi_.swap(phi);
+
+    helper_.insertSolutionIntoCMesh(phi_);
+
+    dt_old_ = dt;
+    time_  += dt;
+    ++step_;
+
+    if (output_ && output_interval_ > 0 && step_ % output_interval_ == 0)
+        output_(step_, time_, cmesh_);
+}
+
+bool
+TransientSolver::step(double dt) {
+    FV2D_PROFILE_SCOPE("TransientSolver::step");
+
+    if (!(dt > 0)) {
+        boost::format format = boost::format("TransientSolver::step: Invalid time step %1%!\n") % dt;
+        return Util::error(format.str());
+    }
+
+    if (!initialized_)
+        initialize();
+
+    LinearSolver::RHS_t phi;
+
+    if (!solveStep(scheme_, dt, phi)) {
+        boost::format format = boost::format("TransientSolver::step: Linear solver failed at time %1% (%2%)!\n")
+            % (time_ + dt) % LinearSolver::toString(helper_.getSolverStatistics().reason);
+        return Util::error(format.str());
+    }
+
+    accept(dt, phi);
+
+    return true;
+}
+
+bool
+TransientSolver::run(double end_time, double dt) {
+    if (!(dt > 0)) {
+        boost::format format = boost::format("TransientSolver::run: Invalid time step %1%!\n") % dt;
+        return Util::error(format.str());
+    }
+
+    while (time_ < end_time) {
+        double h = dt;
+
+        // do not overshoot and avoid a tiny last step
+        if (time_ + h > end_time || end_time - (time_ + h) < 1E-10 * dt)
+            h = end_time - time_;
+
+        if (!step(h))
+            return false;
+    }
+
+    return true;
+}
+
+bool
+TransientSolver::runAdaptive(double end_time, double dt, AdaptiveControl const & control, AdaptiveStatistics & stats) {
+    FV2D_PROFILE_SCOPE("TransientSolver::runAdaptive");
+
+    stats = AdaptiveStatistics();
+
+    if (scheme_ == CRANK_NICOLSON) {
+        boost::format format = boost::format("TransientSolver::runAdaptive: Not available for Crank-Nicolson!\n");
+        return Util::error(format.str());
+    }
+
+    if (!(dt > 0)) {
+        boost::format format = boost::format("TransientSolver::runAdaptive: Invalid time step %1%!\n") % dt;
+        return Util::error(format.str());
+    }
+
+    if (!initialized_)
+        initialize();
+
+    LinearSolver::RHS_t::size_type const n = b_.size();
+
+    LinearSolver::RHS_t phi_be;
+    LinearSolver::RHS_t phi_bdf2;
+    LinearSolver::RHS_t estimate(n);
+
+    while (time_ < end_time) {
+        if (control.max_steps > 0 && stats.accepted >= control.max_steps) {
+            boost::format format = boost::format("TransientSolver::runAdaptive: Maximum number of steps %1% reached at time %2%!\n")
+                % control.max_steps % time_;
+            return Util::error(format.str());
+        }
+
+        if (control.dt_max > 0)
+            dt = std::min(dt, control.dt_max);
+
+        double h = dt;
+
+        // do not overshoot and avoid a tiny last step
+        if (time_ + h > end_time || end_time - (time_ + h) < 1E-10 * dt)
+            h = end_time - time_;
+
+
+        // backward Euler and the embedded estimate of its local error
+        double error = std::numeric_limits<double>::max();
+        bool has_bdf2 = false;
+
+        bool success = solveStep(BACKWARD_EULER, h, phi_be);
+        stats.solves++;
+
+        if (success && dt_old_ > 0) {
+            // BDF2 solution of the same step, warm started from phi_be
+            success = solveStep(BDF2, h, phi_bdf2);
+            stats.solves++;
+
+            has_bdf2 = success;
+
+            if (success)
+                for (LinearSolver::RHS_t::size_type i = 0; i < n; ++i)
+                    estimate[i] = phi_be[i] - phi_bdf2[i];
+        }
+        else if (success) {
+            /* No history, compare with the explicit Euler predictor
+             * phi + h (b - A phi) / (c V). The local errors of both are
+             * equal up to the sign.
+             */
+            A_->setDiagonal(diagonal_);
+
+            LinearSolver::RHS_t y(n);
+            A_->multiply(phi_, y);
+
+            for (LinearSolver::RHS_t::size_type i = 0; i < n; ++i) {
+                double phi_fe = mass_[i] > 0 ? phi_[i] + h * (b_[i] - y[i]) / mass_[i] : phi_be[i];
+                estimate[i] = 0.5 * (phi_be[i] - phi_fe);
+            }
+        }
+
+        if (success) {
+            error = 0.0;
+
+            LinearSolver::RHS_t const & phi_new = has_bdf2 ? phi_bdf2 : phi_be;
+            for (LinearSolver::RHS_t::size_type i = 0; i < n; ++i)
+                error = std::max(error, std::fabs(estimate[i]) / (control.absolute_tolerance + control.relative_tolerance * std::fabs(phi_new[i])));
+        }
+
+        FV2D_PROFILE_SAMPLE("transient/error", error);
+
+
+        /* first order estimate, i.e. error ~ h^2, also for BDF2,
+         * whose own error is smaller (conservative)
+         */
+        double factor = error > 0 ? control.safety / std::sqrt(error) : control.max_growth;
+        factor = std::max(control.min_shrink, std::min(control.max_growth, factor));
+
+        if (error <= 1.0) {
+            double change = 0.0;
+
+            LinearSolver::RHS_t & phi_new = (scheme_ == BDF2 && has_bdf2) ? phi_bdf2 : phi_be;
+            for (LinearSolver::RHS_t::size_type i = 0; i < n; ++i)
+                change = std::max(change, std::fabs(phi_new[i] - phi_[i]));
+
+            accept(h, phi_new);
+            stats.accepted++;
+
+            if (control.steady_tolerance > 0 && change / h < control.steady_tolerance)
+                stats.steady = true;
+        }
+        else {
+            // the mesh holds the rejected solution
+            helper_.insertSolutionIntoCMesh(phi_);
+            stats.rejected++;
+
+            if (h <= control.dt_min) {
+                boost::format format = boost::format("TransientSolver::runAdaptive: Time step %1% at time %2% below minimum %3%!\n")
+                    % h % time_ % control.dt_min;
+                return Util::error(format.str());
+            }
+        }
+
+        dt = std::max(control.dt_min, h * factor);
+        stats.dt = dt;
+
+        FV2D_PROFILE_SAMPLE("transient/dt", h);
+
+        if (stats.steady)
+            break;
+    }
+
+    return true;
+}
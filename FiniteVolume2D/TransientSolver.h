@@ -0,0 +1,171 @@
+/*
+ * Name  : TransientSolver
+ * Path  :
+ * Use   : Implicit time integration of
+ *           c V d(phi)/dt + A phi = b,
+ *         where A phi = b is the steady system assembled from the
+ *         cell molecules, V the cell volume and c a capacity.
+ *         Supported schemes are backward Euler, Crank-Nicolson and
+ *         (variable step) BDF2, the latter starting with a backward
+ *         Euler step.
+ *         The steady system is assembled once. Each step only the
+ *         diagonal (mass term) and the r.h.s. are updated. The
+ *         initial condition is taken from the cell molecule values.
+ *         runAdaptive() controls the step size with an embedded
+ *         estimate of the local error and optionally stops once a
+ *         steady state is reached.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include "ComputationalMeshSolverHelper.h"
+
+#include "Solver/CSparseMatrixImpl.h"
+#include "Solver/LinearSolver.h"
+
+#include <functional>
+#include <memory>
+
+
+class IComputationalMesh;
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2D TransientSolver {
+public:
+    enum Scheme {BACKWARD_EULER, CRANK_NICOLSON, BDF2};
+
+    // called after every output_interval steps with the solution in the mesh
+    typedef std::function<void (unsigned int step, double time, IComputationalMesh const & cmesh)> OutputCallback_t;
+
+    /* Step size control of runAdaptive(). A step is accepted if
+     *   max_i |e_i| / (absolute_tolerance + relative_tolerance * |phi_i|) <= 1,
+     * where e is the estimated local error of the backward Euler
+     * step, i.e. the difference to the BDF2 solution of the same step
+     * (to the explicit Euler predictor for the first step).
+     * With BDF2 the more accurate BDF2 solution is kept, but the step
+     * size is still controlled by the first order estimate, i.e. the
+     * control is conservative: for small steps the local error of the
+     * kept solution is smaller than the estimate and the steps are
+     * smaller than a second order control would choose.
+     */
+    struct DECL_SYMBOLS_2D AdaptiveControl {
+        AdaptiveControl();
+
+        double       relative_tolerance;
+        double       absolute_tolerance;
+
+        // limits of the step size, dt_max <= 0: no upper limit
+        double       dt_min;
+        double       dt_max;
+
+        // dt_new = dt * safety / sqrt(error), limited to [min_shrink, max_growth] * dt
+        double       safety;
+        double       min_shrink;
+        double       max_growth;
+
+        /* Stop before end_time once max_i |phi_i^{n+1} - phi_i^n| / dt
+         * drops below steady_tolerance. 0 disables the check.
+         */
+        double       steady_tolerance;
+
+        // 0: no limit
+        unsigned int max_steps;
+    };
+
+    struct AdaptiveStatistics {
+        AdaptiveStatistics() : accepted(0), rejected(0), solves(0), dt(0), steady(false) {}
+
+        unsigned int accepted;
+        unsigned int rejected;
+
+        // linear systems solved, including those of rejected steps
+        unsigned int solves;
+
+        // proposed size of the next step
+        double       dt;
+
+        bool         steady;
+    };
+
+public:
+    explicit TransientSolver(IComputationalMesh const & cmesh, Scheme scheme = BACKWARD_EULER);
+
+    Scheme                           getScheme() const;
+
+    // c in c V d(phi)/dt, default 1
+    void                             setCapacity(double capacity);
+
+    // output_interval == 0: no output
+    void                             setOutput(OutputCallback_t const & output, unsigned int output_interval);
+
+    void                             setSolverControl(LinearSolver::Control const & control);
+    LinearSolver::Statistics const & getSolverStatistics() const;
+
+    void                             setTime(double time);
+    double                           getTime() const;
+    unsigned int                     getStep() const;
+
+    // advance by dt
+    bool                             step(double dt);
+
+    // advance to end_time with steps of (at most) dt
+    bool                             run(double end_time, double dt);
+
+    /* Advance to end_time (or to a steady state) starting with step dt.
+     * Not available for CRANK_NICOLSON. With BDF2 the BDF2 solution
+     * is kept, otherwise the backward Euler solution; the step size
+     * control is the same (see AdaptiveControl).
+     */
+    bool                             runAdaptive(double end_time, double dt, AdaptiveControl const & control, AdaptiveStatistics & stats);
+
+private:
+    TransientSolver(TransientSolver const & in);
+    TransientSolver & operator=(TransientSolver const & in);
+
+    void                             initialize();
+
+    // the solution at time_ + dt, the state is not changed
+    bool                             solveStep(Scheme scheme, double dt, LinearSolver::RHS_t & phi);
+
+    // phi becomes the current time level
+    void                             accept(double dt, LinearSolver::RHS_t & phi);
+
+private:
+    IComputationalMesh const &       cmesh_;
+    Scheme                           scheme_;
+    double                           capacity_;
+
+    OutputCallback_t                 output_;
+    unsigned int                     output_interval_;
+
+    ComputationalMeshSolverHelper    helper_;
+
+    // steady system and its diagonal
+    bool                             initialized_;
+    LinearSolver::RHS_t              b_;
+    LinearSolver::RHS_t              diagonal_;
+
+    // system matrix including the mass term
+    std::unique_ptr<CSparseMatrixImpl> A_;
+
+    // c * V per row
+    LinearSolver::RHS_t              mass_;
+
+    // solution at the current and at the previous time level
+    LinearSolver::RHS_t              phi_;
+    LinearSolver::RHS_t              phi_old_;
+
+    double                           time_;
+    unsigned int                     step_;
+
+    // size of the last step, 0 if there is none (BDF2 history)
+    double                           dt_old_;
+};
+
+#pragma warning(default:4251)
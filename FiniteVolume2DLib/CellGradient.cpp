@@ -0,0 +1,305 @@
+#include "CellGradient.h"
+#include "MeshGeometry.h"
+#include "ParallelFor.hpp"
+#include "InstructionSet.h"
+#include "Util.h"
+
+#include <boost/format.hpp>
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(FV2D_AVX2_KERNELS)
+#include <immintrin.h>
+#endif
+
+
+namespace {
+    // one neighbour of a cell
+    struct StencilEntry {
+        boost::uint64_t neighbour;
+
+        // centroid -> neighbour
+        double          dx;
+        double          dy;
+
+        // S_f pointing out of the cell, times the weight of the neighbour in the face value
+        double          sx;
+        double          sy;
+
+        // boundary face, value extrapolated from the cell
+        bool            extrapolated;
+    };
+
+#if defined(FV2D_AVX2_KERNELS)
+    // cells begin, ... up to the last full vector before end, returns the cell after them
+    FV2D_TARGET_AVX2 std::size_t
+    computeCellsAVX2(std::size_t begin, std::size_t end, std::size_t ncells, std::size_t width, boost::uint64_t const * neighbour,
+                     double const * wx, double const * wy, double const * values, double * gx, double * gy) {
+        std::size_t i = begin;
+
+        for (; i + 4 <= end; i += 4) {
+            __m256d phi = _mm256_loadu_pd(values + i);
+            __m256d sx  = _mm256_setzero_pd();
+            __m256d sy  = _mm256_setzero_pd();
+
+            for (std::size_t k = 0; k < width; ++k) {
+                std::size_t index = k * ncells + i;
+
+                __m256i nb   = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&neighbour[index]));
+                __m256d diff = _mm256_sub_pd(_mm256_i64gather_pd(values, nb, 8), phi);
+
+                sx = _mm256_add_pd(sx, _mm256_mul_pd(_mm256_loadu_pd(&wx[index]), diff));
+                sy = _mm256_add_pd(sy, _mm256_mul_pd(_mm256_loadu_pd(&wy[index]), diff));
+            }
+
+            _mm256_storeu_pd(gx + i, sx);
+            _mm256_storeu_pd(gy + i, sy);
+        }
+
+        return i;
+    }
+#endif
+
+}
+
+CellGradient::CellGradient(MeshGeometry const & geometry, Method method, unsigned int nthreads, std::vector<bool> const & extrapolated)
+    : method_(method), nthreads_(ParallelFor::numberOfThreads(nthreads)), ncells_(geometry.getNumberOfCells()), nfaces_(geometry.getNumberOfFaces()), width_(0) {
+
+    if (!extrapolated.empty() && extrapolated.size() != nfaces_)
+        throw std::out_of_range("CellGradient::CellGradient(): Wrong number of faces");
+
+    MeshGeometry::Index_t const & face_cells = geometry.faceCells();
+    MeshGeometry::Array_t const & volume = geometry.cellVolume();
+    MeshGeometry::Array_t const & ccx = geometry.cellCentroidX();
+    MeshGeometry::Array_t const & ccy = geometry.cellCentroidY();
+    MeshGeometry::Array_t const & fcx = geometry.faceCentroidX();
+    MeshGeometry::Array_t const & fcy = geometry.faceCentroidY();
+    MeshGeometry::Array_t const & nx = geometry.faceNormalX();
+    MeshGeometry::Array_t const & ny = geometry.faceNormalY();
+
+    // collect the neighbours per cell
+    Index_t start(ncells_ + 1, 0);
+    for (std::size_t face = 0; face < nfaces_; ++face) {
+        start[face_cells[2 * face] + 1]++;
+        if (face_cells[2 * face + 1] != MeshGeometry::NO_CELL)
+            start[face_cells[2 * face + 1] + 1]++;
+    }
+
+    for (std::size_t cell = 0; cell < ncells_; ++cell)
+        start[cell + 1] += start[cell];
+
+    std::vector<StencilEntry> entries(start[ncells_]);
+    Index_t next(start.begin(), start.end() - 1);
+
+    for (std::size_t face = 0; face < nfaces_; ++face) {
+        boost::uint64_t c1 = face_cells[2 * face];
+        boost::uint64_t c2 = face_cells[2 * face + 1];
+
+        bool boundary = c2 == MeshGeometry::NO_CELL;
+
+        double dx = (boundary ? fcx[face] : ccx[c2]) - ccx[c1];
+        double dy = (boundary ? fcy[face] : ccy[c2]) - ccy[c1];
+
+        // S points away from the first cell
+        double sx = nx[face];
+        double sy = ny[face];
+        if (sx * (fcx[face] - ccx[c1]) + sy * (fcy[face] - ccy[c1]) < 0) {
+            sx = -sx;
+            sy = -sy;
+        }
+
+        if (boundary) {
+            bool extrapolate = !extrapolated.empty() && extrapolated[face];
+
+            StencilEntry entry = {ncells_ + face, dx, dy, sx, sy, extrapolate};
+            entries[next[c1]++] = entry;
+
+            if (!extrapolate) {
+                boundary_faces_.push_back(face);
+                boundary_cells_.push_back(c1);
+            }
+            continue;
+        }
+
+        // weight of the first cell in the face value
+        double g = ((ccx[c2] - fcx[face]) * dx + (ccy[c2] - fcy[face]) * dy) / (dx * dx + dy * dy);
+
+        StencilEntry entry1 = {c2, dx, dy, (1.0 - g) * sx, (1.0 - g) * sy, false};
+        StencilEntry entry2 = {c1, -dx, -dy, -g * sx, -g * sy, false};
+
+        entries[next[c1]++] = entry1;
+        entries[next[c2]++] = entry2;
+    }
+
+    for (std::size_t cell = 0; cell < ncells_; ++cell) {
+        std::size_t n = 0;
+        for (boost::uint64_t e = start[cell]; e < start[cell + 1]; ++e)
+            n += entries[e].extrapolated ? 0 : 1;
+
+        width_ = std::max(width_, n);
+    }
+
+    // padding: the cell itself with weight 0
+    neighbour_.resize(width_ * ncells_);
+    wx_.assign(width_ * ncells_, 0.0);
+    wy_.assign(width_ * ncells_, 0.0);
+
+    for (std::size_t cell = 0; cell < ncells_; ++cell) {
+        for (std::size_t k = 0; k < width_; ++k)
+            neighbour_[k * ncells_ + cell] = cell;
+
+        double inv_volume = 1.0 / std::fabs(volume[cell]);
+
+        /* The weights are B^-1 r_PN with
+         *   least squares: r_PN = d_PN / |d_PN|^2, B = M,
+         *   Green-Gauss:   r_PN = S_f / V_P,       B = I - \sum_extrapolated S_f d^T / V_P.
+         */
+        double b00 = method_ == LEAST_SQUARES ? 0.0 : 1.0;
+        double b01 = 0.0;
+        double b10 = 0.0;
+        double b11 = b00;
+
+        for (boost::uint64_t e = start[cell]; e < start[cell + 1]; ++e) {
+            StencilEntry const & entry = entries[e];
+
+            if (method_ == LEAST_SQUARES && !entry.extrapolated) {
+                double w = 1.0 / (entry.dx * entry.dx + entry.dy * entry.dy);
+
+                b00 += w * entry.dx * entry.dx;
+                b01 += w * entry.dx * entry.dy;
+                b10 += w * entry.dy * entry.dx;
+                b11 += w * entry.dy * entry.dy;
+            }
+            else if (method_ == GREEN_GAUSS && entry.extrapolated) {
+                b00 -= entry.sx * entry.dx * inv_volume;
+                b01 -= entry.sx * entry.dy * inv_volume;
+                b10 -= entry.sy * entry.dx * inv_volume;
+                b11 -= entry.sy * entry.dy * inv_volume;
+            }
+        }
+
+        double det = b00 * b11 - b01 * b10;
+        double scale = std::fabs(b00) + std::fabs(b01) + std::fabs(b10) + std::fabs(b11);
+
+        if (!(std::fabs(det) > 1E-12 * scale * scale)) {
+            boost::format format = boost::format("CellGradient: Gradient of cell %1% not defined by its neighbours!\n") % cell;
+            Util::error(format.str());
+            throw std::logic_error(format.str().c_str());
+        }
+
+        // B^-1
+        double inv00 =  b11 / det;
+        double inv01 = -b01 / det;
+        double inv10 = -b10 / det;
+        double inv11 =  b00 / det;
+
+        std::size_t k = 0;
+
+        for (boost::uint64_t e = start[cell]; e < start[cell + 1]; ++e) {
+            StencilEntry const & entry = entries[e];
+
+            if (entry.extrapolated)
+                continue;
+
+            double rx, ry;
+            if (method_ == LEAST_SQUARES) {
+                double w = 1.0 / (entry.dx * entry.dx + entry.dy * entry.dy);
+
+                rx = w * entry.dx;
+                ry = w * entry.dy;
+            }
+            else {
+                rx = entry.sx * inv_volume;
+                ry = entry.sy * inv_volume;
+            }
+
+            std::size_t index = k++ * ncells_ + cell;
+
+            neighbour_[index] = entry.neighbour;
+            wx_[index] = inv00 * rx + inv01 * ry;
+            wy_[index] = inv10 * rx + inv11 * ry;
+        }
+    }
+}
+
+CellGradient::Method
+CellGradient::getMethod() const {
+    return method_;
+}
+
+std::size_t
+CellGradient::getNumberOfCells() const {
+    return ncells_;
+}
+
+std::size_t
+CellGradient::getNumberOfFaces() const {
+    return nfaces_;
+}
+
+std::size_t
+CellGradient::getStencilWidth() const {
+    return width_;
+}
+
+void
+CellGradient::compute(Array_t const & cell_values, Array_t & gx, Array_t & gy) const {
+    compute(cell_values, Array_t(), gx, gy);
+}
+
+void
+CellGradient::compute(Array_t const & cell_values, Array_t const & face_values, Array_t & gx, Array_t & gy) const {
+    if (cell_values.size() != ncells_)
+        throw std::out_of_range("CellGradient::compute(): Wrong number of cell values");
+
+    if (!face_values.empty() && face_values.size() != nfaces_)
+        throw std::out_of_range("CellGradient::compute(): Wrong number of face values");
+
+    // the cell values followed by the face values, see neighbour_
+    Array_t values(ncells_ + nfaces_, 0.0);
+    std::copy(cell_values.begin(), cell_values.end(), values.begin());
+
+    for (std::size_t i = 0; i < boundary_faces_.size(); ++i)
+        values[ncells_ + boundary_faces_[i]] = face_values.empty() ? cell_values[boundary_cells_[i]] : face_values[boundary_faces_[i]];
+
+    gx.resize(ncells_);
+    gy.resize(ncells_);
+
+    if (ncells_ == 0)
+        return;
+
+    double const * v = &values[0];
+    double * px = &gx[0];
+    double * py = &gy[0];
+
+    ParallelFor::forEachChunk(ncells_, nthreads_, [this, v, px, py](std::size_t begin, std::size_t end) { computeCells(begin, end, v, px, py); });
+}
+
+void
+CellGradient::computeCells(std::size_t begin, std::size_t end, double const * values, double * gx, double * gy) const {
+    std::size_t i = begin;
+
+#if defined(FV2D_AVX2_KERNELS)
+    if (InstructionSet::active() == InstructionSet::AVX2)
+        i = computeCellsAVX2(begin, end, ncells_, width_, neighbour_.data(), wx_.data(), wy_.data(), values, gx, gy);
+#endif
+
+    for (; i < end; ++i) {
+        double phi = values[i];
+        double sx  = 0.0;
+        double sy  = 0.0;
+
+        for (std::size_t k = 0; k < width_; ++k) {
+            std::size_t index = k * ncells_ + i;
+            double diff = values[neighbour_[index]] - phi;
+
+            sx += wx_[index] * diff;
+            sy += wy_[index] * diff;
+        }
+
+        gx[i] = sx;
+        gy[i] = sy;
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ * Name  : CellGradient
+ * Path  :
+ * Use   : Cell-centred gradients of scalar fields on a whole mesh.
+ *         The gradient of cell P is written as the weighted sum of the
+ *         differences to its neighbours N (boundary faces: the value at
+ *         the face centroid),
+ *             (\grad \phi)_P = \sum_N w_PN (\phi_N - \phi_P),
+ *         with the weights w_PN depending only on the geometry:
+ *         - GREEN_GAUSS:   w_PN = (1 - g_P) S_f / V_P, the face value
+ *                          interpolated linearly along the line between
+ *                          the centroids (\sum_f S_f = 0 for a closed
+ *                          cell), Versteeg, Malalasekera, p. 319,
+ *         - LEAST_SQUARES: w_PN = M^-1 d_PN / |d_PN|^2, M = \sum_N d_PN
+ *                          d_PN^T / |d_PN|^2, i.e. exact for linear
+ *                          fields on any mesh.
+ *         The value at boundary faces marked as extrapolated (e.g. von
+ *         Neumann faces) is not given but \phi_P + (\grad \phi)_P . d;
+ *         these faces are left out of the least squares fit and moved to
+ *         the left hand side of the Green-Gauss sum, i.e. the gradient
+ *         is the fixed point of the extrapolation.
+ *         The weights are computed once from a MeshGeometry and stored
+ *         per stencil position k in arrays over all cells (cells with
+ *         fewer faces padded with zero weights), so that compute() runs
+ *         over consecutive cells with AVX2 (if the processor supports
+ *         it, see InstructionSet) and several threads.
+ *         Cells and faces are in the order of MeshGeometry.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include <vector>
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+
+
+class MeshGeometry;
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2DLIB CellGradient {
+public:
+    typedef std::vector<double>          Array_t;
+    typedef std::vector<boost::uint64_t> Index_t;
+
+    enum Method {GREEN_GAUSS, LEAST_SQUARES};
+
+public:
+    /* nthreads = 0: one thread per core. extrapolated: per face, empty:
+     * none. Throws std::logic_error if the system of a cell is singular.
+     */
+    explicit CellGradient(MeshGeometry const & geometry, Method method = LEAST_SQUARES, unsigned int nthreads = 0,
+                          std::vector<bool> const & extrapolated = std::vector<bool>());
+
+    Method          getMethod() const;
+    std::size_t     getNumberOfCells() const;
+    std::size_t     getNumberOfFaces() const;
+
+    // maximum number of faces of a cell
+    std::size_t     getStencilWidth() const;
+
+    /* cell_values: one value per cell. face_values: one value per face,
+     * only the values of the boundary faces not extrapolated are used;
+     * if empty, the value of the cell is taken (zero gradient at the
+     * boundary).
+     */
+    void            compute(Array_t const & cell_values, Array_t const & face_values, Array_t & gx, Array_t & gy) const;
+    void            compute(Array_t const & cell_values, Array_t & gx, Array_t & gy) const;
+
+private:
+    void            computeCells(std::size_t begin, std::size_t end, double const * values, double * gx, double * gy) const;
+
+private:
+    Method       method_;
+    unsigned int nthreads_;
+
+    std::size_t  ncells_;
+    std::size_t  nfaces_;
+    std::size_t  width_;
+
+    /* Stencil position k of cell i at k * ncells_ + i. Neighbour index
+     * into the cell values followed by the face values.
+     */
+    Index_t      neighbour_;
+    Array_t      wx_;
+    Array_t      wy_;
+
+    // boundary faces and their cells
+    Index_t      boundary_faces_;
+    Index_t      boundary_cells_;
+};
+
+#pragma warning(default:4251)
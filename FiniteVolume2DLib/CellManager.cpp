@@ -27,6 +27,38 @@ CellManager::createCell(IGeometricEntity::Id_t mesh_id, EntityCollection<Face> c
     return cell;
 }
 
+bool
+CellManager::createCells(std::vector<IGeometricEntity::Id_t> const & mesh_ids, std::vector<std::size_t> const & offsets,
+                         std::vector<Face::Ptr> const & faces, std::vector<Cell::Ptr> & cells) {
+    std::size_t n = mesh_ids.size();
+
+    reserve(n);
+    cells.clear();
+    cells.reserve(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        EntityCollection<Face> cell_faces;
+        cell_faces.reserve(offsets[i + 1] - offsets[i]);
+        for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+            cell_faces.insert(faces[k]);
+
+        Cell::Ptr cell = Cell::create(getNewEntityIndex(), mesh_ids[i], cell_faces);
+
+        if (!registerEntity(mesh_ids[i], cell)) {
+            unregisterEntities(mesh_ids, i);
+            cells.clear();
+
+            boost::format format = boost::format("CellManager::createCells: Cell with mesh id %1% already created!\n") % mesh_ids[i];
+            return Util::error(format.str());
+        }
+        cells.push_back(cell);
+    }
+
+    insertEntities(cells);
+
+    return true;
+}
+
 CellManager::Ptr
 CellManager::create() {
     return Ptr(new CellManager);
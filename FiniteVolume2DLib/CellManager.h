@@ -23,6 +23,11 @@ public:
 public:
     Cell::Ptr createCell(IGeometricEntity::Id_t mesh_id, EntityCollection<Face> const & faces);
 
+    // bulk version, faces of cell i are faces[offsets[i]] .. faces[offsets[i + 1] - 1]:
+    // if any mesh id is taken, no cell is created at all
+    bool      createCells(std::vector<IGeometricEntity::Id_t> const & mesh_ids, std::vector<std::size_t> const & offsets,
+                          std::vector<Face::Ptr> const & faces, std::vector<Cell::Ptr> & cells);
+
     static Ptr create();
 
 private:
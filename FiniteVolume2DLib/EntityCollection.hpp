@@ -42,6 +42,10 @@ public:
         data_.push_back(entity);
     }
 
+    void reserve(size_type n) {
+        data_.reserve(n);
+    }
+
     void insertUnique(typename Entity::Ptr const & entity) {
         if (!find(entity->meshId()))
             data_.push_back(entity);
@@ -9,13 +9,14 @@
 
 #include "EntityCollection.hpp"
 
-#include <map>
+#include <unordered_map>
+#include <vector>
 
 
 template<typename Entity>
 class EntityManager {
 private:
-    typedef typename std::map<IGeometricEntity::Id_t, typename Entity::Ptr> MeshIdMapping_t;
+    typedef typename std::unordered_map<IGeometricEntity::Id_t, typename Entity::Ptr> MeshIdMapping_t;
 
 public:
     typedef typename EntityCollection<Entity>::iterator iterator;
@@ -34,6 +35,21 @@ public:
         return mesh_id_mapping_[mesh_id];
     }
 
+    // unlike getEntity(), an unknown mesh id is not inserted
+    typename Entity::Ptr
+    lookupEntity(IGeometricEntity::Id_t mesh_id) const {
+        typename MeshIdMapping_t::const_iterator it = mesh_id_mapping_.find(mesh_id);
+        if (it == mesh_id_mapping_.end())
+            return typename Entity::Ptr();
+        return it->second;
+    }
+
+    // make room for n more entities
+    void reserve(std::size_t n) {
+        collection_.reserve(collection_.size() + n);
+        mesh_id_mapping_.reserve(mesh_id_mapping_.size() + n);
+    }
+
 protected:
     IGeometricEntity::Id_t getNewEntityIndex() {
         static IGeometricEntity::Id_t index = 0;
@@ -44,6 +60,21 @@ protected:
         return mesh_id_mapping_.find(mesh_id) != mesh_id_mapping_.end();
     }
 
+    // used by the bulk creators: returns false if the mesh id is already taken
+    bool registerEntity(IGeometricEntity::Id_t mesh_id, typename Entity::Ptr const & entity) {
+        return mesh_id_mapping_.insert(std::make_pair(mesh_id, entity)).second;
+    }
+
+    // undo the registration of the first n mesh ids after a failed bulk creation
+    void unregisterEntities(std::vector<IGeometricEntity::Id_t> const & mesh_ids, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i)
+            mesh_id_mapping_.erase(mesh_ids[i]);
+    }
+
+    void insertEntities(std::vector<typename Entity::Ptr> const & entities) {
+        collection_.data_.insert(collection_.data_.end(), entities.begin(), entities.end());
+    }
+
 protected:
     EntityCollection<Entity> collection_;
 
@@ -3,33 +3,91 @@
 #include "Util.h"
 
 #include <exception>
+#include <algorithm>
 #include <boost/format.hpp>
 
 
-void
-FaceConnectivity::insert(Cell::Ptr const & cell) {
-    // attach this cell to all its faces
-    typedef EntityCollection<Face>::size_type size_type;
+namespace {
+    struct FaceCellLink {
+        IGeometricEntity::Id_t face_id;
+        Face::Ptr              face;
+        Cell::Ptr              cell;
+    };
 
-    EntityCollection<Face> const & faces = cell->getFaces();
-    for (size_type i = 0; i < faces.size(); ++i) {
-        Face::Ptr const & face = faces.getEntity(i);
-        face_cells_[face->id()].insert(cell);
-
-        if (face->getEntityType() == IGeometricEntity::BOUNDARY && face_cells_[face->id()].size() > 1) {
+    void checkNumberOfCells(Face::Ptr const & face, Cell::Ptr const & cell, EntityCollection<Cell>::size_type ncells) {
+        if (face->getEntityType() == IGeometricEntity::BOUNDARY && ncells > 1) {
             boost::format format = boost::format("FaceConnectivity::insert: Boundary face %1% has more than 1 cell neighbor \
                                                  when inserting cell %2%!\n") % face->meshId() % cell->meshId();
             Util::error(format.str());
             throw std::logic_error(format.str().c_str());
         }
 
-        if (face->getEntityType() == IGeometricEntity::INTERIOR && face_cells_[face->id()].size() > 2) {
+        if (face->getEntityType() == IGeometricEntity::INTERIOR && ncells > 2) {
             boost::format format = boost::format("FaceConnectivity::insert: Interior face %1% has more than 2 cell neighbors \
                                                  when inserting cell %2%!\n") % face->meshId() % cell->meshId();
             Util::error(format.str());
             throw std::logic_error(format.str().c_str());
         }
     }
+
+}
+
+
+void
+FaceConnectivity::insert(Cell::Ptr const & cell) {
+    // attach this cell to all its faces
+    typedef EntityCollection<Face>::size_type size_type;
+
+    EntityCollection<Face> const & faces = cell->getFaces();
+    for (size_type i = 0; i < faces.size(); ++i) {
+        Face::Ptr const & face = faces.getEntity(i);
+        EntityCollection<Cell> & attached = face_cells_[face->id()];
+        attached.insert(cell);
+
+        checkNumberOfCells(face, cell, attached.size());
+    }
+}
+
+void
+FaceConnectivity::insert(std::vector<Cell::Ptr> const & cells) {
+    typedef EntityCollection<Face>::size_type size_type;
+
+    std::vector<FaceCellLink> links;
+    links.reserve(3 * cells.size());
+
+    std::for_each(cells.begin(), cells.end(), [&links](Cell::Ptr const & cell) {
+        EntityCollection<Face> const & faces = cell->getFaces();
+
+        for (size_type i = 0; i < faces.size(); ++i) {
+            FaceCellLink l = { faces.getEntity(i)->id(), faces.getEntity(i), cell };
+            links.push_back(l);
+        }
+    });
+
+    // one sort instead of one map lookup per link; equal faces keep the cell order
+    std::stable_sort(links.begin(), links.end(), [](FaceCellLink const & lhs, FaceCellLink const & rhs) {
+        return lhs.face_id < rhs.face_id;
+    });
+
+    std::size_t i = 0;
+    while (i < links.size()) {
+        IGeometricEntity::Id_t face_id = links[i].face_id;
+
+        FaceCells_t::iterator it;
+        if (face_cells_.empty() || face_cells_.rbegin()->first < face_id)
+            it = face_cells_.insert(face_cells_.end(), std::make_pair(face_id, EntityCollection<Cell>()));
+        else {
+            it = face_cells_.lower_bound(face_id);
+            if (it == face_cells_.end() || it->first != face_id)
+                it = face_cells_.insert(it, std::make_pair(face_id, EntityCollection<Cell>()));
+        }
+
+        EntityCollection<Cell> & attached = it->second;
+        for (; i < links.size() && links[i].face_id == face_id; ++i) {
+            attached.insert(links[i].cell);
+            checkNumberOfCells(links[i].face, links[i].cell, attached.size());
+        }
+    }
 }
 
 boost::optional<EntityCollection<Cell>>
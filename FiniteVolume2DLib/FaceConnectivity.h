@@ -11,6 +11,7 @@
 #include "Cell.h"
 
 #include <map>
+#include <vector>
 
 #include <boost/optional.hpp>
 
@@ -18,6 +19,9 @@
 class FaceConnectivity {
 public:
     void                                    insert(Cell::Ptr const & cell);
+
+    // bulk version, same result as inserting the cells one by one
+    void                                    insert(std::vector<Cell::Ptr> const & cells);
     boost::optional<EntityCollection<Cell>> getCellsAttachedToFace(Face::Ptr const & face) const;
     Cell::Ptr                               getOtherCell(Face::Ptr const & face, Cell::Ptr const & cell) const;
 
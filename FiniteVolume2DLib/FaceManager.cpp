@@ -27,6 +27,38 @@ Face::Ptr FaceManager::createFace(IGeometricEntity::Id_t mesh_id, IGeometricEnti
     return face;
 }
 
+bool
+FaceManager::createFaces(std::vector<IGeometricEntity::Id_t> const & mesh_ids, std::vector<IGeometricEntity::Entity_t> const & entity_types,
+                         std::vector<Node::Ptr> const & nodes, std::vector<Face::Ptr> & faces) {
+    std::size_t n = mesh_ids.size();
+
+    reserve(n);
+    faces.clear();
+    faces.reserve(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        EntityCollection<Node> face_nodes;
+        face_nodes.reserve(2);
+        face_nodes.insert(nodes[2 * i]);
+        face_nodes.insert(nodes[2 * i + 1]);
+
+        Face::Ptr face = Face::create(getNewEntityIndex(), mesh_ids[i], entity_types[i], face_nodes);
+
+        if (!registerEntity(mesh_ids[i], face)) {
+            unregisterEntities(mesh_ids, i);
+            faces.clear();
+
+            boost::format format = boost::format("FaceManager::createFaces: Face with mesh id %1% already created!\n") % mesh_ids[i];
+            return Util::error(format.str());
+        }
+        faces.push_back(face);
+    }
+
+    insertEntities(faces);
+
+    return true;
+}
+
 FaceManager::Ptr
 FaceManager::create() {
     return Ptr(new FaceManager);
@@ -23,6 +23,10 @@ public:
 public:
     Face::Ptr createFace(IGeometricEntity::Id_t mesh_id, IGeometricEntity::Entity_t entity_type, EntityCollection<Node> const & nodes);
 
+    // bulk version, two nodes per face: if any mesh id is taken, no face is created at all
+    bool      createFaces(std::vector<IGeometricEntity::Id_t> const & mesh_ids, std::vector<IGeometricEntity::Entity_t> const & entity_types,
+                          std::vector<Node::Ptr> const & nodes, std::vector<Face::Ptr> & faces);
+
     static Ptr create();
 
 private:
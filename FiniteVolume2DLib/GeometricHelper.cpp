@@ -6,8 +6,14 @@
 #include "ParametrizedLineSegment.h"
 #include "Line.h"
 #include "Math.h"
+#include "InstructionSet.h"
 
 #include <cassert>
+#include <algorithm>
+
+#if defined(FV2D_AVX2_KERNELS)
+#include <immintrin.h>
+#endif
 
 
 // disable "warning C4482: nonstandard extension used: enum 'GeometricHelper::IntersectionType' used in qualified name"
@@ -264,6 +270,128 @@ namespace {
         return std::make_tuple(GeometricHelper::OVERLAP, ls.p0(), ls.p1());
     }
 
+    // relative to the squared lengths of both directions
+    double const BATCH_EPS = 1E-10;
+
+    // ray: P + t \vec{d} is a ray (t >= 0), otherwise a line
+    void
+    intersect_batch_element(bool ray, double x0, double y0, double x1, double y1, double px, double py, double dx, double dy,
+                            double & s, double & t, GeometricHelper::IntersectionType & type) {
+        // as above, segment: P_{0} + s \vec{u}, line / ray: P + t \vec{d}, E = P - P_{0}
+        double ux = x1 - x0;
+        double uy = y1 - y0;
+        double ex = px - x0;
+        double ey = py - y0;
+
+        double kross = ux * dy - uy * dx;
+        double sqrLenU = ux * ux + uy * uy;
+        double sqrLenD = dx * dx + dy * dy;
+
+        if (kross * kross > BATCH_EPS * sqrLenU * sqrLenD) {
+            s = (ex * dy - ey * dx) / kross;
+            t = (ex * uy - ey * ux) / kross;
+
+            bool inside = s >= 0 && s <= 1 && (!ray || t >= 0);
+            type = inside ? GeometricHelper::UNIQUE_INTERSECTION : GeometricHelper::EMPTY;
+            return;
+        }
+
+        s = 0;
+        t = 0;
+
+        kross = ex * uy - ey * ux;
+        if (kross * kross > BATCH_EPS * sqrLenU * (ex * ex + ey * ey)) {
+            type = GeometricHelper::EMPTY_PARALLEL;
+            return;
+        }
+
+        type = GeometricHelper::OVERLAP;
+        if (!ray)
+            return;
+
+        // the ray covers s >= s0 or s <= s0 of the segment's line
+        double s0 = (ux * ex + uy * ey) / sqrLenU;
+
+        if (ux * dx + uy * dy > 0) {
+            if (s0 > 1)
+                type = GeometricHelper::EMPTY_PARALLEL;
+            else
+                s = std::max(s0, 0.0);
+        }
+        else if (s0 < 0)
+            type = GeometricHelper::EMPTY_PARALLEL;
+    }
+
+#if defined(FV2D_AVX2_KERNELS)
+    // up to the last full vector, returns the number of pairs done
+    FV2D_TARGET_AVX2 std::size_t
+    intersect_batch_avx2(bool ray, std::size_t n, double const * x0, double const * y0, double const * x1, double const * y1,
+                         double const * px, double const * py, double const * dx, double const * dy,
+                         double * s, double * t, GeometricHelper::IntersectionType * type) {
+        std::size_t i = 0;
+
+        __m256d const zero = _mm256_setzero_pd();
+        __m256d const one  = _mm256_set1_pd(1.0);
+        __m256d const eps  = _mm256_set1_pd(BATCH_EPS);
+
+        for (; i + 4 <= n; i += 4) {
+            __m256d vx0 = _mm256_loadu_pd(x0 + i);
+            __m256d vy0 = _mm256_loadu_pd(y0 + i);
+            __m256d vdx = _mm256_loadu_pd(dx + i);
+            __m256d vdy = _mm256_loadu_pd(dy + i);
+
+            __m256d ux = _mm256_sub_pd(_mm256_loadu_pd(x1 + i), vx0);
+            __m256d uy = _mm256_sub_pd(_mm256_loadu_pd(y1 + i), vy0);
+            __m256d ex = _mm256_sub_pd(_mm256_loadu_pd(px + i), vx0);
+            __m256d ey = _mm256_sub_pd(_mm256_loadu_pd(py + i), vy0);
+
+            __m256d kross = _mm256_sub_pd(_mm256_mul_pd(ux, vdy), _mm256_mul_pd(uy, vdx));
+            __m256d sqrLenU = _mm256_add_pd(_mm256_mul_pd(ux, ux), _mm256_mul_pd(uy, uy));
+            __m256d sqrLenD = _mm256_add_pd(_mm256_mul_pd(vdx, vdx), _mm256_mul_pd(vdy, vdy));
+
+            __m256d crossing = _mm256_cmp_pd(_mm256_mul_pd(kross, kross), _mm256_mul_pd(eps, _mm256_mul_pd(sqrLenU, sqrLenD)), _CMP_GT_OQ);
+
+            // (nearly) parallel pairs are rare, leave the whole block to the scalar code
+            if (_mm256_movemask_pd(crossing) != 0xF) {
+                for (std::size_t j = i; j < i + 4; ++j)
+                    intersect_batch_element(ray, x0[j], y0[j], x1[j], y1[j], px[j], py[j], dx[j], dy[j], s[j], t[j], type[j]);
+                continue;
+            }
+
+            __m256d vs = _mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(ex, vdy), _mm256_mul_pd(ey, vdx)), kross);
+            __m256d vt = _mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(ex, uy), _mm256_mul_pd(ey, ux)), kross);
+
+            __m256d inside = _mm256_and_pd(_mm256_cmp_pd(vs, zero, _CMP_GE_OQ), _mm256_cmp_pd(vs, one, _CMP_LE_OQ));
+            if (ray)
+                inside = _mm256_and_pd(inside, _mm256_cmp_pd(vt, zero, _CMP_GE_OQ));
+
+            _mm256_storeu_pd(s + i, vs);
+            _mm256_storeu_pd(t + i, vt);
+
+            int mask = _mm256_movemask_pd(inside);
+            for (int j = 0; j < 4; ++j)
+                type[i + j] = (mask >> j) & 1 ? GeometricHelper::UNIQUE_INTERSECTION : GeometricHelper::EMPTY;
+        }
+
+        return i;
+    }
+#endif
+
+    void
+    intersect_batch(bool ray, std::size_t n, double const * x0, double const * y0, double const * x1, double const * y1,
+                    double const * px, double const * py, double const * dx, double const * dy,
+                    double * s, double * t, GeometricHelper::IntersectionType * type) {
+        std::size_t i = 0;
+
+#if defined(FV2D_AVX2_KERNELS)
+        if (InstructionSet::active() == InstructionSet::AVX2)
+            i = intersect_batch_avx2(ray, n, x0, y0, x1, y1, px, py, dx, dy, s, t, type);
+#endif
+
+        for (; i < n; ++i)
+            intersect_batch_element(ray, x0[i], y0[i], x1[i], y1[i], px[i], py[i], dx[i], dy[i], s[i], t[i], type[i]);
+    }
+
 }
 
 boost::optional<Vertex>
@@ -302,4 +430,18 @@ GeometricHelper::intersect(LineSegment const & ls, Line const & line) {
     return boost::optional<Vertex>();
 }
 
+void
+GeometricHelper::intersectLines(std::size_t n, double const * x0, double const * y0, double const * x1, double const * y1,
+                                double const * px, double const * py, double const * dx, double const * dy,
+                                double * s, double * t, IntersectionType * type) {
+    intersect_batch(false, n, x0, y0, x1, y1, px, py, dx, dy, s, t, type);
+}
+
+void
+GeometricHelper::intersectRays(std::size_t n, double const * x0, double const * y0, double const * x1, double const * y1,
+                               double const * px, double const * py, double const * dx, double const * dy,
+                               double * s, double * t, IntersectionType * type) {
+    intersect_batch(true, n, x0, y0, x1, y1, px, py, dx, dy, s, t, type);
+}
+
 #pragma warning(default:4482)
@@ -12,6 +12,7 @@
 #include <boost/optional.hpp>
 
 #include <tuple>
+#include <cstddef>
 
 
 class Vertex;
@@ -38,6 +39,26 @@ public:
     static boost::optional<Vertex> intersect(LineSegment const & ls1, LineSegment const & ls2);
     static boost::optional<Vertex> intersect(LineSegment const & ls, Ray const & ray);
     static boost::optional<Vertex> intersect(LineSegment const & ls, Line const & line);
+
+    /* Batch versions: n segments (x0, y0) -> (x1, y1) against n lines
+     * or rays through (px, py) in direction (dx, dy), all as flat arrays.
+     * For each pair the result is the type and the parameters s on the
+     * segment and t on the line / ray, i.e. the intersection point is
+     * (x0 + s (x1 - x0), y0 + s (y1 - y0)) = (px + t dx, py + t dy).
+     * s and t are also set for EMPTY (the lines cross outside the
+     * segment / behind the ray); for OVERLAP s is the start of the
+     * common part on the segment and t = 0; both are 0 for
+     * EMPTY_PARALLEL.
+     * The parallel test is relative to the squared lengths of both
+     * directions. The non-parallel pairs are done four at a time with
+     * AVX2 if the processor supports it (see InstructionSet).
+     */
+    static void                    intersectLines(std::size_t n, double const * x0, double const * y0, double const * x1, double const * y1,
+                                                  double const * px, double const * py, double const * dx, double const * dy,
+                                                  double * s, double * t, IntersectionType * type);
+    static void                    intersectRays(std::size_t n, double const * x0, double const * y0, double const * x1, double const * y1,
+                                                 double const * px, double const * py, double const * dx, double const * dy,
+                                                 double * s, double * t, IntersectionType * type);
 };
 
 #pragma warning(default:4480)
@@ -14,6 +14,8 @@
 #include "Face.h"
 #include "Cell.h"
 
+#include <vector>
+
 
 class DECL_SYMBOLS_2DLIB IMesh {
 public:
@@ -22,4 +24,8 @@ public:
     virtual void addNode(Node::Ptr const & node) = 0;
     virtual void addFace(Face::Ptr const & face) = 0;
     virtual void addCell(Cell::Ptr const & cell) = 0;
+
+    virtual void addNodes(std::vector<Node::Ptr> const & nodes) = 0;
+    virtual void addFaces(std::vector<Face::Ptr> const & faces) = 0;
+    virtual void addCells(std::vector<Cell::Ptr> const & cells) = 0;
 };
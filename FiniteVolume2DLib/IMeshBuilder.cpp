@@ -0,0 +1,57 @@
+#include "IMeshBuilder.h"
+
+#include "Util.h"
+
+#include <boost/format.hpp>
+
+
+bool
+IMeshBuilder::buildNodes(std::vector<IGeometricEntity::Id_t> const & node_ids, std::vector<IGeometricEntity::Entity_t> const & entity_types,
+                         std::vector<double> const & x, std::vector<double> const & y) {
+    std::size_t n = node_ids.size();
+    if (entity_types.size() != n || x.size() != n || y.size() != n)
+        return Util::error("IMeshBuilder::buildNodes: Array size mismatch!\n");
+
+    bool result = true;
+    for (std::size_t i = 0; i < n; ++i)
+        result = buildNode(node_ids[i], entity_types[i], x[i], y[i]) && result;
+    return result;
+}
+
+bool
+IMeshBuilder::buildFaces(std::vector<IGeometricEntity::Id_t> const & face_ids, std::vector<IGeometricEntity::Entity_t> const & entity_types,
+                         std::vector<IGeometricEntity::Id_t> const & node_ids) {
+    std::size_t n = face_ids.size();
+    if (entity_types.size() != n || node_ids.size() != 2 * n)
+        return Util::error("IMeshBuilder::buildFaces: Array size mismatch!\n");
+
+    std::vector<IGeometricEntity::Id_t> ids(2);
+
+    bool result = true;
+    for (std::size_t i = 0; i < n; ++i) {
+        ids[0] = node_ids[2 * i];
+        ids[1] = node_ids[2 * i + 1];
+        result = buildFace(face_ids[i], entity_types[i], ids) && result;
+    }
+    return result;
+}
+
+bool
+IMeshBuilder::buildCells(std::vector<IGeometricEntity::Id_t> const & cell_ids, std::vector<std::size_t> const & offsets,
+                         std::vector<IGeometricEntity::Id_t> const & face_ids) {
+    std::size_t n = cell_ids.size();
+    if (offsets.size() != n + 1 || offsets[n] != face_ids.size())
+        return Util::error("IMeshBuilder::buildCells: Array size mismatch!\n");
+
+    std::vector<IGeometricEntity::Id_t> ids;
+
+    bool result = true;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (offsets[i + 1] < offsets[i])
+            return Util::error("IMeshBuilder::buildCells: Invalid face offsets!\n");
+
+        ids.assign(face_ids.begin() + offsets[i], face_ids.begin() + offsets[i + 1]);
+        result = buildCell(cell_ids[i], ids) && result;
+    }
+    return result;
+}
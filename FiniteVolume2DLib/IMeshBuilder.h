@@ -28,4 +28,16 @@ public:
     virtual bool                       buildCell(IGeometricEntity::Id_t cell_id, std::vector<IGeometricEntity::Id_t> const & face_ids) = 0;
     virtual void                       outputReport(std::ostream & target) const = 0;
     virtual boost::optional<Mesh::Ptr> getMesh() const = 0;
+
+    /* Bulk versions for mesh generators and fast readers. The default
+     * implementations call the single entity methods above.
+     * Faces:  node_ids holds two vertex ids per face.
+     * Cells:  the face ids of cell i are face_ids[offsets[i]] .. face_ids[offsets[i + 1] - 1].
+     */
+    virtual bool                       buildNodes(std::vector<IGeometricEntity::Id_t> const & node_ids, std::vector<IGeometricEntity::Entity_t> const & entity_types,
+                                                  std::vector<double> const & x, std::vector<double> const & y);
+    virtual bool                       buildFaces(std::vector<IGeometricEntity::Id_t> const & face_ids, std::vector<IGeometricEntity::Entity_t> const & entity_types,
+                                                  std::vector<IGeometricEntity::Id_t> const & node_ids);
+    virtual bool                       buildCells(std::vector<IGeometricEntity::Id_t> const & cell_ids, std::vector<std::size_t> const & offsets,
+                                                  std::vector<IGeometricEntity::Id_t> const & face_ids);
 };
@@ -14,6 +14,8 @@
 
 #include <boost/optional.hpp>
 
+#include <vector>
+
 
 class IMeshConnectivity {
 public:
@@ -21,6 +23,8 @@ public:
 
     virtual void                                    insert(Face::Ptr const & face) = 0;
     virtual void                                    insert(Cell::Ptr const & cell) = 0;
+    virtual void                                    insert(std::vector<Face::Ptr> const & faces) = 0;
+    virtual void                                    insert(std::vector<Cell::Ptr> const & cells) = 0;
     virtual boost::optional<EntityCollection<Node>> getNodeNeighbors(Node::Ptr const & node) const = 0;
     virtual boost::optional<EntityCollection<Face>> getFacesAttachedToNode(Node::Ptr const & node) const = 0;
     virtual boost::optional<EntityCollection<Cell>> getCellsAttachedToNode(Node::Ptr const & node) const = 0;
@@ -0,0 +1,70 @@
+#include "InstructionSet.h"
+
+#include <atomic>
+#include <algorithm>
+
+#if defined(FV2D_AVX2_KERNELS) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+namespace {
+    InstructionSet::Type
+    detect() {
+#if defined(FV2D_AVX2_KERNELS) && defined(_MSC_VER)
+        int info[4];
+
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return InstructionSet::SCALAR;
+
+        // AVX, and the operating system saves the YMM registers
+        __cpuid(info, 1);
+        if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+            return InstructionSet::SCALAR;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0 ? InstructionSet::AVX2 : InstructionSet::SCALAR;
+#elif defined(FV2D_AVX2_KERNELS)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? InstructionSet::AVX2 : InstructionSet::SCALAR;
+#else
+        return InstructionSet::SCALAR;
+#endif
+    }
+
+    std::atomic<int> &
+    activeType() {
+        static std::atomic<int> active(InstructionSet::supported());
+        return active;
+    }
+
+}
+
+InstructionSet::Type
+InstructionSet::supported() {
+    static Type const type = detect();
+    return type;
+}
+
+InstructionSet::Type
+InstructionSet::active() {
+    return static_cast<Type>(activeType().load());
+}
+
+InstructionSet::Type
+InstructionSet::select(Type type) {
+    Type result = std::min(type, supported());
+    activeType().store(result);
+
+    return result;
+}
+
+char const *
+InstructionSet::toString(Type type) {
+    switch (type) {
+    case SCALAR: return "scalar";
+    case AVX2:   return "AVX2";
+    }
+    return "unknown";
+}
@@ -0,0 +1,59 @@
+/*
+ * Name  : InstructionSet
+ * Path  :
+ * Use   : Runtime dispatch of the vectorized kernels. On x86-64 the
+ *         AVX2 variants are compiled for single functions
+ *         (FV2D_TARGET_AVX2), independent of the target of the project
+ *         (/arch, -m), and used if the processor and the operating
+ *         system support AVX2. Other platforms use the scalar loops
+ *         only.
+ *
+ *         Usage:
+ *           #if defined(FV2D_AVX2_KERNELS)
+ *           FV2D_TARGET_AVX2 void kernelAVX2(...) { ... }
+ *           #endif
+ *           ...
+ *           #if defined(FV2D_AVX2_KERNELS)
+ *           if (InstructionSet::active() == InstructionSet::AVX2)
+ *               kernelAVX2(...);
+ *           #endif
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define FV2D_AVX2_KERNELS
+
+#if defined(_MSC_VER)
+// the intrinsics are available without /arch:AVX2
+#define FV2D_TARGET_AVX2
+#else
+#define FV2D_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+
+class DECL_SYMBOLS_2DLIB InstructionSet {
+public:
+    // ordered, i.e. a set includes the ones before
+    enum Type {SCALAR, AVX2};
+
+public:
+    // the best one of the processor, SCALAR if no kernels are compiled for it
+    static Type         supported();
+
+    // used by the kernels, supported() unless restricted by select()
+    static Type         active();
+
+    /* Restricts the kernels to type, e.g. to compare the vector with
+     * the scalar results; limited to supported(). Returns the set now
+     * active.
+     */
+    static Type         select(Type type);
+
+    static char const * toString(Type type);
+};
@@ -1,5 +1,7 @@
 #include "Mesh.h"
 
+#include <algorithm>
+
 
 /* Explicitly generate code for the below specializations.
  * This makes their methods available in the UnitTest
@@ -34,6 +36,32 @@ Mesh::addCell(Cell::Ptr const & cell) {
     mesh_connectivity_.insert(cell);
 }
 
+void
+Mesh::addNodes(std::vector<Node::Ptr> const & nodes) {
+    std::for_each(nodes.begin(), nodes.end(), [this](Node::Ptr const & node) {
+        getNodeThread(node->getEntityType()).insert(node);
+    });
+}
+
+void
+Mesh::addFaces(std::vector<Face::Ptr> const & faces) {
+    std::for_each(faces.begin(), faces.end(), [this](Face::Ptr const & face) {
+        getFaceThread(face->getEntityType()).insert(face);
+    });
+
+    mesh_connectivity_.insert(faces);
+}
+
+void
+Mesh::addCells(std::vector<Cell::Ptr> const & cells) {
+    Thread<Cell> & thread = getCellThread();
+    std::for_each(cells.begin(), cells.end(), [&thread](Cell::Ptr const & cell) {
+        thread.insert(cell);
+    });
+
+    mesh_connectivity_.insert(cells);
+}
+
 IMeshConnectivity const &
 Mesh::getMeshConnectivity() const {
     return mesh_connectivity_;
@@ -29,6 +29,10 @@ public:
     void addFace(Face::Ptr const & face);
     void addCell(Cell::Ptr const & cell);
 
+    void addNodes(std::vector<Node::Ptr> const & nodes);
+    void addFaces(std::vector<Face::Ptr> const & faces);
+    void addCells(std::vector<Cell::Ptr> const & cells);
+
 
     IMeshConnectivity const & getMeshConnectivity() const;
 
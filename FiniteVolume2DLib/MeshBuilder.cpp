@@ -2,6 +2,7 @@
 
 #include "NodeManager.h"
 #include "FaceManager.h"
+#include "CellManager.h"
 #include "Node.h"
 #include "Face.h"
 #include "EntityCreatorManager.h"
@@ -71,6 +72,82 @@ MeshBuilder::buildCell(IGeometricEntity::Id_t mesh_id, std::vector<IGeometricEnt
     return true;
 }
 
+bool
+MeshBuilder::buildNodes(std::vector<IGeometricEntity::Id_t> const & mesh_ids, std::vector<IGeometricEntity::Entity_t> const & entity_types,
+                        std::vector<double> const & x, std::vector<double> const & y) {
+    std::size_t n = mesh_ids.size();
+    if (entity_types.size() != n || x.size() != n || y.size() != n)
+        return Util::error("MeshBuilder::buildNodes: Array size mismatch!\n");
+
+    std::vector<Node::Ptr> nodes;
+    if (!entity_mgr_->getNodeManager()->createNodes(mesh_ids, entity_types, x, y, nodes))
+        return false;
+
+    mesh_->addNodes(nodes);
+    return true;
+}
+
+bool
+MeshBuilder::buildFaces(std::vector<IGeometricEntity::Id_t> const & mesh_ids, std::vector<IGeometricEntity::Entity_t> const & entity_types,
+                        std::vector<IGeometricEntity::Id_t> const & node_ids) {
+    std::size_t n = mesh_ids.size();
+    if (entity_types.size() != n || node_ids.size() != 2 * n)
+        return Util::error("MeshBuilder::buildFaces: Array size mismatch!\n");
+
+    NodeManager::Ptr & node_mgr = entity_mgr_->getNodeManager();
+
+    // resolve all vertices before anything is created
+    std::vector<Node::Ptr> nodes(node_ids.size());
+    for (std::size_t i = 0; i < node_ids.size(); ++i) {
+        nodes[i] = node_mgr->lookupEntity(node_ids[i]);
+        if (!nodes[i]) {
+            boost::format format = boost::format("MeshBuilder::buildFaces: Face %1% references unknown vertex %2%!\n") % mesh_ids[i / 2] % node_ids[i];
+            return Util::error(format.str());
+        }
+    }
+
+    std::vector<Face::Ptr> faces;
+    if (!entity_mgr_->getFaceManager()->createFaces(mesh_ids, entity_types, nodes, faces))
+        return false;
+
+    mesh_->addFaces(faces);
+    return true;
+}
+
+bool
+MeshBuilder::buildCells(std::vector<IGeometricEntity::Id_t> const & mesh_ids, std::vector<std::size_t> const & offsets,
+                        std::vector<IGeometricEntity::Id_t> const & face_ids) {
+    std::size_t n = mesh_ids.size();
+    if (offsets.size() != n + 1 || offsets[n] != face_ids.size())
+        return Util::error("MeshBuilder::buildCells: Array size mismatch!\n");
+
+    FaceManager::Ptr & face_mgr = entity_mgr_->getFaceManager();
+
+    // resolve all faces before anything is created
+    std::vector<Face::Ptr> faces(face_ids.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        if (offsets[i + 1] < offsets[i]) {
+            boost::format format = boost::format("MeshBuilder::buildCells: Invalid face offsets for cell %1%!\n") % mesh_ids[i];
+            return Util::error(format.str());
+        }
+
+        for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+            faces[k] = face_mgr->lookupEntity(face_ids[k]);
+            if (!faces[k]) {
+                boost::format format = boost::format("MeshBuilder::buildCells: Cell %1% references unknown face %2%!\n") % mesh_ids[i] % face_ids[k];
+                return Util::error(format.str());
+            }
+        }
+    }
+
+    std::vector<Cell::Ptr> cells;
+    if (!entity_mgr_->getCellManager()->createCells(mesh_ids, offsets, faces, cells))
+        return false;
+
+    mesh_->addCells(cells);
+    return true;
+}
+
 void
 MeshBuilder::outputReport(std::ostream & target) const {
     Mesh::CPtr cmesh(mesh_);
@@ -36,6 +36,15 @@ public:
     void                       outputReport(std::ostream & target) const;
     boost::optional<Mesh::Ptr> getMesh() const;
 
+    // bulk versions: storage is reserved up front and the connectivity
+    // is built in one pass per call
+    bool                       buildNodes(std::vector<IGeometricEntity::Id_t> const & mesh_ids, std::vector<IGeometricEntity::Entity_t> const & entity_types,
+                                          std::vector<double> const & x, std::vector<double> const & y);
+    bool                       buildFaces(std::vector<IGeometricEntity::Id_t> const & mesh_ids, std::vector<IGeometricEntity::Entity_t> const & entity_types,
+                                          std::vector<IGeometricEntity::Id_t> const & node_ids);
+    bool                       buildCells(std::vector<IGeometricEntity::Id_t> const & mesh_ids, std::vector<std::size_t> const & offsets,
+                                          std::vector<IGeometricEntity::Id_t> const & face_ids);
+
 private:
     MeshBuilder(MeshBuilder const & in);
     MeshBuilder & operator=(MeshBuilder const & in);
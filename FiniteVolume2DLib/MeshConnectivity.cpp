@@ -36,3 +36,14 @@ MeshConnectivity::insert(Cell::Ptr const & cell) {
     node_connectivity_.insert(cell);
     face_connectivity_.insert(cell);
 }
+
+void
+MeshConnectivity::insert(std::vector<Face::Ptr> const & faces) {
+    node_connectivity_.insert(faces);
+}
+
+void
+MeshConnectivity::insert(std::vector<Cell::Ptr> const & cells) {
+    node_connectivity_.insert(cells);
+    face_connectivity_.insert(cells);
+}
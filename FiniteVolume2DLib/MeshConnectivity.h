@@ -34,6 +34,8 @@ public:
     // FROM IMeshConnectivity
     void                                    insert(Face::Ptr const & face);
     void                                    insert(Cell::Ptr const & cell);
+    void                                    insert(std::vector<Face::Ptr> const & faces);
+    void                                    insert(std::vector<Cell::Ptr> const & cells);
     boost::optional<EntityCollection<Node>> getNodeNeighbors(Node::Ptr const & node) const;
     boost::optional<EntityCollection<Face>> getFacesAttachedToNode(Node::Ptr const & node) const;
     boost::optional<EntityCollection<Cell>> getCellsAttachedToNode(Node::Ptr const & node) const;
@@ -0,0 +1,341 @@
+#include "MeshGenerator.h"
+
+#include "IMeshBuilder.h"
+#include "Util.h"
+
+#include <boost/format.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <algorithm>
+
+
+namespace {
+    typedef IGeometricEntity::Id_t Id_t;
+
+    // uniformly distributed in [-1, 1); independent of the standard library's distributions
+    double symmetricRandom(std::mt19937 & rng) {
+        return 2.0 * (rng() / 4294967296.0) - 1.0;
+    }
+
+    char boundaryConditionChar(BoundaryConditionCollection::Type bc_type) {
+        return bc_type == BoundaryConditionCollection::NEUMANN ? 'n' : 'd';
+    }
+
+}
+
+MeshGenerator::MeshGenerator(double x0, double y0, double x1, double y1, unsigned int nx, unsigned int ny)
+    : x0_(x0), y0_(y0), x1_(x1), y1_(y1), nx_(nx), ny_(ny),
+      perturbation_(0.0), perturbation_seed_(1), random_diagonals_(false), diagonal_seed_(1) {
+
+    for (int side = 0; side < 4; ++side) {
+        bc_types_[side] = BoundaryConditionCollection::DIRICHLET;
+        bc_values_[side] = 0.0;
+    }
+}
+
+void
+MeshGenerator::setBoundaryCondition(Side side, BoundaryConditionCollection::Type bc_type, double bc_value) {
+    bc_types_[side] = bc_type;
+    bc_values_[side] = bc_value;
+}
+
+void
+MeshGenerator::setPerturbation(double fraction, unsigned int seed) {
+    perturbation_ = std::max(0.0, std::min(fraction, maxPerturbation()));
+    perturbation_seed_ = seed;
+}
+
+void
+MeshGenerator::setRandomDiagonals(bool random, unsigned int seed) {
+    random_diagonals_ = random;
+    diagonal_seed_ = seed;
+}
+
+std::size_t
+MeshGenerator::getNumberOfNodes() const {
+    return static_cast<std::size_t>(nx_ + 1) * (ny_ + 1);
+}
+
+std::size_t
+MeshGenerator::getNumberOfFaces() const {
+    std::size_t nx = nx_;
+    std::size_t ny = ny_;
+
+    // horizontal, vertical and diagonal faces
+    return (ny + 1) * nx + ny * (nx + 1) + nx * ny;
+}
+
+std::size_t
+MeshGenerator::getNumberOfCells() const {
+    return 2 * static_cast<std::size_t>(nx_) * ny_;
+}
+
+bool
+MeshGenerator::generate(MeshData & data) const {
+    if (nx_ == 0 || ny_ == 0 || !(x1_ > x0_) || !(y1_ > y0_)) {
+        boost::format format = boost::format("MeshGenerator::generate: Invalid rectangle [%1%, %2%] x [%3%, %4%] with %5% x %6% quads!\n")
+            % x0_ % x1_ % y0_ % y1_ % nx_ % ny_;
+        return Util::error(format.str());
+    }
+
+    std::size_t const nx = nx_;
+    std::size_t const ny = ny_;
+
+    double const dx = (x1_ - x0_) / nx;
+    double const dy = (y1_ - y0_) / ny;
+
+    /*
+     * Nodes: id = j * (nx + 1) + i
+     */
+    std::size_t nnodes = getNumberOfNodes();
+    data.node_ids.resize(nnodes);
+    data.node_types.resize(nnodes);
+    data.node_x.resize(nnodes);
+    data.node_y.resize(nnodes);
+
+    std::mt19937 node_rng(perturbation_seed_);
+    double const radius = perturbation_ * std::min(dx, dy);
+
+    for (std::size_t j = 0; j <= ny; ++j) {
+        for (std::size_t i = 0; i <= nx; ++i) {
+            std::size_t n = j * (nx + 1) + i;
+            bool on_boundary = i == 0 || i == nx || j == 0 || j == ny;
+
+            data.node_ids[n] = n;
+            data.node_types[n] = on_boundary ? IGeometricEntity::BOUNDARY : IGeometricEntity::INTERIOR;
+
+            // avoid round-off at the far boundaries
+            data.node_x[n] = i == nx ? x1_ : x0_ + i * dx;
+            data.node_y[n] = j == ny ? y1_ : y0_ + j * dy;
+
+            if (!on_boundary && radius > 0.0) {
+                // displacement uniformly distributed within a disc
+                double u, v;
+                do {
+                    u = symmetricRandom(node_rng);
+                    v = symmetricRandom(node_rng);
+                } while (u * u + v * v > 1.0);
+
+                data.node_x[n] += radius * u;
+                data.node_y[n] += radius * v;
+            }
+        }
+    }
+
+    /*
+     * Faces: horizontal faces run left to right, vertical ones bottom to top
+     * and diagonals south-west to north-east or south-east to north-west.
+     */
+    std::size_t const nhorizontal = (ny + 1) * nx;
+    std::size_t const nvertical = ny * (nx + 1);
+
+    auto node = [nx](std::size_t i, std::size_t j) -> Id_t { return j * (nx + 1) + i; };
+    auto horizontal = [nx](std::size_t i, std::size_t j) -> Id_t { return j * nx + i; };
+    auto vertical = [nx, nhorizontal](std::size_t i, std::size_t j) -> Id_t { return nhorizontal + j * (nx + 1) + i; };
+    auto diagonal = [nx, nhorizontal, nvertical](std::size_t i, std::size_t j) -> Id_t { return nhorizontal + nvertical + j * nx + i; };
+
+    std::size_t nfaces = getNumberOfFaces();
+    data.face_ids.resize(nfaces);
+    data.face_types.resize(nfaces);
+    data.face_nodes.resize(2 * nfaces);
+
+    for (std::size_t j = 0; j <= ny; ++j) {
+        for (std::size_t i = 0; i < nx; ++i) {
+            Id_t f = horizontal(i, j);
+            data.face_ids[f] = f;
+            data.face_types[f] = j == 0 || j == ny ? IGeometricEntity::BOUNDARY : IGeometricEntity::INTERIOR;
+            data.face_nodes[2 * f] = node(i, j);
+            data.face_nodes[2 * f + 1] = node(i + 1, j);
+        }
+    }
+
+    for (std::size_t j = 0; j < ny; ++j) {
+        for (std::size_t i = 0; i <= nx; ++i) {
+            Id_t f = vertical(i, j);
+            data.face_ids[f] = f;
+            data.face_types[f] = i == 0 || i == nx ? IGeometricEntity::BOUNDARY : IGeometricEntity::INTERIOR;
+            data.face_nodes[2 * f] = node(i, j);
+            data.face_nodes[2 * f + 1] = node(i, j + 1);
+        }
+    }
+
+    std::vector<char> sw_ne(nx * ny, 1);
+    if (random_diagonals_) {
+        std::mt19937 diagonal_rng(diagonal_seed_);
+        std::for_each(sw_ne.begin(), sw_ne.end(), [&diagonal_rng](char & c) {
+            c = (diagonal_rng() >> 31) ? 1 : 0;
+        });
+    }
+
+    for (std::size_t j = 0; j < ny; ++j) {
+        for (std::size_t i = 0; i < nx; ++i) {
+            Id_t f = diagonal(i, j);
+            data.face_ids[f] = f;
+            data.face_types[f] = IGeometricEntity::INTERIOR;
+
+            if (sw_ne[j * nx + i]) {
+                data.face_nodes[2 * f] = node(i, j);
+                data.face_nodes[2 * f + 1] = node(i + 1, j + 1);
+            }
+            else {
+                data.face_nodes[2 * f] = node(i + 1, j);
+                data.face_nodes[2 * f + 1] = node(i, j + 1);
+            }
+        }
+    }
+
+    /*
+     * Cells: two triangles per quad. The vertices of a cell are taken from
+     * its faces in the given order, so the first face is chosen to run
+     * counter-clockwise around the cell which yields a positive cell volume.
+     */
+    std::size_t ncells = getNumberOfCells();
+    data.cell_ids.resize(ncells);
+    data.cell_offsets.resize(ncells + 1);
+    data.cell_faces.resize(3 * ncells);
+
+    for (std::size_t j = 0; j < ny; ++j) {
+        for (std::size_t i = 0; i < nx; ++i) {
+            std::size_t c = 2 * (j * nx + i);
+
+            Id_t bottom = horizontal(i, j);
+            Id_t top = horizontal(i, j + 1);
+            Id_t left = vertical(i, j);
+            Id_t right = vertical(i + 1, j);
+            Id_t diag = diagonal(i, j);
+
+            Id_t * faces = &data.cell_faces[3 * c];
+            if (sw_ne[j * nx + i]) {
+                faces[0] = bottom; faces[1] = right; faces[2] = diag;
+                faces[3] = diag;   faces[4] = top;   faces[5] = left;
+            }
+            else {
+                faces[0] = bottom; faces[1] = diag;  faces[2] = left;
+                faces[3] = right;  faces[4] = top;   faces[5] = diag;
+            }
+
+            data.cell_ids[c] = c;
+            data.cell_ids[c + 1] = c + 1;
+            data.cell_offsets[c] = 3 * c;
+            data.cell_offsets[c + 1] = 3 * c + 3;
+        }
+    }
+    data.cell_offsets[ncells] = 3 * ncells;
+
+    /*
+     * Boundary conditions
+     */
+    std::size_t nbfaces = 2 * (nx + ny);
+    data.bc_face_ids.clear();
+    data.bc_types.clear();
+    data.bc_values.clear();
+    data.bc_face_ids.reserve(nbfaces);
+    data.bc_types.reserve(nbfaces);
+    data.bc_values.reserve(nbfaces);
+
+    auto add_bc = [&](Id_t face_id, Side side) {
+        data.bc_face_ids.push_back(face_id);
+        data.bc_types.push_back(bc_types_[side]);
+        data.bc_values.push_back(bc_values_[side]);
+    };
+
+    for (std::size_t i = 0; i < nx; ++i)
+        add_bc(horizontal(i, 0), BOTTOM);
+    for (std::size_t i = 0; i < nx; ++i)
+        add_bc(horizontal(i, ny), TOP);
+    for (std::size_t j = 0; j < ny; ++j) {
+        add_bc(vertical(0, j), LEFT);
+        add_bc(vertical(nx, j), RIGHT);
+    }
+
+    return true;
+}
+
+bool
+MeshGenerator::generate(IMeshBuilder & builder, BoundaryConditionCollection & bc) const {
+    MeshData data;
+    if (!generate(data))
+        return false;
+
+    if (!builder.buildNodes(data.node_ids, data.node_types, data.node_x, data.node_y))
+        return Util::error("MeshGenerator::generate: Cannot build vertices!\n");
+
+    if (!builder.buildFaces(data.face_ids, data.face_types, data.face_nodes))
+        return Util::error("MeshGenerator::generate: Cannot build faces!\n");
+
+    if (!builder.buildCells(data.cell_ids, data.cell_offsets, data.cell_faces))
+        return Util::error("MeshGenerator::generate: Cannot build cells!\n");
+
+    for (std::size_t i = 0; i < data.bc_face_ids.size(); ++i)
+        bc.add(data.bc_face_ids[i], data.bc_types[i], data.bc_values[i]);
+
+    return true;
+}
+
+bool
+MeshGenerator::write(std::string const & mesh_filename) const {
+    MeshData data;
+    if (!generate(data))
+        return false;
+
+    std::ofstream out(mesh_filename.c_str());
+    if (!out) {
+        boost::format format = boost::format("MeshGenerator::write: Cannot open mesh file %1%!\n") % mesh_filename;
+        return Util::error(format.str());
+    }
+
+    out << "# Generated triangle mesh, " << nx_ << " x " << ny_ << " quads" << std::endl;
+    write(data, out);
+
+    if (!out) {
+        boost::format format = boost::format("MeshGenerator::write: Cannot write mesh file %1%!\n") % mesh_filename;
+        return Util::error(format.str());
+    }
+    return true;
+}
+
+void
+MeshGenerator::write(MeshData const & data, std::ostream & out) {
+    out << std::setprecision(17);
+
+    out << "\n# 1. vertex index, 2. 0: internal vertex, 1: boundary vertex, 3. and 4. vertex coordinates\n";
+    out << "vertices\n\n";
+    for (std::size_t i = 0; i < data.node_ids.size(); ++i) {
+        out << data.node_ids[i] << ' ' << (data.node_types[i] == IGeometricEntity::BOUNDARY ? 1 : 0) << ' '
+            << data.node_x[i] << ' ' << data.node_y[i] << '\n';
+    }
+
+    out << "\n# 1. face index, 2. 0: internal face, 1: boundary face, 3... vertex indices\n";
+    out << "faces\n\n";
+    for (std::size_t i = 0; i < data.face_ids.size(); ++i) {
+        out << data.face_ids[i] << ' ' << (data.face_types[i] == IGeometricEntity::BOUNDARY ? 1 : 0) << ' '
+            << data.face_nodes[2 * i] << ' ' << data.face_nodes[2 * i + 1] << '\n';
+    }
+
+    out << "\n# 1. cell index, 2... face indices\n";
+    out << "cells\n\n";
+    for (std::size_t i = 0; i < data.cell_ids.size(); ++i) {
+        out << data.cell_ids[i];
+        for (std::size_t k = data.cell_offsets[i]; k < data.cell_offsets[i + 1]; ++k)
+            out << ' ' << data.cell_faces[k];
+        out << '\n';
+    }
+
+    out << "\n# Dirichlet: face index, d, value\n# von Neumann: face index, n, value\n";
+    out << "BoundaryConditions\n\n";
+    for (std::size_t i = 0; i < data.bc_face_ids.size(); ++i)
+        out << data.bc_face_ids[i] << ' ' << boundaryConditionChar(data.bc_types[i]) << ' ' << data.bc_values[i] << '\n';
+}
+
+double
+MeshGenerator::maxPerturbation() {
+    /* With displacements of at most r * min(dx, dy) an edge vector of a
+     * cell changes by at most 2 r in units of the cell size, so the doubled
+     * cell area (1 for the undistorted triangles) stays above
+     * 1 - 2 r (1 + sqrt(2)) - 4 r^2 > 0.
+     */
+    return 0.15;
+}
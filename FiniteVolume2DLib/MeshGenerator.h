@@ -0,0 +1,102 @@
+/*
+ * Name  : MeshGenerator
+ * Path  :
+ * Use   : Generates triangulated rectangles of arbitrary size
+ *         including boundary conditions, e.g. for scaling tests.
+ *         Each of the nx * ny quads is split into two triangles
+ *         along a diagonal which is either always south-west to
+ *         north-east or chosen randomly. Interior nodes may be
+ *         displaced randomly to obtain distorted meshes.
+ *         The mesh is fed to a mesh builder via the bulk interface
+ *         or written in the ascii mesh format.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include "IGeometricEntity.h"
+#include "BoundaryConditionCollection.h"
+
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+class IMeshBuilder;
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2DLIB MeshGenerator {
+public:
+    enum Side {BOTTOM, RIGHT, TOP, LEFT};
+
+    // all entity data of a generated mesh
+    struct MeshData {
+        std::vector<IGeometricEntity::Id_t>     node_ids;
+        std::vector<IGeometricEntity::Entity_t> node_types;
+        std::vector<double>                     node_x;
+        std::vector<double>                     node_y;
+
+        // two vertex ids per face
+        std::vector<IGeometricEntity::Id_t>     face_ids;
+        std::vector<IGeometricEntity::Entity_t> face_types;
+        std::vector<IGeometricEntity::Id_t>     face_nodes;
+
+        // face ids of cell i: cell_faces[cell_offsets[i]] .. cell_faces[cell_offsets[i + 1] - 1]
+        std::vector<IGeometricEntity::Id_t>     cell_ids;
+        std::vector<std::size_t>                cell_offsets;
+        std::vector<IGeometricEntity::Id_t>     cell_faces;
+
+        // one entry per boundary face
+        std::vector<IGeometricEntity::Id_t>              bc_face_ids;
+        std::vector<BoundaryConditionCollection::Type>   bc_types;
+        std::vector<double>                              bc_values;
+    };
+
+public:
+    // rectangle [x0, x1] x [y0, y1] with nx * ny quads
+    MeshGenerator(double x0, double y0, double x1, double y1, unsigned int nx, unsigned int ny);
+
+    // default for all sides: Dirichlet, value 0
+    void                setBoundaryCondition(Side side, BoundaryConditionCollection::Type bc_type, double bc_value);
+
+    // displace interior nodes randomly by up to fraction * min(dx, dy);
+    // fraction is limited to maxPerturbation() so all cells keep a positive volume
+    void                setPerturbation(double fraction, unsigned int seed = 1);
+
+    // choose the diagonal of every quad randomly
+    void                setRandomDiagonals(bool random, unsigned int seed = 1);
+
+    std::size_t         getNumberOfNodes() const;
+    std::size_t         getNumberOfFaces() const;
+    std::size_t         getNumberOfCells() const;
+
+    bool                generate(MeshData & data) const;
+    bool                generate(IMeshBuilder & builder, BoundaryConditionCollection & bc) const;
+
+    bool                write(std::string const & mesh_filename) const;
+    static void         write(MeshData const & data, std::ostream & out);
+
+    static double       maxPerturbation();
+
+private:
+    double                            x0_;
+    double                            y0_;
+    double                            x1_;
+    double                            y1_;
+    unsigned int                      nx_;
+    unsigned int                      ny_;
+
+    BoundaryConditionCollection::Type bc_types_[4];
+    double                            bc_values_[4];
+
+    double                            perturbation_;
+    unsigned int                      perturbation_seed_;
+    bool                              random_diagonals_;
+    unsigned int                      diagonal_seed_;
+};
+
+#pragma warning(default:4251)
@@ -0,0 +1,365 @@
+#include "MeshGeometry.h"
+#include "Mesh.h"
+#include "InstructionSet.h"
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+#if defined(FV2D_AVX2_KERNELS)
+#include <immintrin.h>
+#endif
+
+
+namespace {
+    typedef std::unordered_map<IGeometricEntity::Id_t, boost::uint64_t> NodeIndex_t;
+
+    void
+    addNodes(Thread<Node> const & thread, MeshGeometry::Array_t & x, MeshGeometry::Array_t & y, NodeIndex_t & node_index) {
+        std::for_each(thread.begin(), thread.end(), [&](Node::Ptr const & node) {
+            Vertex location = node->location();
+
+            node_index[node->id()] = x.size();
+            x.push_back(location.x());
+            y.push_back(location.y());
+        });
+    }
+
+    typedef std::unordered_map<IGeometricEntity::Id_t, boost::uint64_t> FaceIndex_t;
+
+    void
+    addFaces(Thread<Face> const & thread, NodeIndex_t const & node_index, MeshGeometry::Index_t & face_nodes, FaceIndex_t & face_index) {
+        std::for_each(thread.begin(), thread.end(), [&](Face::Ptr const & face) {
+            EntityCollection<Node> const & nodes = face->getNodes();
+
+            face_index[face->id()] = face_nodes.size() / 2;
+
+            face_nodes.push_back(node_index.at(nodes.getEntity(0)->id()));
+            face_nodes.push_back(node_index.at(nodes.getEntity(1)->id()));
+        });
+    }
+
+#if defined(FV2D_AVX2_KERNELS)
+    // up to the last full vector, returns the number of entries done
+    FV2D_TARGET_AVX2 std::size_t
+    faceKernelAVX2(std::size_t n, double const * x0, double const * y0, double const * x1, double const * y1,
+                   double * area, double * nx, double * ny, double * cx, double * cy) {
+        std::size_t i = 0;
+
+        __m256d const zero = _mm256_setzero_pd();
+        __m256d const half = _mm256_set1_pd(0.5);
+
+        for (; i + 4 <= n; i += 4) {
+            __m256d vx0 = _mm256_loadu_pd(x0 + i);
+            __m256d vy0 = _mm256_loadu_pd(y0 + i);
+
+            __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x1 + i), vx0);
+            __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y1 + i), vy0);
+
+            _mm256_storeu_pd(area + i, _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy))));
+            _mm256_storeu_pd(nx + i, dy);
+            _mm256_storeu_pd(ny + i, _mm256_sub_pd(zero, dx));
+            _mm256_storeu_pd(cx + i, _mm256_add_pd(vx0, _mm256_mul_pd(half, dx)));
+            _mm256_storeu_pd(cy + i, _mm256_add_pd(vy0, _mm256_mul_pd(half, dy)));
+        }
+
+        return i;
+    }
+
+    FV2D_TARGET_AVX2 std::size_t
+    triangleKernelAVX2(std::size_t n, double const * x0, double const * y0, double const * x1, double const * y1,
+                       double const * x2, double const * y2, double * volume, double * cx, double * cy) {
+        std::size_t i = 0;
+
+        __m256d const half  = _mm256_set1_pd(0.5);
+        __m256d const third = _mm256_set1_pd(1.0 / 3.0);
+
+        for (; i + 4 <= n; i += 4) {
+            __m256d vx0 = _mm256_loadu_pd(x0 + i);
+            __m256d vy0 = _mm256_loadu_pd(y0 + i);
+            __m256d vx1 = _mm256_loadu_pd(x1 + i);
+            __m256d vy1 = _mm256_loadu_pd(y1 + i);
+            __m256d vx2 = _mm256_loadu_pd(x2 + i);
+            __m256d vy2 = _mm256_loadu_pd(y2 + i);
+
+            __m256d delta = _mm256_sub_pd(_mm256_mul_pd(vx0, vy1), _mm256_mul_pd(vx1, vy0));
+            delta = _mm256_add_pd(delta, _mm256_sub_pd(_mm256_mul_pd(vx1, vy2), _mm256_mul_pd(vx2, vy1)));
+            delta = _mm256_add_pd(delta, _mm256_sub_pd(_mm256_mul_pd(vx2, vy0), _mm256_mul_pd(vx0, vy2)));
+
+            _mm256_storeu_pd(volume + i, _mm256_mul_pd(half, delta));
+            _mm256_storeu_pd(cx + i, _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(vx0, vx1), vx2), third));
+            _mm256_storeu_pd(cy + i, _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(vy0, vy1), vy2), third));
+        }
+
+        return i;
+    }
+#endif
+}
+
+boost::uint64_t const MeshGeometry::NO_CELL = std::numeric_limits<boost::uint64_t>::max();
+
+MeshGeometry::MeshGeometry(Mesh const & mesh) {
+    NodeIndex_t node_index;
+    FaceIndex_t face_index;
+
+    addNodes(mesh.getNodeThread(IGeometricEntity::INTERIOR), x_, y_, node_index);
+    addNodes(mesh.getNodeThread(IGeometricEntity::BOUNDARY), x_, y_, node_index);
+
+    addFaces(mesh.getFaceThread(IGeometricEntity::INTERIOR), node_index, face_nodes_, face_index);
+    addFaces(mesh.getFaceThread(IGeometricEntity::BOUNDARY), node_index, face_nodes_, face_index);
+
+    face_cells_.assign(face_nodes_.size(), NO_CELL);
+
+    Thread<Cell> const & cell_thread = mesh.getCellThread();
+
+    cell_start_.reserve(cell_thread.size() + 1);
+    cell_start_.push_back(0);
+
+    std::for_each(cell_thread.begin(), cell_thread.end(), [&](Cell::Ptr const & cell) {
+        EntityCollection<Node> const & nodes = cell->getNodes();
+        EntityCollection<Face> const & faces = cell->getFaces();
+
+        boost::uint64_t cell_index = cell_start_.size() - 1;
+
+        for (EntityCollection<Node>::size_type i = 0; i < nodes.size(); ++i)
+            cell_nodes_.push_back(node_index.at(nodes.getEntity(i)->id()));
+
+        for (EntityCollection<Face>::size_type i = 0; i < faces.size(); ++i) {
+            boost::uint64_t face = face_index.at(faces.getEntity(i)->id());
+            face_cells_[2 * face + (face_cells_[2 * face] == NO_CELL ? 0 : 1)] = cell_index;
+        }
+
+        cell_start_.push_back(cell_nodes_.size());
+    });
+
+    update();
+}
+
+std::size_t
+MeshGeometry::getNumberOfNodes() const {
+    return x_.size();
+}
+
+std::size_t
+MeshGeometry::getNumberOfFaces() const {
+    return face_area_.size();
+}
+
+std::size_t
+MeshGeometry::getNumberOfCells() const {
+    return cell_volume_.size();
+}
+
+void
+MeshGeometry::setNodeCoordinates(Array_t const & x, Array_t const & y) {
+    if (x.size() != x_.size() || y.size() != y_.size())
+        throw std::out_of_range("MeshGeometry::setNodeCoordinates(): Wrong number of nodes");
+
+    x_ = x;
+    y_ = y;
+}
+
+void
+MeshGeometry::update() {
+    // faces: gather the end points, then one pass of the kernel
+    std::size_t nfaces = face_nodes_.size() / 2;
+
+    Array_t x0(nfaces), y0(nfaces), x1(nfaces), y1(nfaces);
+
+    for (std::size_t i = 0; i < nfaces; ++i) {
+        boost::uint64_t v0 = face_nodes_[2 * i];
+        boost::uint64_t v1 = face_nodes_[2 * i + 1];
+
+        x0[i] = x_[v0];
+        y0[i] = y_[v0];
+        x1[i] = x_[v1];
+        y1[i] = y_[v1];
+    }
+
+    face_area_.resize(nfaces);
+    face_nx_.resize(nfaces);
+    face_ny_.resize(nfaces);
+    face_cx_.resize(nfaces);
+    face_cy_.resize(nfaces);
+
+    if (nfaces > 0)
+        faceKernel(nfaces, &x0[0], &y0[0], &x1[0], &y1[0], &face_area_[0], &face_nx_[0], &face_ny_[0], &face_cx_[0], &face_cy_[0]);
+
+
+    // cells: the triangles by the kernel, other polygons one by one
+    std::size_t ncells = cell_start_.size() - 1;
+
+    cell_volume_.resize(ncells);
+    cell_cx_.resize(ncells);
+    cell_cy_.resize(ncells);
+
+    Index_t triangles;
+    Array_t tx[3], ty[3];
+
+    for (std::size_t cell = 0; cell < ncells; ++cell) {
+        boost::uint64_t start = cell_start_[cell];
+        boost::uint64_t n     = cell_start_[cell + 1] - start;
+
+        if (n == 3) {
+            triangles.push_back(cell);
+
+            for (int k = 0; k < 3; ++k) {
+                tx[k].push_back(x_[cell_nodes_[start + k]]);
+                ty[k].push_back(y_[cell_nodes_[start + k]]);
+            }
+
+            continue;
+        }
+
+        // see Cell::volume()
+        double delta = 0.0;
+        double cx    = 0.0;
+        double cy    = 0.0;
+
+        for (boost::uint64_t i = 0; i < n; ++i) {
+            boost::uint64_t v0 = cell_nodes_[start + i];
+            boost::uint64_t v1 = cell_nodes_[start + (i + 1) % n];
+
+            delta += (x_[v0] * y_[v1] - x_[v1] * y_[v0]);
+            cx += x_[v0];
+            cy += y_[v0];
+        }
+
+        cell_volume_[cell] = 0.5 * delta;
+        cell_cx_[cell] = n > 0 ? cx / double(n) : 0.0;
+        cell_cy_[cell] = n > 0 ? cy / double(n) : 0.0;
+    }
+
+    std::size_t ntriangles = triangles.size();
+    if (ntriangles == 0)
+        return;
+
+    Array_t volume(ntriangles), cx(ntriangles), cy(ntriangles);
+    triangleKernel(ntriangles, &tx[0][0], &ty[0][0], &tx[1][0], &ty[1][0], &tx[2][0], &ty[2][0], &volume[0], &cx[0], &cy[0]);
+
+    for (std::size_t i = 0; i < ntriangles; ++i) {
+        cell_volume_[triangles[i]] = volume[i];
+        cell_cx_[triangles[i]] = cx[i];
+        cell_cy_[triangles[i]] = cy[i];
+    }
+}
+
+MeshGeometry::Array_t const &
+MeshGeometry::nodeX() const {
+    return x_;
+}
+
+MeshGeometry::Array_t const &
+MeshGeometry::nodeY() const {
+    return y_;
+}
+
+MeshGeometry::Array_t const &
+MeshGeometry::faceArea() const {
+    return face_area_;
+}
+
+MeshGeometry::Array_t const &
+MeshGeometry::faceNormalX() const {
+    return face_nx_;
+}
+
+MeshGeometry::Array_t const &
+MeshGeometry::faceNormalY() const {
+    return face_ny_;
+}
+
+MeshGeometry::Array_t const &
+MeshGeometry::faceCentroidX() const {
+    return face_cx_;
+}
+
+MeshGeometry::Array_t const &
+MeshGeometry::faceCentroidY() const {
+    return face_cy_;
+}
+
+MeshGeometry::Index_t const &
+MeshGeometry::faceNodes() const {
+    return face_nodes_;
+}
+
+MeshGeometry::Index_t const &
+MeshGeometry::faceCells() const {
+    return face_cells_;
+}
+
+MeshGeometry::Index_t const &
+MeshGeometry::cellStart() const {
+    return cell_start_;
+}
+
+MeshGeometry::Index_t const &
+MeshGeometry::cellNodes() const {
+    return cell_nodes_;
+}
+
+MeshGeometry::Array_t const &
+MeshGeometry::cellVolume() const {
+    return cell_volume_;
+}
+
+MeshGeometry::Array_t const &
+MeshGeometry::cellCentroidX() const {
+    return cell_cx_;
+}
+
+MeshGeometry::Array_t const &
+MeshGeometry::cellCentroidY() const {
+    return cell_cy_;
+}
+
+void
+MeshGeometry::faceKernel(std::size_t n, double const * x0, double const * y0, double const * x1, double const * y1,
+                         double * area, double * nx, double * ny, double * cx, double * cy) {
+    std::size_t i = 0;
+
+#if defined(FV2D_AVX2_KERNELS)
+    if (InstructionSet::active() == InstructionSet::AVX2)
+        i = faceKernelAVX2(n, x0, y0, x1, y1, area, nx, ny, cx, cy);
+#endif
+
+    for (; i < n; ++i) {
+        double dx = x1[i] - x0[i];
+        double dy = y1[i] - y0[i];
+
+        area[i] = std::sqrt(dx * dx + dy * dy);
+        nx[i]   = dy;
+        ny[i]   = -dx;
+        cx[i]   = x0[i] + 0.5 * dx;
+        cy[i]   = y0[i] + 0.5 * dy;
+    }
+}
+
+void
+MeshGeometry::triangleKernel(std::size_t n, double const * x0, double const * y0, double const * x1, double const * y1,
+                             double const * x2, double const * y2, double * volume, double * cx, double * cy) {
+    std::size_t i = 0;
+
+#if defined(FV2D_AVX2_KERNELS)
+    if (InstructionSet::active() == InstructionSet::AVX2)
+        i = triangleKernelAVX2(n, x0, y0, x1, y1, x2, y2, volume, cx, cy);
+#endif
+
+    for (; i < n; ++i) {
+        double delta = (x0[i] * y1[i] - x1[i] * y0[i]);
+        delta += (x1[i] * y2[i] - x2[i] * y1[i]);
+        delta += (x2[i] * y0[i] - x0[i] * y2[i]);
+
+        volume[i] = 0.5 * delta;
+        cx[i]     = (x0[i] + x1[i] + x2[i]) * (1.0 / 3.0);
+        cy[i]     = (y0[i] + y1[i] + y2[i]) * (1.0 / 3.0);
+    }
+}
+
+char const *
+MeshGeometry::instructionSet() {
+    return InstructionSet::toString(InstructionSet::active());
+}
@@ -0,0 +1,115 @@
+/*
+ * Name  : MeshGeometry
+ * Path  :
+ * Use   : Face and cell geometry of a whole mesh.
+ *         The node coordinates are copied into contiguous arrays
+ *         (structure of arrays) once; the face areas, normals and
+ *         centroids and the cell volumes and centroids are then
+ *         computed in batches by the kernels below instead of one
+ *         entity at a time through Node::location().
+ *         The results follow the conventions of Face and Cell:
+ *         the normal of the face v0 -> v1 is (dy, -dx) with the
+ *         length of the face, the volume is signed (shoelace) and
+ *         the cell centroid is the mean of the nodes.
+ *         The kernels use AVX2 if the processor supports it (see
+ *         InstructionSet), a scalar loop otherwise.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include <vector>
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+
+
+class Mesh;
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2DLIB MeshGeometry {
+public:
+    typedef std::vector<double>          Array_t;
+    typedef std::vector<boost::uint64_t> Index_t;
+
+    // second cell of a boundary face
+    static boost::uint64_t const NO_CELL;
+
+public:
+    /* Faces: the interior face thread, then the boundary face thread.
+     * Cells: the cell thread. Nodes: the interior node thread, then
+     * the boundary node thread.
+     */
+    explicit MeshGeometry(Mesh const & mesh);
+
+    std::size_t     getNumberOfNodes() const;
+    std::size_t     getNumberOfFaces() const;
+    std::size_t     getNumberOfCells() const;
+
+    // after the node coordinates changed
+    void            setNodeCoordinates(Array_t const & x, Array_t const & y);
+    void            update();
+
+    Array_t const & nodeX() const;
+    Array_t const & nodeY() const;
+
+    Array_t const & faceArea() const;
+    Array_t const & faceNormalX() const;
+    Array_t const & faceNormalY() const;
+    Array_t const & faceCentroidX() const;
+    Array_t const & faceCentroidY() const;
+
+    // two nodes per face, v0 -> v1
+    Index_t const & faceNodes() const;
+
+    // two cells per face, the second is NO_CELL for boundary faces
+    Index_t const & faceCells() const;
+
+    // nodes of cell i: cellNodes()[cellStart()[i]], ..., cellNodes()[cellStart()[i + 1] - 1]
+    Index_t const & cellStart() const;
+    Index_t const & cellNodes() const;
+
+    Array_t const & cellVolume() const;
+    Array_t const & cellCentroidX() const;
+    Array_t const & cellCentroidY() const;
+
+    /* Kernels on the coordinates of the face end points, and of the
+     * triangle corners, respectively.
+     */
+    static void     faceKernel(std::size_t n, double const * x0, double const * y0, double const * x1, double const * y1,
+                               double * area, double * nx, double * ny, double * cx, double * cy);
+    static void     triangleKernel(std::size_t n, double const * x0, double const * y0, double const * x1, double const * y1,
+                                   double const * x2, double const * y2, double * volume, double * cx, double * cy);
+
+    // of the kernels, "AVX2" or "scalar", see InstructionSet
+    static char const * instructionSet();
+
+private:
+    // node coordinates
+    Array_t x_;
+    Array_t y_;
+
+    // two nodes and two cells per face
+    Index_t face_nodes_;
+    Index_t face_cells_;
+
+    Index_t cell_start_;
+    Index_t cell_nodes_;
+
+    Array_t face_area_;
+    Array_t face_nx_;
+    Array_t face_ny_;
+    Array_t face_cx_;
+    Array_t face_cy_;
+
+    Array_t cell_volume_;
+    Array_t cell_cx_;
+    Array_t cell_cy_;
+};
+
+#pragma warning(default:4251)
@@ -0,0 +1,187 @@
+#include "MeshQuality.h"
+#include "MeshGeometry.h"
+#include "GeometricHelper.h"
+#include "ParallelFor.hpp"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+
+MeshQuality::MeshQuality(MeshGeometry const & geometry, unsigned int nthreads) : geometry_(geometry), nthreads_(ParallelFor::numberOfThreads(nthreads)) {
+    update();
+}
+
+void
+MeshQuality::update() {
+    std::size_t nfaces = geometry_.getNumberOfFaces();
+    std::size_t ncells = geometry_.getNumberOfCells();
+
+    non_orthogonality_.resize(nfaces);
+    skewness_.resize(nfaces);
+    volume_ratio_.resize(nfaces);
+    aspect_ratio_.resize(ncells);
+
+    ParallelFor::forEachChunk(nfaces, nthreads_, [this](std::size_t begin, std::size_t end) { computeFaces(begin, end); });
+    ParallelFor::forEachChunk(ncells, nthreads_, [this](std::size_t begin, std::size_t end) { computeCells(begin, end); });
+}
+
+void
+MeshQuality::computeFaces(std::size_t begin, std::size_t end) {
+    if (begin == end)
+        return;
+
+    MeshGeometry::Index_t const & face_cells = geometry_.faceCells();
+    MeshGeometry::Array_t const & volume = geometry_.cellVolume();
+    MeshGeometry::Array_t const & ccx = geometry_.cellCentroidX();
+    MeshGeometry::Array_t const & ccy = geometry_.cellCentroidY();
+    MeshGeometry::Array_t const & area = geometry_.faceArea();
+    MeshGeometry::Array_t const & nx = geometry_.faceNormalX();
+    MeshGeometry::Array_t const & ny = geometry_.faceNormalY();
+    MeshGeometry::Array_t const & fcx = geometry_.faceCentroidX();
+    MeshGeometry::Array_t const & fcy = geometry_.faceCentroidY();
+
+    /* The face end points are centroid -/+ normal / 2 rotated back;
+     * the line through the cell centroids is P + t d.
+     */
+    std::size_t n = end - begin;
+    MeshGeometry::Array_t x0(n), y0(n), x1(n), y1(n), px(n), py(n), dx(n), dy(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t face = begin + i;
+
+        boost::uint64_t c1 = face_cells[2 * face];
+        boost::uint64_t c2 = face_cells[2 * face + 1];
+
+        // normal (dy, -dx) of the face v0 -> v1
+        x0[i] = fcx[face] + 0.5 * ny[face];
+        y0[i] = fcy[face] - 0.5 * nx[face];
+        x1[i] = fcx[face] - 0.5 * ny[face];
+        y1[i] = fcy[face] + 0.5 * nx[face];
+
+        px[i] = ccx[c1];
+        py[i] = ccy[c1];
+        dx[i] = (c2 == MeshGeometry::NO_CELL ? fcx[face] : ccx[c2]) - ccx[c1];
+        dy[i] = (c2 == MeshGeometry::NO_CELL ? fcy[face] : ccy[c2]) - ccy[c1];
+
+        double dist = std::sqrt(dx[i] * dx[i] + dy[i] * dy[i]);
+        double cos_angle = area[face] > 0 && dist > 0 ? std::fabs(nx[face] * dx[i] + ny[face] * dy[i]) / (area[face] * dist) : 1.0;
+        non_orthogonality_[face] = std::acos(std::min(cos_angle, 1.0));
+
+        if (c2 == MeshGeometry::NO_CELL)
+            volume_ratio_[face] = 1.0;
+        else {
+            double v1 = std::fabs(volume[c1]);
+            double v2 = std::fabs(volume[c2]);
+
+            volume_ratio_[face] = std::min(v1, v2) > 0 ? std::max(v1, v2) / std::min(v1, v2) : std::numeric_limits<double>::infinity();
+        }
+    }
+
+    MeshGeometry::Array_t s(n), t(n);
+    std::vector<GeometricHelper::IntersectionType> type(n);
+
+    GeometricHelper::intersectLines(n, &x0[0], &y0[0], &x1[0], &y1[0], &px[0], &py[0], &dx[0], &dy[0], &s[0], &t[0], &type[0]);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t face = begin + i;
+
+        if (face_cells[2 * face + 1] == MeshGeometry::NO_CELL)
+            skewness_[face] = 0.0;
+        else if (type[i] == GeometricHelper::UNIQUE_INTERSECTION || type[i] == GeometricHelper::EMPTY)
+            // |s - 1/2| |face| / (|face| / 2)
+            skewness_[face] = std::fabs(2.0 * s[i] - 1.0);
+        else
+            skewness_[face] = std::numeric_limits<double>::infinity();
+    }
+}
+
+void
+MeshQuality::computeCells(std::size_t begin, std::size_t end) {
+    MeshGeometry::Index_t const & cell_start = geometry_.cellStart();
+    MeshGeometry::Index_t const & cell_nodes = geometry_.cellNodes();
+    MeshGeometry::Array_t const & x = geometry_.nodeX();
+    MeshGeometry::Array_t const & y = geometry_.nodeY();
+
+    for (std::size_t cell = begin; cell < end; ++cell) {
+        boost::uint64_t start = cell_start[cell];
+        boost::uint64_t n     = cell_start[cell + 1] - start;
+
+        double min_length = std::numeric_limits<double>::max();
+        double max_length = 0.0;
+
+        // the faces are the edges between consecutive nodes
+        for (boost::uint64_t i = 0; i < n; ++i) {
+            boost::uint64_t v0 = cell_nodes[start + i];
+            boost::uint64_t v1 = cell_nodes[start + (i + 1) % n];
+
+            double length = std::sqrt((x[v1] - x[v0]) * (x[v1] - x[v0]) + (y[v1] - y[v0]) * (y[v1] - y[v0]));
+
+            min_length = std::min(min_length, length);
+            max_length = std::max(max_length, length);
+        }
+
+        aspect_ratio_[cell] = min_length > 0 ? max_length / min_length : std::numeric_limits<double>::infinity();
+    }
+}
+
+MeshQuality::Array_t const &
+MeshQuality::nonOrthogonality() const {
+    return non_orthogonality_;
+}
+
+MeshQuality::Array_t const &
+MeshQuality::skewness() const {
+    return skewness_;
+}
+
+MeshQuality::Array_t const &
+MeshQuality::volumeRatio() const {
+    return volume_ratio_;
+}
+
+MeshQuality::Array_t const &
+MeshQuality::aspectRatio() const {
+    return aspect_ratio_;
+}
+
+MeshQuality::Histogram
+MeshQuality::histogram(Array_t const & values, std::size_t nbins) {
+    Histogram result;
+    result.counts.assign(std::max<std::size_t>(nbins, 1), 0);
+    result.min = std::numeric_limits<double>::max();
+    result.max = -std::numeric_limits<double>::max();
+
+    double sum = 0.0;
+
+    std::for_each(values.begin(), values.end(), [&](double value) {
+        if (!std::isfinite(value)) {
+            result.nonfinite++;
+            return;
+        }
+
+        result.min = std::min(result.min, value);
+        result.max = std::max(result.max, value);
+        sum += value;
+    });
+
+    std::size_t nfinite = values.size() - result.nonfinite;
+    if (nfinite == 0) {
+        result.min = result.max = 0.0;
+        return result;
+    }
+
+    result.mean = sum / double(nfinite);
+
+    double width = (result.max - result.min) / double(result.counts.size());
+
+    std::for_each(values.begin(), values.end(), [&](double value) {
+        if (!std::isfinite(value))
+            return;
+
+        std::size_t bin = width > 0 ? std::size_t((value - result.min) / width) : 0;
+        result.counts[std::min(bin, result.counts.size() - 1)]++;
+    });
+
+    return result;
+}
@@ -0,0 +1,84 @@
+/*
+ * Name  : MeshQuality
+ * Path  :
+ * Use   : Quality metrics of all faces and cells of a mesh, computed
+ *         once from a MeshGeometry by several threads and kept in
+ *         contiguous arrays in the order of MeshGeometry.
+ *         Per face:
+ *         - non-orthogonality: angle (rad) between the face normal and
+ *           the line between the centroids of the two cells (boundary
+ *           faces: cell centroid -> face centroid),
+ *         - skewness: distance of the intersection of that line with
+ *           the face from the face midpoint, relative to half the face
+ *           length (0 for boundary faces, infinity if the line does not
+ *           cross the face's line),
+ *         - volume ratio: larger / smaller volume of the two cells
+ *           (1 for boundary faces).
+ *         Per cell:
+ *         - aspect ratio: longest / shortest face.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include <vector>
+#include <cstddef>
+
+
+class MeshGeometry;
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2DLIB MeshQuality {
+public:
+    typedef std::vector<double> Array_t;
+
+    /* nbins bins of equal width between the smallest and the largest
+     * finite value; the values which are not finite are only counted.
+     */
+    struct Histogram {
+        Histogram() : min(0), max(0), mean(0), nonfinite(0) {}
+
+        double                   min;
+        double                   max;
+        double                   mean;
+        std::vector<std::size_t> counts;
+        std::size_t              nonfinite;
+    };
+
+public:
+    // nthreads = 0: one thread per core
+    explicit MeshQuality(MeshGeometry const & geometry, unsigned int nthreads = 0);
+
+    // after MeshGeometry::update()
+    void             update();
+
+    Array_t const &  nonOrthogonality() const;
+    Array_t const &  skewness() const;
+    Array_t const &  volumeRatio() const;
+    Array_t const &  aspectRatio() const;
+
+    static Histogram histogram(Array_t const & values, std::size_t nbins);
+
+private:
+    MeshQuality(MeshQuality const & in);
+    MeshQuality & operator=(MeshQuality const & in);
+
+    void             computeFaces(std::size_t begin, std::size_t end);
+    void             computeCells(std::size_t begin, std::size_t end);
+
+private:
+    MeshGeometry const & geometry_;
+    unsigned int         nthreads_;
+
+    Array_t              non_orthogonality_;
+    Array_t              skewness_;
+    Array_t              volume_ratio_;
+    Array_t              aspect_ratio_;
+};
+
+#pragma warning(default:4251)
@@ -3,6 +3,52 @@
 #include "Face.h"
 #include "EntityCollection.hpp"
 
+#include <algorithm>
+
+
+namespace {
+    template<typename Entity>
+    struct Link {
+        IGeometricEntity::Id_t key;
+        typename Entity::Ptr   entity;
+    };
+
+    /* Appends the linked entities to the collections stored under their keys.
+     * The links are sorted by key once (stable, so the order of insertion is kept
+     * within a key) so every key is looked up only once and new keys, which are
+     * usually larger than all existing ones, are appended at the end of the map.
+     */
+    template<typename Entity, typename Map>
+    void insertLinks(Map & map, std::vector<Link<Entity>> & links, bool unique) {
+        std::stable_sort(links.begin(), links.end(), [](Link<Entity> const & lhs, Link<Entity> const & rhs) {
+            return lhs.key < rhs.key;
+        });
+
+        std::size_t i = 0;
+        while (i < links.size()) {
+            IGeometricEntity::Id_t key = links[i].key;
+
+            typename Map::iterator it;
+            if (map.empty() || map.rbegin()->first < key)
+                it = map.insert(map.end(), std::make_pair(key, EntityCollection<Entity>()));
+            else {
+                it = map.lower_bound(key);
+                if (it == map.end() || it->first != key)
+                    it = map.insert(it, std::make_pair(key, EntityCollection<Entity>()));
+            }
+
+            EntityCollection<Entity> & collection = it->second;
+            for (; i < links.size() && links[i].key == key; ++i) {
+                if (unique)
+                    collection.insertUnique(links[i].entity);
+                else
+                    collection.insert(links[i].entity);
+            }
+        }
+    }
+
+}
+
 
 void
 NodeConnectivity::insert(Face::Ptr const & face) {
@@ -38,6 +84,58 @@ NodeConnectivity::insert(Cell::Ptr const & cell) {
     }
 }
 
+void
+NodeConnectivity::insert(std::vector<Face::Ptr> const & faces) {
+    typedef EntityCollection<Node>::size_type size_type;
+
+    std::vector<Link<Node>> neighbor_links;
+    std::vector<Link<Face>> face_links;
+    neighbor_links.reserve(4 * faces.size());
+    face_links.reserve(2 * faces.size());
+
+    std::for_each(faces.begin(), faces.end(), [&](Face::Ptr const & face) {
+        EntityCollection<Node> const & nodes = face->getNodes();
+
+        for (size_type i = 0; i < nodes.size(); ++i) {
+            size_type next = (i + 1) % nodes.size();
+
+            Node::Ptr const & v0 = nodes.getEntity(i);
+            Node::Ptr const & v1 = nodes.getEntity(next);
+
+            Link<Node> l01 = { v0->id(), v1 };
+            Link<Node> l10 = { v1->id(), v0 };
+            neighbor_links.push_back(l01);
+            neighbor_links.push_back(l10);
+
+            Link<Face> lf = { v0->id(), face };
+            face_links.push_back(lf);
+        }
+    });
+
+    insertLinks(node_neighbors_, neighbor_links, true);
+    insertLinks(node_faces_, face_links, true);
+}
+
+void
+NodeConnectivity::insert(std::vector<Cell::Ptr> const & cells) {
+    // it is assumed all the cell faces have already been inserted
+    typedef EntityCollection<Node>::size_type size_type;
+
+    std::vector<Link<Cell>> cell_links;
+    cell_links.reserve(3 * cells.size());
+
+    std::for_each(cells.begin(), cells.end(), [&cell_links](Cell::Ptr const & cell) {
+        EntityCollection<Node> const & nodes = cell->getNodes();
+
+        for (size_type i = 0; i < nodes.size(); ++i) {
+            Link<Cell> l = { nodes.getEntity(i)->id(), cell };
+            cell_links.push_back(l);
+        }
+    });
+
+    insertLinks(node_cells_, cell_links, false);
+}
+
 boost::optional<EntityCollection<Node>>
 NodeConnectivity::getNodeNeighbors(Node::Ptr const & vertex) const {
     NodeNeighbor_t::const_iterator it = node_neighbors_.find(vertex->id());
@@ -11,6 +11,7 @@
 #include "Cell.h"
 
 #include <map>
+#include <vector>
 
 #include <boost/optional.hpp>
 
@@ -21,6 +22,10 @@ class NodeConnectivity {
 public:
     void                                    insert(Face::Ptr const & face);
     void                                    insert(Cell::Ptr const & cell);
+
+    // bulk versions, same result as inserting the entities one by one
+    void                                    insert(std::vector<Face::Ptr> const & faces);
+    void                                    insert(std::vector<Cell::Ptr> const & cells);
     boost::optional<EntityCollection<Node>> getNodeNeighbors(Node::Ptr const & vertex) const;
     boost::optional<EntityCollection<Face>> getFacesAttachedToNode(Node::Ptr const & vertex) const;
     boost::optional<EntityCollection<Cell>> getCellsAttachedToNode(Node::Ptr const & vertex) const;
@@ -27,6 +27,33 @@ Node::Ptr NodeManager::createNode(IGeometricEntity::Id_t mesh_id, IGeometricEnti
     return node;
 }
 
+bool
+NodeManager::createNodes(std::vector<IGeometricEntity::Id_t> const & mesh_ids, std::vector<IGeometricEntity::Entity_t> const & entity_types,
+                         std::vector<double> const & x, std::vector<double> const & y, std::vector<Node::Ptr> & nodes) {
+    std::size_t n = mesh_ids.size();
+
+    reserve(n);
+    nodes.clear();
+    nodes.reserve(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        Node::Ptr node = Node::create(getNewEntityIndex(), mesh_ids[i], entity_types[i], x[i], y[i]);
+
+        if (!registerEntity(mesh_ids[i], node)) {
+            unregisterEntities(mesh_ids, i);
+            nodes.clear();
+
+            boost::format format = boost::format("VertexManager::createNodes: Vertex with mesh id %1% already created!\n") % mesh_ids[i];
+            return Util::error(format.str());
+        }
+        nodes.push_back(node);
+    }
+
+    insertEntities(nodes);
+
+    return true;
+}
+
 NodeManager::Ptr
 NodeManager::create() {
     return Ptr(new NodeManager);
@@ -23,6 +23,10 @@ public:
 public:
     Node::Ptr createNode(IGeometricEntity::Id_t mesh_id, IGeometricEntity::Entity_t entity_type, double x, double y);
 
+    // bulk version: if any mesh id is taken, no node is created at all
+    bool      createNodes(std::vector<IGeometricEntity::Id_t> const & mesh_ids, std::vector<IGeometricEntity::Entity_t> const & entity_types,
+                          std::vector<double> const & x, std::vector<double> const & y, std::vector<Node::Ptr> & nodes);
+
     static Ptr create();
 
 private:
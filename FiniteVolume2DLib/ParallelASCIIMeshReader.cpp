@@ -0,0 +1,570 @@
+#include "ParallelASCIIMeshReader.h"
+
+#include "Util.h"
+#include "IMeshBuilder.h"
+#include "IGeometricEntity.h"
+#include "ParallelFor.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+#include <boost/algorithm/string.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <mutex>
+
+namespace FS = boost::filesystem;
+
+
+namespace {
+    typedef IGeometricEntity::Id_t Id_t;
+
+    struct Line {
+        char const * begin;
+        char const * end;
+    };
+
+    // error with the lowest line number found by any chunk. As each
+    // chunk stops at its first error, this is the first error of the
+    // section.
+    class ParseError {
+    public:
+        ParseError() : line_(0) {}
+
+        void set(char const * fmt, int line_number) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (line_ == 0 || line_number < line_) {
+                line_ = line_number;
+                msg_ = (boost::format(fmt) % line_number).str();
+            }
+        }
+
+        // false after reporting the error, if any
+        bool report() const {
+            return line_ == 0 || Util::error(msg_);
+        }
+
+    private:
+        // no copies due to the mutex
+        ParseError(ParseError const & in);
+        ParseError & operator=(ParseError const & in);
+
+    private:
+        std::mutex  mutex_;
+        int         line_;
+        std::string msg_;
+    };
+
+    // all record lines of one mesh file section
+    struct Section {
+        std::vector<std::size_t> lines;
+    };
+
+
+    inline bool isSeparator(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    // Splits a line into tokens separated by blanks
+    class LineTokenizer {
+    public:
+        explicit LineTokenizer(Line const & line) : pos_(line.begin), end_(line.end) {}
+
+        bool next(char const *& tbegin, char const *& tend) {
+            while (pos_ != end_ && isSeparator(*pos_))
+                ++pos_;
+
+            if (pos_ == end_)
+                return false;
+
+            tbegin = pos_;
+            while (pos_ != end_ && !isSeparator(*pos_))
+                ++pos_;
+            tend = pos_;
+
+            return true;
+        }
+
+    private:
+        char const * pos_;
+        char const * end_;
+    };
+
+    unsigned int countTokens(Line const & line) {
+        LineTokenizer tokenizer(line);
+        char const * tbegin;
+        char const * tend;
+
+        unsigned int ntokens = 0;
+        while (tokenizer.next(tbegin, tend))
+            ++ntokens;
+        return ntokens;
+    }
+
+    bool parseId(char const * tbegin, char const * tend, Id_t & id) {
+        if (tbegin == tend)
+            return false;
+
+        Id_t value = 0;
+        for (char const * p = tbegin; p != tend; ++p) {
+            if (*p < '0' || *p > '9')
+                return false;
+            value = value * 10 + static_cast<Id_t>(*p - '0');
+        }
+        id = value;
+        return true;
+    }
+
+    // same semantics as boost::lexical_cast<bool>: only "0" and "1" are accepted
+    bool parseFlag(char const * tbegin, char const * tend, bool & flag) {
+        if (tend - tbegin != 1 || (*tbegin != '0' && *tbegin != '1'))
+            return false;
+        flag = *tbegin == '1';
+        return true;
+    }
+
+    bool parseDouble(char const * tbegin, char const * tend, double & value) {
+        // strtod stops at the separator following the token
+        char * endptr = 0;
+        value = std::strtod(tbegin, &endptr);
+        return endptr == tend && tbegin != tend;
+    }
+
+    bool isKeyword(std::string const & token) {
+        return token == "vertices" || token == "faces" || token == "cells" || token == "boundaryconditions";
+    }
+
+    // Permutation that visits the records in ascending id order,
+    // empty if the records are sorted already
+    std::vector<std::size_t> idOrder(std::vector<Id_t> const & ids) {
+        std::vector<std::size_t> order;
+        if (std::is_sorted(ids.begin(), ids.end()))
+            return order;
+
+        order.resize(ids.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+
+        std::stable_sort(order.begin(), order.end(), [&ids](std::size_t lhs, std::size_t rhs) {
+            return ids[lhs] < ids[rhs];
+        });
+        return order;
+    }
+
+    template<typename T>
+    void permute(std::vector<T> & data, std::vector<std::size_t> const & order) {
+        if (order.empty() || data.empty())
+            return;
+
+        std::vector<T> permuted(data.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            permuted[i] = data[order[i]];
+        data.swap(permuted);
+    }
+
+    // same for id lists stored in one array
+    void permuteLists(std::vector<std::size_t> & offsets, std::vector<Id_t> & refs, std::vector<std::size_t> const & order) {
+        if (order.empty())
+            return;
+
+        std::vector<std::size_t> permuted_offsets(offsets.size(), 0);
+        std::vector<Id_t> permuted_refs;
+        permuted_refs.reserve(refs.size());
+
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            permuted_refs.insert(permuted_refs.end(), refs.begin() + offsets[order[i]], refs.begin() + offsets[order[i] + 1]);
+            permuted_offsets[i + 1] = permuted_refs.size();
+        }
+        offsets.swap(permuted_offsets);
+        refs.swap(permuted_refs);
+    }
+
+}
+
+ParallelASCIIMeshReader::ParallelASCIIMeshReader(std::string const & mesh_filename, IMeshBuilder & builder, unsigned int nthreads)
+    : mesh_filename_(mesh_filename), builder_(builder), nthreads_(ParallelFor::numberOfThreads(nthreads)), min_chunk_size_(ParallelFor::MIN_CHUNK_SIZE) {}
+
+bool
+ParallelASCIIMeshReader::read() const {
+    if (!FS::exists(mesh_filename_)) {
+        FS::path p = FS::initial_path();
+        boost::format format = boost::format("ParallelASCIIMeshReader::read: Mesh file %1% not found!\nCurrent path: %2%\n") % mesh_filename_ % p;
+        return Util::error(format.str());
+    }
+
+    /*
+     * Read the whole file at once and split it into lines.
+     * The buffer is 0-terminated so that strtod never runs
+     * past its end.
+     */
+    std::vector<char> buffer;
+    {
+        std::ifstream file(mesh_filename_.c_str(), std::ios::in | std::ios::binary);
+        file.seekg(0, std::ios::end);
+        std::streamoff size = file.tellg();
+        file.seekg(0, std::ios::beg);
+
+        buffer.resize(static_cast<std::size_t>(size) + 1, '\0');
+        if (size > 0 && !file.read(&buffer[0], size)) {
+            boost::format format = boost::format("ParallelASCIIMeshReader::read: Cannot read mesh file %1%!\n") % mesh_filename_;
+            return Util::error(format.str());
+        }
+    }
+
+    std::vector<Line> lines;
+    {
+        char const * pos = &buffer[0];
+        char const * end = pos + buffer.size() - 1;
+
+        while (pos < end) {
+            char const * eol = static_cast<char const *>(std::memchr(pos, '\n', end - pos));
+            if (eol == 0)
+                eol = end;
+
+            Line line = { pos, eol };
+            lines.push_back(line);
+            pos = eol + 1;
+        }
+    }
+
+    /*
+     * Assign every record line to its section. Keywords have to appear
+     * in the same order as required by ASCIIMeshReader.
+     */
+    enum State {BASE_STATE, NODE_STATE, FACE_STATE, CELL_STATE, BC_STATE};
+
+    Section node_section;
+    Section face_section;
+    Section cell_section;
+    Section bc_section;
+
+    State state = BASE_STATE;
+
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        int line_number = static_cast<int>(i + 1);
+
+        LineTokenizer tokenizer(lines[i]);
+        char const * tbegin;
+        char const * tend;
+
+        if (!tokenizer.next(tbegin, tend))
+            continue;
+
+        // Comment?
+        if (*tbegin == '#')
+            continue;
+
+        std::string t;
+        if (std::isalpha(static_cast<unsigned char>(*tbegin))) {
+            t.assign(tbegin, tend);
+            boost::algorithm::to_lower(t);
+        }
+
+        if (!t.empty() && isKeyword(t)) {
+            if (t == "vertices") {
+                if (state == NODE_STATE || state == FACE_STATE || state == CELL_STATE) {
+                    boost::format format = boost::format("ParallelASCIIMeshReader::read: Keyword 'vertices' unexpected in line %1%!\n") % line_number;
+                    return Util::error(format.str());
+                }
+                state = NODE_STATE;
+            }
+            else if (t == "faces") {
+                if (state != NODE_STATE) {
+                    boost::format format = boost::format("ParallelASCIIMeshReader::read: Keyword 'faces' unexpected in line %1%!\n") % line_number;
+                    return Util::error(format.str());
+                }
+                state = FACE_STATE;
+            }
+            else if (t == "cells") {
+                if (state != FACE_STATE) {
+                    boost::format format = boost::format("ParallelASCIIMeshReader::read: Keyword 'cells' unexpected in line %1%!\n") % line_number;
+                    return Util::error(format.str());
+                }
+                state = CELL_STATE;
+            }
+            else {
+                if (state != CELL_STATE) {
+                    boost::format format = boost::format("ParallelASCIIMeshReader::read: Keyword 'boundaryconditions' unexpected in line %1%!\n") % line_number;
+                    return Util::error(format.str());
+                }
+                state = BC_STATE;
+            }
+            continue;
+        }
+
+        switch (state) {
+            case NODE_STATE:
+                node_section.lines.push_back(i);
+                break;
+
+            case FACE_STATE:
+                face_section.lines.push_back(i);
+                break;
+
+            case CELL_STATE:
+                cell_section.lines.push_back(i);
+                break;
+
+            case BC_STATE:
+                bc_section.lines.push_back(i);
+                break;
+
+            default: {
+                boost::format format = boost::format("ParallelASCIIMeshReader::read: Invalid input in line %1%!\n") % line_number;
+                return Util::error(format.str());
+            }
+        }
+    }
+
+    /*
+     * Vertices: id, boundary flag, x, y
+     */
+    std::size_t nnodes = node_section.lines.size();
+    std::vector<Id_t>          node_ids(nnodes);
+    std::vector<IGeometricEntity::Entity_t> node_types(nnodes);
+    std::vector<double>        node_x(nnodes);
+    std::vector<double>        node_y(nnodes);
+    {
+        ParseError error;
+
+        ParallelFor::forEachChunk(nnodes, nthreads_, min_chunk_size_, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                std::size_t line_index = node_section.lines[i];
+                int line_number = static_cast<int>(line_index + 1);
+
+                Line const & line = lines[line_index];
+                if (countTokens(line) != 4) {
+                    error.set("ParallelASCIIMeshReader::read: Invalid vertex format in line %1%!\n", line_number);
+                    return;
+                }
+
+                LineTokenizer tokenizer(line);
+                char const * b[4];
+                char const * e[4];
+                for (int k = 0; k < 4; ++k)
+                    tokenizer.next(b[k], e[k]);
+
+                bool on_boundary;
+                if (!parseId(b[0], e[0], node_ids[i]) || !parseFlag(b[1], e[1], on_boundary) ||
+                    !parseDouble(b[2], e[2], node_x[i]) || !parseDouble(b[3], e[3], node_y[i])) {
+                    error.set("ParallelASCIIMeshReader::read: Input error in line %1%!\n", line_number);
+                    return;
+                }
+                node_types[i] = on_boundary ? IGeometricEntity::BOUNDARY : IGeometricEntity::INTERIOR;
+            }
+        });
+
+        if (!error.report())
+            return false;
+    }
+
+    /*
+     * Faces and cells: id, (boundary flag,) list of vertex/face ids.
+     * A first pass counts the ids per record so that all of them
+     * can be stored in one pre-sized array.
+     */
+    auto parseEntityLists = [&](Section const & section, bool with_flag, char const * format_error,
+                                std::vector<Id_t> & ids, std::vector<IGeometricEntity::Entity_t> & entity_types,
+                                std::vector<std::size_t> & offsets, std::vector<Id_t> & refs) -> bool {
+        std::size_t n = section.lines.size();
+        unsigned int header = with_flag ? 2 : 1;
+
+        ids.resize(n);
+        entity_types.resize(with_flag ? n : 0);
+        offsets.assign(n + 1, 0);
+
+        ParseError error;
+
+        ParallelFor::forEachChunk(n, nthreads_, min_chunk_size_, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                std::size_t line_index = section.lines[i];
+                unsigned int ntokens = countTokens(lines[line_index]);
+                if (ntokens < 4) {
+                    error.set(format_error, static_cast<int>(line_index + 1));
+                    return;
+                }
+                offsets[i + 1] = ntokens - header;
+            }
+        });
+
+        if (!error.report())
+            return false;
+
+        for (std::size_t i = 0; i < n; ++i)
+            offsets[i + 1] += offsets[i];
+        refs.resize(offsets[n]);
+
+        ParallelFor::forEachChunk(n, nthreads_, min_chunk_size_, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                std::size_t line_index = section.lines[i];
+                int line_number = static_cast<int>(line_index + 1);
+
+                LineTokenizer tokenizer(lines[line_index]);
+                char const * tbegin;
+                char const * tend;
+
+                tokenizer.next(tbegin, tend);
+                if (!parseId(tbegin, tend, ids[i])) {
+                    error.set("ParallelASCIIMeshReader::read: Input error in line %1%!\n", line_number);
+                    return;
+                }
+
+                if (with_flag) {
+                    bool flag;
+                    tokenizer.next(tbegin, tend);
+                    if (!parseFlag(tbegin, tend, flag)) {
+                        error.set("ParallelASCIIMeshReader::read: Input error in line %1%!\n", line_number);
+                        return;
+                    }
+                    entity_types[i] = flag ? IGeometricEntity::BOUNDARY : IGeometricEntity::INTERIOR;
+                }
+
+                for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+                    tokenizer.next(tbegin, tend);
+                    if (!parseId(tbegin, tend, refs[k])) {
+                        error.set("ParallelASCIIMeshReader::read: Input error in line %1%!\n", line_number);
+                        return;
+                    }
+                }
+            }
+        });
+
+        return error.report();
+    };
+
+    std::vector<Id_t>          face_ids;
+    std::vector<IGeometricEntity::Entity_t> face_types;
+    std::vector<std::size_t>   face_offsets;
+    std::vector<Id_t>          face_nodes;
+
+    if (!parseEntityLists(face_section, true, "ParallelASCIIMeshReader::read: Invalid face format in line %1%!\n",
+                          face_ids, face_types, face_offsets, face_nodes))
+        return false;
+
+    std::vector<Id_t>          cell_ids;
+    std::vector<IGeometricEntity::Entity_t> cell_unused;
+    std::vector<std::size_t>   cell_offsets;
+    std::vector<Id_t>          cell_faces;
+
+    if (!parseEntityLists(cell_section, false, "ParallelASCIIMeshReader::read: Invalid cell format in line %1%!\n",
+                          cell_ids, cell_unused, cell_offsets, cell_faces))
+        return false;
+
+    /*
+     * Boundary conditions: face id, d(irichlet) | n(eumann), value
+     */
+    std::size_t nbcs = bc_section.lines.size();
+    std::vector<Id_t>                              bc_face_ids(nbcs);
+    std::vector<BoundaryConditionCollection::Type> bc_types(nbcs);
+    std::vector<double>                            bc_values(nbcs);
+    {
+        ParseError error;
+
+        ParallelFor::forEachChunk(nbcs, nthreads_, min_chunk_size_, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                std::size_t line_index = bc_section.lines[i];
+                int line_number = static_cast<int>(line_index + 1);
+
+                Line const & line = lines[line_index];
+                if (countTokens(line) != 3) {
+                    error.set("ParallelASCIIMeshReader::read: Invalid boundary condition format in line %1%!\n", line_number);
+                    return;
+                }
+
+                LineTokenizer tokenizer(line);
+                char const * b[3];
+                char const * e[3];
+                for (int k = 0; k < 3; ++k)
+                    tokenizer.next(b[k], e[k]);
+
+                switch (*b[1]) {
+                    case 'd':
+                        bc_types[i] = BoundaryConditionCollection::DIRICHLET;
+                        break;
+
+                    case 'n':
+                        bc_types[i] = BoundaryConditionCollection::NEUMANN;
+                        break;
+
+                    default:
+                        error.set("ParallelASCIIMeshReader::read: Unknown boundary condition in line %1%!\n", line_number);
+                        return;
+                }
+
+                if (!parseId(b[0], e[0], bc_face_ids[i]) || !parseDouble(b[2], e[2], bc_values[i])) {
+                    error.set("ParallelASCIIMeshReader::read: Input error in line %1%!\n", line_number);
+                    return;
+                }
+            }
+        });
+
+        if (!error.report())
+            return false;
+    }
+
+    /*
+     * Commit everything to the mesh builder in id order
+     */
+    std::vector<std::size_t> order = idOrder(node_ids);
+    permute(node_ids, order);
+    permute(node_types, order);
+    permute(node_x, order);
+    permute(node_y, order);
+
+    if (!builder_.buildNodes(node_ids, node_types, node_x, node_y))
+        return Util::error("ParallelASCIIMeshReader::read: Cannot build vertices!\n");
+
+    order = idOrder(face_ids);
+    permute(face_ids, order);
+    permute(face_types, order);
+    permuteLists(face_offsets, face_nodes, order);
+
+    if (face_nodes.size() == 2 * face_ids.size()) {
+        if (!builder_.buildFaces(face_ids, face_types, face_nodes))
+            return Util::error("ParallelASCIIMeshReader::read: Cannot build faces!\n");
+    }
+    else {
+        // not all faces have two vertices, let the builder decide face by face
+        std::vector<Id_t> refs;
+        for (std::size_t i = 0; i < face_ids.size(); ++i) {
+            refs.assign(face_nodes.begin() + face_offsets[i], face_nodes.begin() + face_offsets[i + 1]);
+            builder_.buildFace(face_ids[i], face_types[i], refs);
+        }
+    }
+
+    order = idOrder(cell_ids);
+    permute(cell_ids, order);
+    permuteLists(cell_offsets, cell_faces, order);
+
+    if (!builder_.buildCells(cell_ids, cell_offsets, cell_faces))
+        return Util::error("ParallelASCIIMeshReader::read: Cannot build cells!\n");
+
+    for (std::size_t i = 0; i < nbcs; ++i)
+        bc_.add(bc_face_ids[i], bc_types[i], bc_values[i]);
+
+    builder_.outputReport(std::cout);
+
+    return true;
+}
+
+BoundaryConditionCollection const &
+ParallelASCIIMeshReader::getBoundaryConditions() const {
+    return bc_;
+}
+
+unsigned int
+ParallelASCIIMeshReader::getNumberOfThreads() const {
+    return nthreads_;
+}
+
+void
+ParallelASCIIMeshReader::setMinimumChunkSize(std::size_t min_chunk_size) {
+    min_chunk_size_ = std::max<std::size_t>(1, min_chunk_size);
+}
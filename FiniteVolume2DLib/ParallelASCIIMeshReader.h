@@ -0,0 +1,53 @@
+/*
+ * Name  : ParallelASCIIMeshReader
+ * Path  : IMeshReader
+ * Use   : Reads a mesh file in ascii format. The file is read
+ *         into memory at once, the vertex, face, cell and boundary
+ *         condition sections are split into chunks of lines which
+ *         are parsed concurrently into pre-sized arrays. Finally,
+ *         the entities are handed to the mesh builder in id order.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+#include "DeclSpec.h"
+#include "IMeshReader.h"
+#include "BoundaryConditionCollection.h"
+
+class IMeshBuilder;
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2DLIB ParallelASCIIMeshReader : public IMeshReader {
+public:
+    // nthreads == 0: use as many threads as there are hardware threads
+    ParallelASCIIMeshReader(std::string const & mesh_filename, IMeshBuilder & builder, unsigned int nthreads = 0);
+
+    // FROM IMeshReader
+    bool                                read() const;
+    BoundaryConditionCollection const & getBoundaryConditions() const;
+
+    unsigned int                        getNumberOfThreads() const;
+
+    // sections with less lines than this are not split any further
+    void                                setMinimumChunkSize(std::size_t min_chunk_size);
+
+private:
+    // no implicit assignment operator due to reference (builder_)
+    ParallelASCIIMeshReader & operator=(ParallelASCIIMeshReader const & in);
+
+private:
+    std::string                         mesh_filename_;
+    IMeshBuilder &                      builder_;
+    unsigned int                        nthreads_;
+    std::size_t                         min_chunk_size_;
+    mutable BoundaryConditionCollection bc_;
+};
+
+#pragma warning(default:4251)
@@ -0,0 +1,92 @@
+/*
+ * Name  : ParallelFor
+ * Path  :
+ * Use   : Splits a loop between several threads. The first chunk is
+ *         processed by the calling thread. All threads are joined
+ *         before the first exception thrown by any chunk is rethrown.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <cstddef>
+#include <algorithm>
+#include <exception>
+
+
+namespace ParallelFor {
+    // below, the threads cost more than they save
+    std::size_t const MIN_CHUNK_SIZE = 4096;
+
+    // nthreads = 0: one thread per core
+    inline unsigned int
+    numberOfThreads(unsigned int nthreads) {
+        return nthreads != 0 ? nthreads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Runs func(chunk) for all chunks in [0, nchunks).
+    template <typename Func>
+    void
+    forEachIndex(std::size_t nchunks, Func const & func) {
+        if (nchunks == 0)
+            return;
+
+        std::vector<std::exception_ptr> errors(nchunks);
+
+        auto run = [&func, &errors](std::size_t chunk) {
+            try {
+                func(chunk);
+            }
+            catch (...) {
+                errors[chunk] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(nchunks - 1);
+
+        try {
+            for (std::size_t chunk = 1; chunk < nchunks; ++chunk)
+                workers.push_back(std::thread(run, chunk));
+        }
+        catch (...) {
+            // no more threads: the calling thread does the rest
+            for (std::size_t chunk = workers.size() + 1; chunk < nchunks; ++chunk)
+                run(chunk);
+        }
+
+        run(0);
+
+        std::for_each(workers.begin(), workers.end(), [](std::thread & t) { t.join(); });
+
+        std::for_each(errors.begin(), errors.end(), [](std::exception_ptr const & error) {
+            if (error)
+                std::rethrow_exception(error);
+        });
+    }
+
+    // Runs func(begin, end) on chunks of [0, n) of at least min_chunk_size.
+    template <typename Func>
+    void
+    forEachChunk(std::size_t n, unsigned int nthreads, std::size_t min_chunk_size, Func const & func) {
+        std::size_t nchunks = std::max<std::size_t>(1, std::min<std::size_t>(nthreads, n / std::max<std::size_t>(1, min_chunk_size)));
+        std::size_t chunk_size = std::max<std::size_t>(1, (n + nchunks - 1) / nchunks);
+
+        // the last chunk may be short, an empty range is one empty chunk
+        nchunks = std::max<std::size_t>(1, (n + chunk_size - 1) / chunk_size);
+
+        forEachIndex(nchunks, [&](std::size_t chunk) {
+            std::size_t begin = chunk * chunk_size;
+            func(begin, std::min(n, begin + chunk_size));
+        });
+    }
+
+    // Runs func(begin, end) on chunks of [0, n) of at least MIN_CHUNK_SIZE.
+    template <typename Func>
+    void
+    forEachChunk(std::size_t n, unsigned int nthreads, Func const & func) {
+        forEachChunk(n, nthreads, MIN_CHUNK_SIZE, func);
+    }
+}
@@ -0,0 +1,250 @@
+#include "Profiler.h"
+
+#include <ostream>
+#include <algorithm>
+
+#include <boost/format.hpp>
+
+
+namespace {
+
+    // created at load time, i.e. before any thread can access it
+    Profiler & profiler_instance = Profiler::instance();
+
+    std::string
+    escapeJSON(std::string const & in) {
+        std::string out;
+        out.reserve(in.size());
+
+        for (std::string::size_type i = 0; i < in.size(); ++i) {
+            char c = in[i];
+
+            if (c == '"' || c == '\\')
+                out += '\\';
+
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out += (boost::format("\\u%04x") % int(c)).str();
+                continue;
+            }
+
+            out += c;
+        }
+
+        return out;
+    }
+
+}
+
+Profiler::ScopedTimer::ScopedTimer(char const * name)
+    :
+    name_(name),
+    active_(Profiler::instance().isEnabled()) {
+
+    if (active_)
+        start_ = std::chrono::high_resolution_clock::now();
+}
+
+Profiler::ScopedTimer::~ScopedTimer() {
+    if (!active_)
+        return;
+
+    std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start_;
+    Profiler::instance().addTime(name_, diff.count());
+}
+
+Profiler &
+Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : enabled_(false) {}
+
+bool
+Profiler::isCompiledIn() {
+#ifdef FV2D_ENABLE_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void
+Profiler::enable(bool enabled) {
+    enabled_ = enabled;
+}
+
+bool
+Profiler::isEnabled() const {
+    return enabled_;
+}
+
+void
+Profiler::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    timings_.clear();
+    counters_.clear();
+    samples_.clear();
+}
+
+void
+Profiler::addTime(std::string const & name, double seconds) {
+    if (!enabled_)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Timing & timing = timings_[name];
+
+    if (timing.calls == 0) {
+        timing.min = seconds;
+        timing.max = seconds;
+    }
+    else {
+        timing.min = std::min(timing.min, seconds);
+        timing.max = std::max(timing.max, seconds);
+    }
+
+    timing.total += seconds;
+    timing.calls++;
+}
+
+void
+Profiler::addCount(std::string const & name, boost::uint64_t n) {
+    if (!enabled_)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    counters_[name] += n;
+}
+
+void
+Profiler::addSample(std::string const & name, double value) {
+    if (!enabled_)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Sample & sample = samples_[name];
+
+    if (sample.count == 0) {
+        sample.min = value;
+        sample.max = value;
+    }
+    else {
+        sample.min = std::min(sample.min, value);
+        sample.max = std::max(sample.max, value);
+    }
+
+    sample.last = value;
+    sample.sum += value;
+    sample.count++;
+}
+
+void
+Profiler::count(char const * name, boost::uint64_t n) {
+    if (isEnabled())
+        addCount(name, n);
+}
+
+void
+Profiler::sample(char const * name, double value) {
+    if (isEnabled())
+        addSample(name, value);
+}
+
+Profiler::Timings_t
+Profiler::getTimings() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timings_;
+}
+
+Profiler::Counters_t
+Profiler::getCounters() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return counters_;
+}
+
+Profiler::Samples_t
+Profiler::getSamples() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return samples_;
+}
+
+void
+Profiler::report(std::ostream & out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    out << "Profiling report" << std::endl;
+
+    out << std::endl << boost::format("%|-60| %|10| %|12| %|12| %|12| %|12|\n")
+        % "Timer" % "calls" % "total[s]" % "mean[ms]" % "min[ms]" % "max[ms]";
+
+    std::for_each(timings_.begin(), timings_.end(), [&out](Timings_t::value_type const & entry) {
+        Timing const & t = entry.second;
+
+        out << boost::format("%|-60| %|10| %|12.6f| %|12.4f| %|12.4f| %|12.4f|\n")
+            % entry.first % t.calls % t.total % (1000.0 * t.total / double(t.calls)) % (1000.0 * t.min) % (1000.0 * t.max);
+    });
+
+    out << std::endl << boost::format("%|-60| %|10|\n") % "Counter" % "value";
+
+    std::for_each(counters_.begin(), counters_.end(), [&out](Counters_t::value_type const & entry) {
+        out << boost::format("%|-60| %|10|\n") % entry.first % entry.second;
+    });
+
+    out << std::endl << boost::format("%|-60| %|10| %|12| %|12| %|12| %|12|\n")
+        % "Sample" % "count" % "last" % "mean" % "min" % "max";
+
+    std::for_each(samples_.begin(), samples_.end(), [&out](Samples_t::value_type const & entry) {
+        Sample const & s = entry.second;
+
+        out << boost::format("%|-60| %|10| %|12.5g| %|12.5g| %|12.5g| %|12.5g|\n")
+            % entry.first % s.count % s.last % (s.sum / double(s.count)) % s.min % s.max;
+    });
+}
+
+void
+Profiler::reportJSON(std::ostream & out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    out << "{\n  \"timers\": {";
+
+    bool first = true;
+    std::for_each(timings_.begin(), timings_.end(), [&](Timings_t::value_type const & entry) {
+        Timing const & t = entry.second;
+
+        out << (first ? "\n" : ",\n");
+        out << boost::format("    \"%1%\": {\"calls\": %2%, \"total\": %3$.9g, \"min\": %4$.9g, \"max\": %5$.9g}")
+            % escapeJSON(entry.first) % t.calls % t.total % t.min % t.max;
+
+        first = false;
+    });
+
+    out << "\n  },\n  \"counters\": {";
+
+    first = true;
+    std::for_each(counters_.begin(), counters_.end(), [&](Counters_t::value_type const & entry) {
+        out << (first ? "\n" : ",\n");
+        out << boost::format("    \"%1%\": %2%") % escapeJSON(entry.first) % entry.second;
+
+        first = false;
+    });
+
+    out << "\n  },\n  \"samples\": {";
+
+    first = true;
+    std::for_each(samples_.begin(), samples_.end(), [&](Samples_t::value_type const & entry) {
+        Sample const & s = entry.second;
+
+        out << (first ? "\n" : ",\n");
+        out << boost::format("    \"%1%\": {\"count\": %2%, \"last\": %3$.9g, \"mean\": %4$.9g, \"min\": %5$.9g, \"max\": %6$.9g}")
+            % escapeJSON(entry.first) % s.count % s.last % (s.sum / double(s.count)) % s.min % s.max;
+
+        first = false;
+    });
+
+    out << "\n  }\n}\n";
+}
@@ -0,0 +1,145 @@
+/*
+ * Name  : Profiler
+ * Path  :
+ * Use   : Collects per-phase wall times, call counts, counters
+ *         (e.g. allocations) and sampled values (e.g. solver
+ *         iterations and residuals) and dumps them as text or JSON.
+ *         Recording is switched on at runtime via enable(). The
+ *         FV2D_PROFILE_* macros expand to nothing unless
+ *         FV2D_ENABLE_PROFILING is defined, i.e. the instrumentation
+ *         is compiled out entirely by default. Profiling.props
+ *         defines it for all projects of the solution if built with
+ *         /p:EnableProfiling=true, isCompiledIn() tells whether it was
+ *         defined for this library.
+ *
+ *         Usage:
+ *           Profiler::instance().enable(true);
+ *           {
+ *               FV2D_PROFILE_SCOPE("ComputationalMeshBuilder::build");
+ *               ...
+ *           }
+ *           Profiler::instance().report(std::cout);
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include <map>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+
+#include <boost/cstdint.hpp>
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS_2DLIB Profiler {
+public:
+    struct Timing {
+        Timing() : calls(0), total(0), min(0), max(0) {}
+
+        boost::uint64_t calls;
+
+        // seconds
+        double          total;
+        double          min;
+        double          max;
+    };
+
+    struct Sample {
+        Sample() : count(0), last(0), min(0), max(0), sum(0) {}
+
+        boost::uint64_t count;
+        double          last;
+        double          min;
+        double          max;
+        double          sum;
+    };
+
+    typedef std::map<std::string, Timing>          Timings_t;
+    typedef std::map<std::string, boost::uint64_t> Counters_t;
+    typedef std::map<std::string, Sample>          Samples_t;
+
+    // measures the wall time between construction and destruction
+    class DECL_SYMBOLS_2DLIB ScopedTimer {
+    public:
+        explicit ScopedTimer(char const * name);
+        ~ScopedTimer();
+
+    private:
+        ScopedTimer(ScopedTimer const & in);
+        ScopedTimer & operator=(ScopedTimer const & in);
+
+    private:
+        char const *                                   name_;
+        bool                                           active_;
+        std::chrono::high_resolution_clock::time_point start_;
+    };
+
+public:
+    static Profiler & instance();
+
+    /* false if FV2D_ENABLE_PROFILING was not defined, i.e. nothing is
+     * recorded even if enabled
+     */
+    static bool       isCompiledIn();
+
+    void              enable(bool enabled);
+    bool              isEnabled() const;
+
+    // discard everything recorded so far
+    void              reset();
+
+    void              addTime(std::string const & name, double seconds);
+    void              addCount(std::string const & name, boost::uint64_t n = 1);
+    void              addSample(std::string const & name, double value);
+
+    // as above, but only while enabled (FV2D_PROFILE_COUNT, FV2D_PROFILE_SAMPLE)
+    void              count(char const * name, boost::uint64_t n);
+    void              sample(char const * name, double value);
+
+    Timings_t         getTimings() const;
+    Counters_t        getCounters() const;
+    Samples_t         getSamples() const;
+
+    void              report(std::ostream & out) const;
+    void              reportJSON(std::ostream & out) const;
+
+private:
+    Profiler();
+    Profiler(Profiler const & in);
+    Profiler & operator=(Profiler const & in);
+
+private:
+    std::atomic<bool>  enabled_;
+
+    // only locked while enabled
+    mutable std::mutex mutex_;
+
+    Timings_t          timings_;
+    Counters_t         counters_;
+    Samples_t          samples_;
+};
+
+#pragma warning(default:4251)
+
+
+#define FV2D_PROFILE_CAT_IMPL(a, b) a ## b
+#define FV2D_PROFILE_CAT(a, b)      FV2D_PROFILE_CAT_IMPL(a, b)
+
+#ifdef FV2D_ENABLE_PROFILING
+#define FV2D_PROFILE_SCOPE(name)        Profiler::ScopedTimer FV2D_PROFILE_CAT(fv2d_profile_timer_, __LINE__)(name)
+#define FV2D_PROFILE_COUNT(name, n)     Profiler::instance().count((name), (n))
+#define FV2D_PROFILE_SAMPLE(name, v)    Profiler::instance().sample((name), (v))
+#else
+// not do {} while (0), which is warning C4127 at /W4
+#define FV2D_PROFILE_SCOPE(name)        ((void)0)
+#define FV2D_PROFILE_COUNT(name, n)     ((void)0)
+#define FV2D_PROFILE_SAMPLE(name, v)    ((void)0)
+#endif
@@ -78,6 +78,16 @@ CMatrix2D::solve(Vec const & b, Vec & x) const {
     }
 }
 
+double const *
+CMatrix2D::data() const {
+    return data_.empty() ? 0 : &data_[0];
+}
+
+double *
+CMatrix2D::data() {
+    return data_.empty() ? 0 : &data_[0];
+}
+
 void
 CMatrix2D::print() const {
     for (unsigned int i = 0; i < rows_; ++i) {
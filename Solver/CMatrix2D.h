@@ -33,6 +33,10 @@ public:
     // Local Methods
     void           print() const;
 
+    // unchecked access to the row-major elements, element (row, col) at row * getCols() + col
+    double const * data() const;
+    double *       data();
+
     // Static Methods
     static CMatrix2D identity(boost::uint64_t n);
 
@@ -2,6 +2,8 @@
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <stdexcept>
 
 #include <boost/assert.hpp>
 
@@ -48,27 +50,179 @@ CSparseMatrixImpl::solve(Vec const & b, Vec & x) const {
     if (!assert_cond)
         throw std::out_of_range("CSparseMatrixImpl::solve(): Out of range error");
 
+    multiply(b, x);
+}
+
+void
+CSparseMatrixImpl::multiply(Vec const & x, Vec & y) const {
+    if (!finalized_)
+        throw std::exception("CSparseMatrixImpl::multiply(): Matrix not yet finalized");
+
     typedef decltype(nelements_.size()) size_type;
     size_type nrows = nelements_.size() - 1;
 
-    // All rows
-    for (int row = 0; row < nrows; ++row) {
-        // Number of non-zero columns for this row
-        boost::uint64_t ncol = nelements_[row + 1] - nelements_[row];
-        boost::uint64_t offset = nelements_[row];
+    if (x.size() != ncols_ || y.size() < nrows)
+        throw std::out_of_range("CSparseMatrixImpl::multiply(): Out of range error");
 
+    // All rows
+    for (size_type row = 0; row < nrows; ++row) {
         double tmp = 0;
 
         // All non-zero columns
-        for (int icol = 0; icol < ncol; ++icol) {
-            boost::uint64_t col = columns_[offset + icol];
-            double a_ij = elements_[offset + icol];
+        for (boost::uint64_t i = nelements_[row]; i < nelements_[row + 1]; ++i)
+            tmp += elements_[i] * x[columns_[i]];
 
-            tmp += (a_ij * b[col]);
+        y[row] = tmp;
+    }
+}
+
+void
+CSparseMatrixImpl::multiply(Vec const & x, Vec & y, boost::uint64_t row_begin, boost::uint64_t row_end) const {
+    if (!finalized_)
+        throw std::exception("CSparseMatrixImpl::multiply(): Matrix not yet finalized");
+
+    boost::uint64_t nrows = nelements_.size() - 1;
+
+    if (x.size() != ncols_ || row_begin > row_end || row_end > nrows || y.size() < nrows)
+        throw std::out_of_range("CSparseMatrixImpl::multiply(): Out of range error");
+
+    for (boost::uint64_t row = row_begin; row < row_end; ++row) {
+        double tmp = 0;
+
+        for (boost::uint64_t i = nelements_[row]; i < nelements_[row + 1]; ++i)
+            tmp += elements_[i] * x[columns_[i]];
+
+        y[row] = tmp;
+    }
+}
+
+void
+CSparseMatrixImpl::multiply(Vec const & X, Vec & Y, boost::uint64_t nrhs) const {
+    if (!finalized_)
+        throw std::exception("CSparseMatrixImpl::multiply(): Matrix not yet finalized");
+
+    typedef decltype(nelements_.size()) size_type;
+    size_type nrows = nelements_.size() - 1;
+
+    if (X.size() != ncols_ * nrhs || Y.size() < nrows * nrhs)
+        throw std::out_of_range("CSparseMatrixImpl::multiply(): Out of range error");
+
+    // All rows
+    for (size_type row = 0; row < nrows; ++row) {
+        double * y = &Y[row * nrhs];
+        std::fill(y, y + nrhs, 0.0);
+
+        // All non-zero columns, each element applied to all vectors
+        for (boost::uint64_t i = nelements_[row]; i < nelements_[row + 1]; ++i) {
+            double a_ij = elements_[i];
+            double const * x = &X[columns_[i] * nrhs];
+
+            for (boost::uint64_t k = 0; k < nrhs; ++k)
+                y[k] += a_ij * x[k];
         }
+    }
+}
+
+void
+CSparseMatrixImpl::scale(double factor) {
+    if (!finalized_)
+        throw std::exception("CSparseMatrixImpl::scale(): Matrix not yet finalized");
+
+    std::for_each(elements_.begin(), elements_.end(), [factor](double & a_ij) {
+        a_ij *= factor;
+    });
+}
+
+namespace {
+
+    // position of element (row, col) in the compressed storage, end if not stored
+    boost::uint64_t
+    findElement(std::vector<boost::uint64_t> const & columns, boost::uint64_t begin, boost::uint64_t end, boost::uint64_t col) {
+        // the columns of a row are sorted
+        auto first = columns.begin() + begin;
+        auto last  = columns.begin() + end;
+        auto it    = std::lower_bound(first, last, col);
 
-        x[row] = tmp;
+        if (it == last || *it != col)
+            return end;
+
+        return std::distance(columns.begin(), it);
     }
+
+    boost::uint64_t
+    findDiagonal(std::vector<boost::uint64_t> const & columns, boost::uint64_t begin, boost::uint64_t end, boost::uint64_t row) {
+        boost::uint64_t pos = findElement(columns, begin, end, row);
+
+        if (pos == end)
+            throw std::out_of_range("CSparseMatrixImpl: Missing diagonal element");
+
+        return pos;
+    }
+
+}
+
+void
+CSparseMatrixImpl::getDiagonal(Vec & d) const {
+    if (!finalized_)
+        throw std::exception("CSparseMatrixImpl::getDiagonal(): Matrix not yet finalized");
+
+    typedef decltype(nelements_.size()) size_type;
+    size_type nrows = nelements_.size() - 1;
+
+    d.resize(nrows);
+
+    for (size_type row = 0; row < nrows; ++row)
+        d[row] = elements_[findDiagonal(columns_, nelements_[row], nelements_[row + 1], row)];
+}
+
+void
+CSparseMatrixImpl::setDiagonal(Vec const & d) {
+    if (!finalized_)
+        throw std::exception("CSparseMatrixImpl::setDiagonal(): Matrix not yet finalized");
+
+    typedef decltype(nelements_.size()) size_type;
+    size_type nrows = nelements_.size() - 1;
+
+    if (d.size() != nrows)
+        throw std::out_of_range("CSparseMatrixImpl::setDiagonal(): Out of range error");
+
+    for (size_type row = 0; row < nrows; ++row)
+        elements_[findDiagonal(columns_, nelements_[row], nelements_[row + 1], row)] = d[row];
+}
+
+void
+CSparseMatrixImpl::setZero() {
+    if (!finalized_)
+        throw std::exception("CSparseMatrixImpl::setZero(): Matrix not yet finalized");
+
+    std::fill(elements_.begin(), elements_.end(), 0.0);
+}
+
+void
+CSparseMatrixImpl::setZero(boost::uint64_t row) {
+    if (!finalized_)
+        throw std::exception("CSparseMatrixImpl::setZero(): Matrix not yet finalized");
+
+    if (row + 1 >= nelements_.size())
+        throw std::out_of_range("CSparseMatrixImpl::setZero(): Out of range error");
+
+    std::fill(elements_.begin() + nelements_[row], elements_.begin() + nelements_[row + 1], 0.0);
+}
+
+double &
+CSparseMatrixImpl::at(boost::uint64_t row, boost::uint64_t col) {
+    if (!finalized_)
+        throw std::exception("CSparseMatrixImpl::at(): Matrix not yet finalized");
+
+    if (row + 1 >= nelements_.size())
+        throw std::out_of_range("CSparseMatrixImpl::at(): Out of range error");
+
+    boost::uint64_t pos = findElement(columns_, nelements_[row], nelements_[row + 1], col);
+
+    if (pos == nelements_[row + 1])
+        throw std::out_of_range("CSparseMatrixImpl::at(): Element not stored");
+
+    return elements_[pos];
 }
 
 void 
@@ -110,6 +264,19 @@ CSparseMatrixImpl::finalize() const {
     finalized_ = true;
 }
 
+boost::uint64_t
+CSparseMatrixImpl::rows() const {
+    if (!finalized_)
+        throw std::exception("CSparseMatrixImpl::rows(): Matrix not yet finalized");
+
+    return nelements_.size() - 1;
+}
+
+boost::uint64_t
+CSparseMatrixImpl::nonZeros() const {
+    return elements_.size();
+}
+
 void
 CSparseMatrixImpl::print() const {
     // Number of rows
@@ -27,6 +27,7 @@
 class DECL_SYMBOLS CSparseMatrixImpl : public IMatrix2D {
 
     friend struct LinearSolver;
+    friend class SparseLU;
 
 public:
     CSparseMatrixImpl(boost::uint64_t ncols);
@@ -39,8 +40,45 @@ public:
     void            solve(Vec const & b, Vec & x) const;
 
     // Local methods
-    void finalize() const;
-    void print() const;
+    void            finalize() const;
+    void            print() const;
+
+    // number of stored elements (after finalize())
+    boost::uint64_t nonZeros() const;
+
+    // number of rows in the compressed storage (after finalize())
+    boost::uint64_t rows() const;
+
+    // y = A x (after finalize())
+    void            multiply(Vec const & x, Vec & y) const;
+
+    /* As above, only the rows [row_begin, row_end) of y, e.g. a chunk
+     * per thread; the other elements of y are not touched.
+     */
+    void            multiply(Vec const & x, Vec & y, boost::uint64_t row_begin, boost::uint64_t row_end) const;
+
+    /* Y = A X for nrhs vectors at once (after finalize()), stored
+     * interleaved, i.e. X[col * nrhs + k] is element col of vector k.
+     */
+    void            multiply(Vec const & X, Vec & Y, boost::uint64_t nrhs) const;
+
+    /* A *= factor (after finalize()). As setDiagonal(), this only changes
+     * the compressed storage used by multiply() and the solvers.
+     */
+    void            scale(double factor);
+
+    /* Access the diagonal after finalize(). Each row must have a
+     * stored diagonal element, i.e. the sparsity pattern is not changed.
+     */
+    void            getDiagonal(Vec & d) const;
+    void            setDiagonal(Vec const & d);
+
+    /* Overwrite values after finalize() without changing the sparsity
+     * pattern. at() throws std::out_of_range for elements not stored.
+     */
+    void            setZero();
+    void            setZero(boost::uint64_t row);
+    double &        at(boost::uint64_t row, boost::uint64_t col);
 
 private:
     typedef std::map<boost::uint64_t, double> Col_t;
@@ -0,0 +1,164 @@
+#include "DenseLU.h"
+#include "CMatrix2D.h"
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace {
+    // columns of the trailing matrix updated at once
+    boost::uint64_t const TILE_SIZE = 256;
+
+}
+
+DenseLU::DenseLU(boost::uint64_t block_size) : block_size_(std::max(block_size, boost::uint64_t(1))), factorized_(false), n_(0) {}
+
+bool
+DenseLU::isFactorized() const {
+    return factorized_;
+}
+
+boost::uint64_t
+DenseLU::size() const {
+    return n_;
+}
+
+void
+DenseLU::factorize(CMatrix2D const & A) {
+    if (A.getRows() != A.getCols())
+        throw std::out_of_range("DenseLU::factorize(): Matrix must be quadratic");
+
+    factorized_ = false;
+
+    n_ = A.getRows();
+    lu_.assign(A.data(), A.data() + n_ * n_);
+    pivots_.assign(n_, 0);
+
+    for (boost::uint64_t k0 = 0; k0 < n_; k0 += block_size_) {
+        boost::uint64_t kb = std::min(block_size_, n_ - k0);
+
+        factorizePanel(k0, kb);
+        updateTrailing(k0, kb);
+    }
+
+    factorized_ = true;
+}
+
+void
+DenseLU::factorizePanel(boost::uint64_t k0, boost::uint64_t kb) {
+    // unblocked elimination within the columns k0, ..., k0 + kb - 1
+    for (boost::uint64_t k = k0; k < k0 + kb; ++k) {
+        boost::uint64_t pivot = k;
+        double pivot_value = std::fabs(lu_[k * n_ + k]);
+
+        for (boost::uint64_t i = k + 1; i < n_; ++i) {
+            double value = std::fabs(lu_[i * n_ + k]);
+            if (value > pivot_value) {
+                pivot = i;
+                pivot_value = value;
+            }
+        }
+
+        if (pivot_value == 0.0)
+            throw std::exception("DenseLU::factorize(): Matrix singular");
+
+        // swap the whole rows, i.e. also L to the left and the trailing matrix
+        pivots_[k] = pivot;
+        if (pivot != k)
+            std::swap_ranges(&lu_[k * n_], &lu_[k * n_] + n_, &lu_[pivot * n_]);
+
+        double const * row_k = &lu_[k * n_];
+        double a_kk = row_k[k];
+
+        for (boost::uint64_t i = k + 1; i < n_; ++i) {
+            double * row_i = &lu_[i * n_];
+
+            double l_ik = row_i[k] / a_kk;
+            row_i[k] = l_ik;
+
+            for (boost::uint64_t j = k + 1; j < k0 + kb; ++j)
+                row_i[j] -= l_ik * row_k[j];
+        }
+    }
+}
+
+void
+DenseLU::updateTrailing(boost::uint64_t k0, boost::uint64_t kb) {
+    boost::uint64_t j0 = k0 + kb;
+    if (j0 >= n_)
+        return;
+
+    // U12 = L11^{-1} A12
+    for (boost::uint64_t k = k0; k < j0; ++k) {
+        double const * row_k = &lu_[k * n_];
+
+        for (boost::uint64_t i = k + 1; i < j0; ++i) {
+            double * row_i = &lu_[i * n_];
+            double l_ik = row_i[k];
+
+            for (boost::uint64_t j = j0; j < n_; ++j)
+                row_i[j] -= l_ik * row_k[j];
+        }
+    }
+
+    /* A22 -= L21 U12, tile by tile of columns such that the rows of
+     * U12 used for all rows of A22 stay in cache.
+     */
+    for (boost::uint64_t jt = j0; jt < n_; jt += TILE_SIZE) {
+        boost::uint64_t jt_end = std::min(jt + TILE_SIZE, n_);
+
+        for (boost::uint64_t i = j0; i < n_; ++i) {
+            double * row_i = &lu_[i * n_];
+
+            for (boost::uint64_t k = k0; k < j0; ++k) {
+                double l_ik = row_i[k];
+                if (l_ik == 0.0)
+                    continue;
+
+                double const * row_k = &lu_[k * n_];
+
+                for (boost::uint64_t j = jt; j < jt_end; ++j)
+                    row_i[j] -= l_ik * row_k[j];
+            }
+        }
+    }
+}
+
+void
+DenseLU::solve(Vec const & b, Vec & x) const {
+    if (!factorized_)
+        throw std::exception("DenseLU::solve(): Matrix not yet factorized");
+
+    if (b.size() != n_)
+        throw std::out_of_range("DenseLU::solve(): Size mismatch of r.h.s.");
+
+    x = b;
+
+    // P b
+    for (boost::uint64_t k = 0; k < n_; ++k)
+        if (pivots_[k] != k)
+            std::swap(x[k], x[pivots_[k]]);
+
+    // L y = P b
+    for (boost::uint64_t i = 0; i < n_; ++i) {
+        double const * row_i = &lu_[i * n_];
+
+        double sum = x[i];
+        for (boost::uint64_t j = 0; j < i; ++j)
+            sum -= row_i[j] * x[j];
+
+        x[i] = sum;
+    }
+
+    // U x = y
+    for (boost::uint64_t i = n_; i-- > 0;) {
+        double const * row_i = &lu_[i * n_];
+
+        double sum = x[i];
+        for (boost::uint64_t j = i + 1; j < n_; ++j)
+            sum -= row_i[j] * x[j];
+
+        x[i] = sum / row_i[i];
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * Name  : DenseLU
+ * Path  :
+ * Use   : LU factorization with partial pivoting, P A = L U, of a
+ *         CMatrix2D for repeated solves, e.g. of coarse grid or small
+ *         block problems.
+ *         The factorization is blocked (right-looking): a panel of
+ *         block_size columns is factorized, then the trailing matrix
+ *         is updated in tiles which stay in cache. All loops run over
+ *         the contiguous rows of the unchecked row-major copy, i.e.
+ *         the inner loops are plain axpy operations the compiler can
+ *         vectorize.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+
+class CMatrix2D;
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS DenseLU {
+public:
+    typedef std::vector<double> Vec;
+
+public:
+    explicit DenseLU(boost::uint64_t block_size = 64);
+
+    // throws std::exception if A is singular
+    void            factorize(CMatrix2D const & A);
+
+    bool            isFactorized() const;
+
+    // x = A^{-1} b with the cached factor
+    void            solve(Vec const & b, Vec & x) const;
+
+    boost::uint64_t size() const;
+
+private:
+    void            factorizePanel(boost::uint64_t k0, boost::uint64_t kb);
+    void            updateTrailing(boost::uint64_t k0, boost::uint64_t kb);
+
+private:
+    boost::uint64_t block_size_;
+    bool            factorized_;
+
+    boost::uint64_t n_;
+
+    // L (unit lower, without the diagonal) and U, row-major
+    Vec             lu_;
+
+    // row k was swapped with row pivots_[k]
+    std::vector<boost::uint64_t> pivots_;
+};
+
+#pragma warning(default:4251)
@@ -3,6 +3,8 @@
 #include "CSparseMatrixImpl.h"
 
 #include <cmath>
+#include <limits>
+#include <algorithm>
 
 #include <boost/assert.hpp>
 
@@ -30,6 +32,145 @@ namespace {
         return pivot_index;
     }
 
+    double
+    l2Norm(std::vector<double> const & v) {
+        double sum = 0;
+        for (std::vector<double>::size_type i = 0; i < v.size(); ++i)
+            sum += v[i] * v[i];
+        return std::sqrt(sum);
+    }
+
+    // l2 norm of f - A x
+    double
+    residualNorm(CMatrix2D const & A, std::vector<double> const & f, std::vector<double> const & x) {
+        double sum = 0;
+        for (boost::uint64_t i = 0; i < A.getRows(); ++i) {
+            double r_i = f[i];
+            for (boost::uint64_t j = 0; j < A.getCols(); ++j)
+                r_i -= A(i, j) * x[j];
+            sum += r_i * r_i;
+        }
+        return std::sqrt(sum);
+    }
+
+    double
+    residualNorm(CSparseMatrixImpl const & A, std::vector<double> const & f, std::vector<double> const & x) {
+        std::vector<double> Ax(f.size());
+        A.multiply(x, Ax);
+
+        double sum = 0;
+        for (std::vector<double>::size_type i = 0; i < f.size(); ++i)
+            sum += (f[i] - Ax[i]) * (f[i] - Ax[i]);
+        return std::sqrt(sum);
+    }
+
+    /* Evaluates the termination criteria after each sweep and
+     * keeps the statistics up to date.
+     */
+    class ConvergenceCheck {
+    public:
+        ConvergenceCheck(LinearSolver::Control const & control, double rhs_norm, LinearSolver::Statistics & stats)
+            :
+            control_(control),
+            stats_(stats),
+            best_residual_norm_(std::numeric_limits<double>::max()),
+            best_iteration_(0) {
+
+            stats_ = LinearSolver::Statistics();
+            stats_.rhs_norm = rhs_norm;
+        }
+
+        // returns true if the iteration has to stop
+        bool
+        stop(double update_norm, double residual_norm) {
+            stats_.iterations++;
+            stats_.update_norm   = update_norm;
+            stats_.residual_norm = residual_norm;
+
+            if (control_.monitor && !control_.monitor(stats_.iterations, update_norm, residual_norm))
+                return finish(LinearSolver::ABORTED);
+
+            if (update_norm <= control_.update_tolerance)
+                return finish(LinearSolver::CONVERGED_UPDATE);
+
+            if (control_.absolute_tolerance > 0 && residual_norm <= control_.absolute_tolerance)
+                return finish(LinearSolver::CONVERGED_ABSOLUTE);
+
+            if (control_.relative_tolerance > 0 && residual_norm <= control_.relative_tolerance * stats_.rhs_norm)
+                return finish(LinearSolver::CONVERGED_RELATIVE);
+
+            if (control_.stagnation_window > 0) {
+                if (residual_norm < control_.stagnation_factor * best_residual_norm_) {
+                    best_residual_norm_ = residual_norm;
+                    best_iteration_     = stats_.iterations;
+                }
+                else if (stats_.iterations - best_iteration_ >= control_.stagnation_window)
+                    return finish(LinearSolver::STAGNATED);
+            }
+
+            if (stats_.iterations >= control_.max_iterations)
+                return finish(LinearSolver::MAX_ITERATIONS);
+
+            return false;
+        }
+
+        /* true if residual_norm meets the residual criteria. The sweeps
+         * only estimate the residual, i.e. the solvers confirm with
+         * f - A x before stop() accepts it.
+         */
+        bool
+        residualConverged(double residual_norm) const {
+            return (control_.absolute_tolerance > 0 && residual_norm <= control_.absolute_tolerance) ||
+                   (control_.relative_tolerance > 0 && residual_norm <= control_.relative_tolerance * stats_.rhs_norm);
+        }
+
+        // replaces the residual of the last sweep
+        void
+        setResidual(double residual_norm) {
+            stats_.residual_norm = residual_norm;
+        }
+
+    private:
+        ConvergenceCheck & operator=(ConvergenceCheck const & in);
+
+        bool
+        finish(LinearSolver::Reason reason) {
+            stats_.reason = reason;
+            return true;
+        }
+
+    private:
+        LinearSolver::Control const & control_;
+        LinearSolver::Statistics &    stats_;
+        double                        best_residual_norm_;
+        unsigned int                  best_iteration_;
+    };
+
+}
+
+LinearSolver::Control::Control()
+    :
+    max_iterations(10000),
+    update_tolerance(1E-16),
+    absolute_tolerance(0),
+    relative_tolerance(0),
+    stagnation_window(0),
+    stagnation_factor(0.99) {}
+
+char const *
+LinearSolver::toString(Reason reason) {
+    switch (reason) {
+    case NOT_RUN:            return "not run";
+    case CONVERGED_UPDATE:   return "converged (update)";
+    case CONVERGED_ABSOLUTE: return "converged (absolute residual)";
+    case CONVERGED_RELATIVE: return "converged (relative residual)";
+    case STAGNATED:          return "stagnated";
+    case MAX_ITERATIONS:     return "maximum number of iterations reached";
+    case ABORTED:            return "aborted by monitor";
+    case SOLVED_DIRECT:      return "solved (direct)";
+    case DIRECT_FAILED:      return "direct solver failed";
+    }
+    return "unknown";
 }
 
 std::tuple<bool, CMatrix2D const, std::vector<double> >
@@ -142,6 +283,12 @@ LinearSolver::GaussElim(CMatrix2D const & A, std::vector<double> const & f) {
 
 std::tuple<bool, IMatrix2D::Vec>
 LinearSolver::SOR(CMatrix2D const & A, IMatrix2D::Vec const & f, double omega) {
+    Statistics stats;
+    return SOR(A, f, omega, Control(), stats);
+}
+
+std::tuple<bool, IMatrix2D::Vec>
+LinearSolver::SOR(CMatrix2D const & A, IMatrix2D::Vec const & f, double omega, Control const & control, Statistics & stats) {
     /* Implements the Successive OverReleaxation method from
      * "Templates for the Solution of Linear Systems:
      * Building Blocks for Iterative Methods"
@@ -175,15 +322,14 @@ LinearSolver::SOR(CMatrix2D const & A, IMatrix2D::Vec const & f, double omega) {
 
     IMatrix2D::Vec x(f.size(), 0);
 
-    // Maximum allowed error
-    double max_l2_norm = 1E-16;
-    double l2_norm;
+    ConvergenceCheck check(control, l2Norm(f), stats);
 
-    // Iteration count
-    int k = 0;
+    double l2_norm;
+    double residual;
 
     do {
-        l2_norm = 0;
+        l2_norm  = 0;
+        residual = 0;
 
         // All rows
         for (int i = 0; i < dim; ++i) {
@@ -204,6 +350,10 @@ LinearSolver::SOR(CMatrix2D const & A, IMatrix2D::Vec const & f, double omega) {
 
             sigma = (f[i] - sigma) / a_ii;
 
+            // residual of row i before its update
+            double r_i = a_ii * (sigma - x[i]);
+            residual += (r_i * r_i);
+
             double correction = omega * (sigma - x[i]);
             l2_norm += (correction * correction);
 
@@ -213,19 +363,36 @@ LinearSolver::SOR(CMatrix2D const & A, IMatrix2D::Vec const & f, double omega) {
         // Check error term
         l2_norm /= (dim + 1);
         l2_norm = sqrt(l2_norm);
-    
-        k++;
 
-    } while (l2_norm > max_l2_norm && k < 10000);
+        residual = sqrt(residual);
+        if (check.residualConverged(residual))
+            residual = residualNorm(A, f, x);
 
-    if (k == 10000)
-        return std::make_tuple(false, x);
+    } while (!check.stop(l2_norm, residual));
 
-    return std::make_tuple(true, x);
+    check.setResidual(residualNorm(A, f, x));
+
+    return std::make_tuple(stats.converged(), x);
 }
 
 std::tuple<bool, IMatrix2D::Vec>
 LinearSolver::sparseSOR(CSparseMatrixImpl const & A, IMatrix2D::Vec const & f, double omega) {
+    Statistics stats;
+    return sparseSOR(A, f, omega, Control(), stats);
+}
+
+std::tuple<bool, IMatrix2D::Vec>
+LinearSolver::sparseSOR(CSparseMatrixImpl const & A, IMatrix2D::Vec const & f, double omega, Statistics & stats) {
+    return sparseSOR(A, f, omega, Control(), stats);
+}
+
+std::tuple<bool, IMatrix2D::Vec>
+LinearSolver::sparseSOR(CSparseMatrixImpl const & A, IMatrix2D::Vec const & f, double omega, Control const & control, Statistics & stats) {
+    return sparseSOR(A, f, IMatrix2D::Vec(f.size(), 0), omega, control, stats);
+}
+
+std::tuple<bool, IMatrix2D::Vec>
+LinearSolver::sparseSOR(CSparseMatrixImpl const & A, IMatrix2D::Vec const & f, IMatrix2D::Vec const & x0, double omega, Control const & control, Statistics & stats) {
     /* Implements the Successive OverReleaxation method from
      * "Templates for the Solution of Linear Systems:
      * Building Blocks for Iterative Methods"
@@ -269,17 +436,19 @@ LinearSolver::sparseSOR(CSparseMatrixImpl const & A, IMatrix2D::Vec const & f, d
         }
     }
 
-    IMatrix2D::Vec x(f.size(), 0);
+    if (x0.size() != f.size())
+        throw std::out_of_range("LinearSolver::sparseSOR: Size mismatch of initial guess");
 
-    // Maximum allowed error
-    double max_l2_norm = 1E-16;
-    double l2_norm;
+    IMatrix2D::Vec x(x0);
 
-    // Iteration count
-    int k = 0;
+    ConvergenceCheck check(control, l2Norm(f), stats);
+
+    double l2_norm;
+    double residual;
 
     do {
-        l2_norm = 0;
+        l2_norm  = 0;
+        residual = 0;
 
         // All rows
         for (int row = 0; row < nrows; ++row) {
@@ -310,6 +479,14 @@ LinearSolver::sparseSOR(CSparseMatrixImpl const & A, IMatrix2D::Vec const & f, d
 
             sigma = (f[row] - sigma) / a_ii;
 
+            /* Residual of the row before its update. The rows above
+             * already see the new values, i.e. this is the Gauss-Seidel
+             * residual, which comes for free with the sweep. It only
+             * estimates f - A x after the sweep.
+             */
+            double r_i = a_ii * (sigma - x[row]);
+            residual += (r_i * r_i);
+
             double correction = omega * (sigma - x[row]);
             l2_norm += (correction * correction);
 
@@ -319,13 +496,152 @@ LinearSolver::sparseSOR(CSparseMatrixImpl const & A, IMatrix2D::Vec const & f, d
         // Check error term
         l2_norm /= (nrows + 1);
         l2_norm = sqrt(l2_norm);
-    
-        k++;
 
-    } while (l2_norm > max_l2_norm && k < 10000);
+        residual = sqrt(residual);
+        if (check.residualConverged(residual))
+            residual = residualNorm(A, f, x);
+
+    } while (!check.stop(l2_norm, residual));
+
+    check.setResidual(residualNorm(A, f, x));
 
-    if (k == 10000)
-        return std::make_tuple(false, x);
+    return std::make_tuple(stats.converged(), x);
+}
+
+std::tuple<bool, LinearSolver::RHSBlock_t>
+LinearSolver::sparseSOR(CSparseMatrixImpl const & A, RHSBlock_t const & f, RHSBlock_t const & x0, double omega, Control const & control, std::vector<Statistics> & stats) {
+    typedef decltype(A.nelements_.size()) size_type;
+    size_type nrows = A.nelements_.size() - 1;
+    size_type nrhs  = f.size();
+
+    if (x0.size() != nrhs)
+        throw std::out_of_range("LinearSolver::sparseSOR: Size mismatch of initial guess");
+
+    for (size_type k = 0; k < nrhs; ++k)
+        if (f[k].size() != nrows || x0[k].size() != nrows)
+            throw std::out_of_range("LinearSolver::sparseSOR: Size mismatch of r.h.s.");
+
+    /* Interleaved storage, x[row * nrhs + k], such that the inner
+     * loop over the r.h.s. runs over contiguous memory for each
+     * matrix element.
+     */
+    IMatrix2D::Vec x(nrows * nrhs);
+    IMatrix2D::Vec b(nrows * nrhs);
+
+    for (size_type row = 0; row < nrows; ++row)
+        for (size_type k = 0; k < nrhs; ++k) {
+            x[row * nrhs + k] = x0[k][row];
+            b[row * nrhs + k] = f[k][row];
+        }
+
+    stats.resize(nrhs);
+
+    std::vector<ConvergenceCheck> checks;
+    checks.reserve(nrhs);
+    for (size_type k = 0; k < nrhs; ++k)
+        checks.push_back(ConvergenceCheck(control, l2Norm(f[k]), stats[k]));
+
+    // columns still iterating
+    std::vector<char> active(nrhs, 1);
+    size_type nactive = nrhs;
+
+    IMatrix2D::Vec sigma(nrhs);
+    IMatrix2D::Vec l2_norm(nrhs);
+    IMatrix2D::Vec residual(nrhs);
+
+    // l2 norm of f - A x per r.h.s.
+    IMatrix2D::Vec Ax(nrows * nrhs);
+    auto trueResidual = [&](IMatrix2D::Vec & norm) {
+        A.multiply(x, Ax, nrhs);
+
+        std::fill(norm.begin(), norm.end(), 0.0);
+        for (size_type i = 0; i < nrows * nrhs; ++i)
+            norm[i % nrhs] += (b[i] - Ax[i]) * (b[i] - Ax[i]);
+
+        for (size_type k = 0; k < nrhs; ++k)
+            norm[k] = std::sqrt(norm[k]);
+    };
+
+    while (nactive > 0) {
+        std::fill(l2_norm.begin(), l2_norm.end(), 0.0);
+        std::fill(residual.begin(), residual.end(), 0.0);
+
+        // All rows
+        for (size_type row = 0; row < nrows; ++row) {
+            double a_ii = 0;
+
+            std::fill(sigma.begin(), sigma.end(), 0.0);
+
+            for (boost::uint64_t i = A.nelements_[row]; i < A.nelements_[row + 1]; ++i) {
+                boost::uint64_t col = A.columns_[i];
+                double a_ij = A.elements_[i];
+
+                if (row == col) {
+                    a_ii = a_ij;
+                    continue;
+                }
+
+                double const * x_j = &x[col * nrhs];
+                for (size_type k = 0; k < nrhs; ++k)
+                    sigma[k] += a_ij * x_j[k];
+            }
+
+            if (!a_ii)
+                throw std::exception("LinearSolver::sparseSOR: Matrix singular. Maybe too few independent equations?");
+
+            double       * x_i = &x[row * nrhs];
+            double const * b_i = &b[row * nrhs];
+
+            for (size_type k = 0; k < nrhs; ++k) {
+                if (!active[k])
+                    continue;
+
+                double s = (b_i[k] - sigma[k]) / a_ii;
+
+                // see the single r.h.s. version
+                double r_i = a_ii * (s - x_i[k]);
+                residual[k] += (r_i * r_i);
+
+                double correction = omega * (s - x_i[k]);
+                l2_norm[k] += (correction * correction);
+
+                x_i[k] += correction;
+            }
+        }
+
+        bool confirm = false;
+        for (size_type k = 0; k < nrhs; ++k) {
+            residual[k] = std::sqrt(residual[k]);
+            confirm = confirm || (active[k] && checks[k].residualConverged(residual[k]));
+        }
+
+        if (confirm)
+            trueResidual(residual);
+
+        for (size_type k = 0; k < nrhs; ++k) {
+            if (!active[k])
+                continue;
+
+            if (checks[k].stop(std::sqrt(l2_norm[k] / (nrows + 1)), residual[k])) {
+                active[k] = 0;
+                --nactive;
+            }
+        }
+    }
+
+    trueResidual(residual);
+    for (size_type k = 0; k < nrhs; ++k)
+        checks[k].setResidual(residual[k]);
+
+    bool converged = true;
+
+    RHSBlock_t result(nrhs, RHS_t(nrows));
+    for (size_type k = 0; k < nrhs; ++k) {
+        for (size_type row = 0; row < nrows; ++row)
+            result[k][row] = x[row * nrhs + k];
+
+        converged = converged && stats[k].converged();
+    }
 
-    return std::make_tuple(true, x);
+    return std::make_tuple(converged, result);
 }
@@ -11,16 +11,102 @@
 
 #include <tuple>
 #include <vector>
+#include <functional>
 
 
 class CMatrix2D;
 class CSparseMatrixImpl;
 
 
+#pragma warning(disable:4251)
+
+
 struct DECL_SYMBOLS LinearSolver {
     typedef std::vector<double> RHS_t;
 
+    // several r.h.s. (or solutions) of the same system
+    typedef std::vector<RHS_t>  RHSBlock_t;
+
+    /* Termination criteria of the iterative solvers. A tolerance <= 0
+     * disables the corresponding criterion. The defaults reproduce the
+     * former hard-coded behavior: iterate until the l2 norm of the
+     * update drops below 1E-16, at most 10000 sweeps.
+     */
+    struct DECL_SYMBOLS Control {
+        // called after each sweep (see absolute_tolerance); return false to abort
+        typedef std::function<bool (unsigned int iteration, double update_norm, double residual_norm)> Monitor_t;
+
+        Control();
+
+        unsigned int max_iterations;
+
+        // (l2 norm of the update) / sqrt(n + 1)
+        double       update_tolerance;
+
+        /* l2 norm of the residual, f - A x. The solvers test the
+         * residual accumulated during the sweep, which is confirmed
+         * with f - A x once it meets a tolerance.
+         */
+        double       absolute_tolerance;
+
+        // l2 norm of the residual relative to the l2 norm of f
+        double       relative_tolerance;
+
+        /* Stop if the residual of the sweeps did not drop below
+         * stagnation_factor * (best residual so far)
+         * within stagnation_window sweeps. 0 disables the check.
+         */
+        unsigned int stagnation_window;
+        double       stagnation_factor;
+
+        Monitor_t    monitor;
+    };
+
+    /* SOLVED_DIRECT: by a direct solver, e.g. SparseLU.
+     * DIRECT_FAILED: a pivot of the direct solver was too small or its
+     * residual too large.
+     */
+    enum Reason {NOT_RUN, CONVERGED_UPDATE, CONVERGED_ABSOLUTE, CONVERGED_RELATIVE, STAGNATED, MAX_ITERATIONS, ABORTED, SOLVED_DIRECT, DIRECT_FAILED};
+
+    // reported by the iterative solvers
+    struct Statistics {
+        Statistics() : iterations(0), update_norm(0), residual_norm(0), rhs_norm(0), reason(NOT_RUN) {}
+
+        bool         converged() const {
+            return reason == CONVERGED_UPDATE || reason == CONVERGED_ABSOLUTE || reason == CONVERGED_RELATIVE || reason == SOLVED_DIRECT;
+        }
+
+        unsigned int iterations;
+
+        // after the last sweep
+        double       update_norm;
+
+        // l2 norm of f - A x of the returned solution
+        double       residual_norm;
+
+        double       rhs_norm;
+
+        Reason       reason;
+    };
+
     static std::tuple<bool, CMatrix2D const, RHS_t> GaussElim(CMatrix2D const & A, RHS_t const & f);
     static std::tuple<bool, RHS_t>                  SOR(CMatrix2D const & A, RHS_t const & f, double omega);
+    static std::tuple<bool, RHS_t>                  SOR(CMatrix2D const & A, RHS_t const & f, double omega, Control const & control, Statistics & stats);
     static std::tuple<bool, RHS_t>                  sparseSOR(CSparseMatrixImpl const & A, RHS_t const & f, double omega);
+    static std::tuple<bool, RHS_t>                  sparseSOR(CSparseMatrixImpl const & A, RHS_t const & f, double omega, Statistics & stats);
+    static std::tuple<bool, RHS_t>                  sparseSOR(CSparseMatrixImpl const & A, RHS_t const & f, double omega, Control const & control, Statistics & stats);
+
+    // start from x0 instead of from zero
+    static std::tuple<bool, RHS_t>                  sparseSOR(CSparseMatrixImpl const & A, RHS_t const & f, RHS_t const & x0, double omega, Control const & control, Statistics & stats);
+
+    /* Solve A x_k = f_k for all k at once, starting from x0_k. Each
+     * matrix element is loaded once per sweep for all r.h.s. Every
+     * r.h.s. has its own termination criteria and statistics; columns
+     * that stopped are no longer updated. Returns true if all converged.
+     */
+    static std::tuple<bool, RHSBlock_t>             sparseSOR(CSparseMatrixImpl const & A, RHSBlock_t const & f, RHSBlock_t const & x0, double omega, Control const & control, std::vector<Statistics> & stats);
+
+    static char const *                             toString(Reason reason);
 };
+
+#pragma warning(default:4251)
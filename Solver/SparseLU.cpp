@@ -0,0 +1,268 @@
+#include "SparseLU.h"
+#include "CSparseMatrixImpl.h"
+
+#include <set>
+#include <cmath>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+
+SparseLU::SparseLU(Ordering ordering) : ordering_(ordering), pivot_tolerance_(1E-12), factorized_(false) {}
+
+void
+SparseLU::setPivotTolerance(double pivot_tolerance) {
+    pivot_tolerance_ = pivot_tolerance;
+}
+
+double
+SparseLU::getPivotTolerance() const {
+    return pivot_tolerance_;
+}
+
+void
+SparseLU::factorize(CSparseMatrixImpl const & A) {
+    if (!A.finalized_)
+        throw std::exception("SparseLU::factorize(): Matrix not yet finalized");
+
+    factorized_ = false;
+
+    nelements_ = A.nelements_;
+    columns_   = A.columns_;
+
+    order(A);
+    numeric(A);
+
+    factorized_ = true;
+}
+
+void
+SparseLU::refactorize(CSparseMatrixImpl const & A) {
+    if (!factorized_ || !samePattern(A)) {
+        factorize(A);
+        return;
+    }
+
+    factorized_ = false;
+    numeric(A);
+    factorized_ = true;
+}
+
+bool
+SparseLU::isFactorized() const {
+    return factorized_;
+}
+
+boost::uint64_t
+SparseLU::size() const {
+    return diagonal_.size();
+}
+
+boost::uint64_t
+SparseLU::nonZeros() const {
+    return l_values_.size() + u_values_.size() + diagonal_.size();
+}
+
+std::vector<boost::uint64_t> const &
+SparseLU::getPermutation() const {
+    return perm_;
+}
+
+bool
+SparseLU::samePattern(CSparseMatrixImpl const & A) const {
+    return A.finalized_ && A.nelements_ == nelements_ && A.columns_ == columns_;
+}
+
+void
+SparseLU::order(CSparseMatrixImpl const & A) {
+    typedef Index_t::size_type size_type;
+    size_type n = A.nelements_.size() - 1;
+
+    if (A.ncols_ != n)
+        throw std::out_of_range("SparseLU::factorize(): Matrix not square");
+
+    // graph of A + A^T without the diagonal
+    std::vector<std::set<boost::uint64_t> > adjacency(n);
+
+    for (size_type row = 0; row < n; ++row) {
+        for (boost::uint64_t i = A.nelements_[row]; i < A.nelements_[row + 1]; ++i) {
+            boost::uint64_t col = A.columns_[i];
+            if (col == row)
+                continue;
+
+            adjacency[row].insert(col);
+            adjacency[col].insert(row);
+        }
+    }
+
+    // remaining nodes by degree, ties by index
+    typedef std::set<std::pair<size_type, boost::uint64_t> > Degree_t;
+    Degree_t degree;
+
+    if (ordering_ == MINIMUM_DEGREE)
+        for (size_type node = 0; node < n; ++node)
+            degree.insert(std::make_pair(adjacency[node].size(), node));
+
+    /* Eliminate the nodes one by one. The neighbours of a node when
+     * it is eliminated are the pattern of its row of U (and column
+     * of L); they become a clique in the elimination graph (fill).
+     */
+    perm_.assign(n, 0);
+    iperm_.assign(n, 0);
+
+    std::vector<Index_t> upper(n);
+
+    for (size_type k = 0; k < n; ++k) {
+        boost::uint64_t node = k;
+
+        if (ordering_ == MINIMUM_DEGREE) {
+            node = degree.begin()->second;
+            degree.erase(degree.begin());
+        }
+
+        perm_[node] = k;
+        iperm_[k]   = node;
+
+        std::set<boost::uint64_t> & neighbours = adjacency[node];
+        upper[k].assign(neighbours.begin(), neighbours.end());
+
+        std::for_each(neighbours.begin(), neighbours.end(), [&](boost::uint64_t other) {
+            std::set<boost::uint64_t> & other_neighbours = adjacency[other];
+
+            if (ordering_ == MINIMUM_DEGREE)
+                degree.erase(std::make_pair(other_neighbours.size(), other));
+
+            other_neighbours.erase(node);
+
+            std::for_each(neighbours.begin(), neighbours.end(), [&](boost::uint64_t fill) {
+                if (fill != other)
+                    other_neighbours.insert(fill);
+            });
+
+            if (ordering_ == MINIMUM_DEGREE)
+                degree.insert(std::make_pair(other_neighbours.size(), other));
+        });
+
+        std::set<boost::uint64_t>().swap(neighbours);
+    }
+
+
+    // symbolic factorization in the new numbering
+    u_start_.assign(1, 0);
+    u_columns_.clear();
+
+    Index_t l_count(n, 0);
+
+    for (size_type k = 0; k < n; ++k) {
+        Index_t & cols = upper[k];
+
+        std::for_each(cols.begin(), cols.end(), [&](boost::uint64_t & col) {
+            col = perm_[col];
+            l_count[col]++;
+        });
+        std::sort(cols.begin(), cols.end());
+
+        u_columns_.insert(u_columns_.end(), cols.begin(), cols.end());
+        u_start_.push_back(u_columns_.size());
+    }
+
+    // L is the transpose of the pattern of U
+    l_start_.assign(n + 1, 0);
+    for (size_type i = 0; i < n; ++i)
+        l_start_[i + 1] = l_start_[i] + l_count[i];
+
+    l_columns_.resize(l_start_[n]);
+
+    Index_t next(l_start_.begin(), l_start_.end() - 1);
+    for (size_type k = 0; k < n; ++k)
+        for (boost::uint64_t i = u_start_[k]; i < u_start_[k + 1]; ++i)
+            l_columns_[next[u_columns_[i]]++] = k;
+
+    l_values_.assign(l_columns_.size(), 0.0);
+    u_values_.assign(u_columns_.size(), 0.0);
+    diagonal_.assign(n, 0.0);
+}
+
+void
+SparseLU::numeric(CSparseMatrixImpl const & A) {
+    typedef Index_t::size_type size_type;
+    size_type n = diagonal_.size();
+
+    // row of the permuted matrix, scattered
+    Vec w(n, 0.0);
+
+    for (size_type i = 0; i < n; ++i) {
+        boost::uint64_t row = iperm_[i];
+
+        double row_max = 0.0;
+        for (boost::uint64_t j = A.nelements_[row]; j < A.nelements_[row + 1]; ++j) {
+            w[perm_[A.columns_[j]]] = A.elements_[j];
+            row_max = std::max(row_max, std::fabs(A.elements_[j]));
+        }
+
+        // eliminate with the rows above, in increasing order
+        for (boost::uint64_t j = l_start_[i]; j < l_start_[i + 1]; ++j) {
+            boost::uint64_t k = l_columns_[j];
+
+            double l_ik = w[k] / diagonal_[k];
+            l_values_[j] = l_ik;
+            w[k] = 0.0;
+
+            // all in the pattern of row i due to the fill
+            for (boost::uint64_t m = u_start_[k]; m < u_start_[k + 1]; ++m)
+                w[u_columns_[m]] -= l_ik * u_values_[m];
+        }
+
+        diagonal_[i] = w[i];
+        w[i] = 0.0;
+
+        // without pivoting a small pivot means cancellation, i.e. a useless factor (also NaN)
+        if (!(std::fabs(diagonal_[i]) > pivot_tolerance_ * row_max))
+            throw std::exception("SparseLU::factorize(): Pivot too small. Matrix singular or not diagonally dominant?");
+
+        for (boost::uint64_t m = u_start_[i]; m < u_start_[i + 1]; ++m) {
+            u_values_[m] = w[u_columns_[m]];
+            w[u_columns_[m]] = 0.0;
+        }
+    }
+}
+
+void
+SparseLU::solve(Vec const & b, Vec & x) const {
+    if (!factorized_)
+        throw std::exception("SparseLU::solve(): Matrix not yet factorized");
+
+    typedef Index_t::size_type size_type;
+    size_type n = diagonal_.size();
+
+    if (b.size() != n)
+        throw std::out_of_range("SparseLU::solve(): Size mismatch of r.h.s.");
+
+    Vec y(n);
+    for (size_type row = 0; row < n; ++row)
+        y[perm_[row]] = b[row];
+
+    // L y = P b
+    for (size_type i = 0; i < n; ++i) {
+        double sum = y[i];
+
+        for (boost::uint64_t j = l_start_[i]; j < l_start_[i + 1]; ++j)
+            sum -= l_values_[j] * y[l_columns_[j]];
+
+        y[i] = sum;
+    }
+
+    // U z = y
+    for (size_type i = n; i-- > 0;) {
+        double sum = y[i];
+
+        for (boost::uint64_t j = u_start_[i]; j < u_start_[i + 1]; ++j)
+            sum -= u_values_[j] * y[u_columns_[j]];
+
+        y[i] = sum / diagonal_[i];
+    }
+
+    x.resize(n);
+    for (size_type row = 0; row < n; ++row)
+        x[row] = y[perm_[row]];
+}
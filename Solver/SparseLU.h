@@ -0,0 +1,111 @@
+/*
+ * Name  : SparseLU
+ * Path  :
+ * Use   : Sparse direct solver for CSparseMatrixImpl.
+ *         The rows and columns are symmetrically permuted with a
+ *         fill-reducing (minimum degree) ordering of the pattern of
+ *         A + A^T. The elimination graph of the ordering yields the
+ *         pattern of the factors, which are then computed row by row
+ *         (up-looking LU). The factor is kept and reused for any
+ *         number of solves; refactorize() reuses the ordering and
+ *         the symbolic factorization for a matrix with the same
+ *         pattern, e.g. after a new time step size.
+ *         There is no pivoting, i.e. the diagonal pivots must not
+ *         vanish. This holds for diagonally dominant matrices, e.g. of
+ *         a diffusion term, but not in general: e.g. central
+ *         differences of a convection term at cell Peclet numbers
+ *         above 2 or inflow through a von Neumann face (see
+ *         ConvectionScheme) give up diagonal dominance. A pivot not
+ *         above the pivot tolerance times the largest element of its
+ *         row of A is rejected.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "DeclSpec.h"
+
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+
+class CSparseMatrixImpl;
+
+
+#pragma warning(disable:4251)
+
+
+class DECL_SYMBOLS SparseLU {
+public:
+    typedef std::vector<double> Vec;
+
+    enum Ordering {NATURAL, MINIMUM_DEGREE};
+
+public:
+    explicit SparseLU(Ordering ordering = MINIMUM_DEGREE);
+
+    // relative to the largest element of the row of A, 1E-12 by default
+    void            setPivotTolerance(double pivot_tolerance);
+    double          getPivotTolerance() const;
+
+    /* Ordering, symbolic and numeric factorization of A (after
+     * A.finalize()). Throws std::exception if a pivot is too small,
+     * see setPivotTolerance().
+     */
+    void            factorize(CSparseMatrixImpl const & A);
+
+    /* Numeric factorization only, if A has the pattern of the matrix
+     * factorized last; otherwise the same as factorize().
+     */
+    void            refactorize(CSparseMatrixImpl const & A);
+
+    bool            isFactorized() const;
+
+    // x = A^{-1} b with the cached factor
+    void            solve(Vec const & b, Vec & x) const;
+
+    boost::uint64_t size() const;
+
+    // number of stored elements of L and U, including the diagonal
+    boost::uint64_t nonZeros() const;
+
+    // the new index of each row/column
+    std::vector<boost::uint64_t> const & getPermutation() const;
+
+private:
+    typedef std::vector<boost::uint64_t> Index_t;
+
+    void            order(CSparseMatrixImpl const & A);
+    void            numeric(CSparseMatrixImpl const & A);
+    bool            samePattern(CSparseMatrixImpl const & A) const;
+
+private:
+    Ordering ordering_;
+    double   pivot_tolerance_;
+    bool     factorized_;
+
+    // pattern of the factorized matrix
+    Index_t  nelements_;
+    Index_t  columns_;
+
+    // perm_[old] = new, iperm_[new] = old
+    Index_t  perm_;
+    Index_t  iperm_;
+
+    /* Row i of the (unit lower) L in compressed row storage, the
+     * columns in increasing order.
+     */
+    Index_t  l_start_;
+    Index_t  l_columns_;
+    Vec      l_values_;
+
+    // strictly upper part of row i of U, the columns in increasing order
+    Index_t  u_start_;
+    Index_t  u_columns_;
+    Vec      u_values_;
+
+    Vec      diagonal_;
+};
+
+#pragma warning(default:4251)
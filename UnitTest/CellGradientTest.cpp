@@ -0,0 +1,241 @@
+#include "CellGradientTest.h"
+
+#include "TestMeshFactory.h"
+
+#include "FiniteVolume2DLib/CellGradient.h"
+#include "FiniteVolume2DLib/MeshGeometry.h"
+#include "FiniteVolume2DLib/InstructionSet.h"
+#include "FiniteVolume2DLib/Mesh.h"
+
+#include <cmath>
+#include <stdexcept>
+
+
+namespace {
+    // phi = 3 x - 2 y + 1 at the cell and face centroids
+    void
+    linearField(MeshGeometry const & geometry, CellGradient::Array_t & cell_values, CellGradient::Array_t & face_values) {
+        cell_values.resize(geometry.getNumberOfCells());
+        face_values.resize(geometry.getNumberOfFaces());
+
+        for (std::size_t i = 0; i < cell_values.size(); ++i)
+            cell_values[i] = 3.0 * geometry.cellCentroidX()[i] - 2.0 * geometry.cellCentroidY()[i] + 1.0;
+
+        for (std::size_t i = 0; i < face_values.size(); ++i)
+            face_values[i] = 3.0 * geometry.faceCentroidX()[i] - 2.0 * geometry.faceCentroidY()[i] + 1.0;
+    }
+
+}
+
+void
+CellGradientTest::setUp() {
+}
+
+void
+CellGradientTest::tearDown() {
+}
+
+void
+CellGradientTest::testLeastSquares() {
+    // exact for linear fields on any mesh
+    TestMeshFactory factory(7);
+    factory.setDistortion(0.3, 11);
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+    CellGradient gradient(geometry, CellGradient::LEAST_SQUARES, 1);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of cells", geometry.getNumberOfCells(), gradient.getNumberOfCells());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong stencil width", std::size_t(3), gradient.getStencilWidth());
+
+    CellGradient::Array_t cell_values, face_values, gx, gy;
+    linearField(geometry, cell_values, face_values);
+
+    gradient.compute(cell_values, face_values, gx, gy);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of gradients", geometry.getNumberOfCells(), gx.size());
+    for (std::size_t i = 0; i < gx.size(); ++i) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong x-derivative", 3.0, gx[i], 1E-10);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong y-derivative", -2.0, gy[i], 1E-10);
+    }
+}
+
+void
+CellGradientTest::testGreenGauss() {
+    // the line between the centroids passes through the face midpoints of the uniform mesh
+    TestMeshFactory factory(5);
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+    CellGradient gradient(geometry, CellGradient::GREEN_GAUSS, 1);
+
+    CellGradient::Array_t cell_values, face_values, gx, gy;
+    linearField(geometry, cell_values, face_values);
+
+    gradient.compute(cell_values, face_values, gx, gy);
+
+    for (std::size_t i = 0; i < gx.size(); ++i) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong x-derivative", 3.0, gx[i], 1E-10);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong y-derivative", -2.0, gy[i], 1E-10);
+    }
+
+    // distorted: constant fields still exact, linear fields approximately
+    TestMeshFactory distorted_factory(7);
+    distorted_factory.setDistortion(0.2, 11);
+    Mesh::CPtr distorted = distorted_factory.getMesh();
+
+    MeshGeometry distorted_geometry(*distorted);
+    CellGradient distorted_gradient(distorted_geometry, CellGradient::GREEN_GAUSS, 1);
+
+    distorted_gradient.compute(CellGradient::Array_t(distorted_geometry.getNumberOfCells(), 5.0), gx, gy);
+    for (std::size_t i = 0; i < gx.size(); ++i) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Gradient of constant field", 0.0, gx[i], 1E-10);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Gradient of constant field", 0.0, gy[i], 1E-10);
+    }
+
+    linearField(distorted_geometry, cell_values, face_values);
+    distorted_gradient.compute(cell_values, face_values, gx, gy);
+
+    double mean_x = 0.0;
+    double mean_y = 0.0;
+    for (std::size_t i = 0; i < gx.size(); ++i) {
+        mean_x += gx[i] / double(gx.size());
+        mean_y += gy[i] / double(gy.size());
+    }
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong mean x-derivative", 3.0, mean_x, 0.3);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong mean y-derivative", -2.0, mean_y, 0.2);
+}
+
+void
+CellGradientTest::testBoundary() {
+    TestMeshFactory factory(4);
+    factory.setDistortion(0.1, 11);
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+    CellGradient gradient(geometry, CellGradient::LEAST_SQUARES, 1);
+
+    CellGradient::Array_t cell_values, face_values, gx, gy;
+    linearField(geometry, cell_values, face_values);
+
+    // without the boundary values the gradient of the boundary cells is not exact
+    gradient.compute(cell_values, gx, gy);
+
+    MeshGeometry::Index_t const & face_cells = geometry.faceCells();
+    std::vector<bool> boundary_cell(geometry.getNumberOfCells(), false);
+    for (std::size_t face = 0; face < geometry.getNumberOfFaces(); ++face)
+        if (face_cells[2 * face + 1] == MeshGeometry::NO_CELL)
+            boundary_cell[face_cells[2 * face]] = true;
+
+    bool exact = true;
+    for (std::size_t i = 0; i < gx.size(); ++i)
+        if (boundary_cell[i])
+            exact = exact && std::fabs(gx[i] - 3.0) < 1E-10 && std::fabs(gy[i] + 2.0) < 1E-10;
+
+    CPPUNIT_ASSERT_MESSAGE("Boundary values not used", !exact);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE("Wrong number of cell values not detected", gradient.compute(CellGradient::Array_t(3), gx, gy), std::out_of_range);
+    CPPUNIT_ASSERT_THROW_MESSAGE("Wrong number of face values not detected", gradient.compute(cell_values, CellGradient::Array_t(3), gx, gy), std::out_of_range);
+}
+
+void
+CellGradientTest::testExtrapolated() {
+    // the exact gradient is the fixed point of the extrapolation
+    TestMeshFactory factory(6);
+    Mesh::CPtr mesh = factory.getMesh();
+
+    TestMeshFactory distorted_factory(6);
+    distorted_factory.setDistortion(0.3, 11);
+    Mesh::CPtr distorted = distorted_factory.getMesh();
+
+    Mesh::CPtr meshes[] = {mesh, distorted};
+    CellGradient::Method methods[] = {CellGradient::GREEN_GAUSS, CellGradient::LEAST_SQUARES};
+
+    for (int m = 0; m < 2; ++m) {
+        MeshGeometry geometry(*meshes[m]);
+
+        // top and bottom, a corner cell with two extrapolated faces would be underdetermined
+        std::vector<bool> extrapolated(geometry.getNumberOfFaces());
+        for (std::size_t face = 0; face < extrapolated.size(); ++face)
+            extrapolated[face] = geometry.faceCells()[2 * face + 1] == MeshGeometry::NO_CELL && std::fabs(geometry.faceCentroidY()[face] - 0.5) > 0.49;
+
+        CellGradient::Array_t cell_values, face_values, gx, gy;
+        linearField(geometry, cell_values, face_values);
+
+        // not used
+        for (std::size_t face = 0; face < extrapolated.size(); ++face)
+            if (extrapolated[face])
+                face_values[face] = 1E6;
+
+        // Green-Gauss only exact on the uniform mesh
+        for (int k = m; k < 2; ++k) {
+            CellGradient gradient(geometry, methods[k], 1, extrapolated);
+
+            gradient.compute(cell_values, face_values, gx, gy);
+
+            for (std::size_t i = 0; i < gx.size(); ++i) {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong x-derivative", 3.0, gx[i], 1E-10);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong y-derivative", -2.0, gy[i], 1E-10);
+            }
+        }
+    }
+}
+
+void
+CellGradientTest::testThreads() {
+    TestMeshFactory factory(TestMeshFactory::THREADED_SIZE);
+    factory.setDistortion(0.3, 11);
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+
+    CellGradient::Array_t cell_values(geometry.getNumberOfCells());
+    for (std::size_t i = 0; i < cell_values.size(); ++i)
+        cell_values[i] = std::sin(5.0 * geometry.cellCentroidX()[i]) * std::cos(3.0 * geometry.cellCentroidY()[i]);
+
+    CellGradient::Method methods[] = {CellGradient::GREEN_GAUSS, CellGradient::LEAST_SQUARES};
+
+    for (int m = 0; m < 2; ++m) {
+        CellGradient serial(geometry, methods[m], 1);
+        CellGradient parallel(geometry, methods[m], 4);
+
+        CellGradient::Array_t gx1, gy1, gx2, gy2;
+        serial.compute(cell_values, gx1, gy1);
+        parallel.compute(cell_values, gx2, gy2);
+
+        CPPUNIT_ASSERT_MESSAGE("Different x-derivative", gx1 == gx2);
+        CPPUNIT_ASSERT_MESSAGE("Different y-derivative", gy1 == gy2);
+    }
+}
+
+void
+CellGradientTest::testVectorKernel() {
+    // not a multiple of the vector width, with the vector path if the processor supports it
+    TestMeshFactory factory(7);
+    factory.setDistortion(0.3, 11);
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+
+    CellGradient::Array_t cell_values(geometry.getNumberOfCells());
+    for (std::size_t i = 0; i < cell_values.size(); ++i)
+        cell_values[i] = std::sin(5.0 * geometry.cellCentroidX()[i]) * std::cos(3.0 * geometry.cellCentroidY()[i]);
+
+    CellGradient gradient(geometry, CellGradient::LEAST_SQUARES, 1);
+
+    InstructionSet::Type previous = InstructionSet::active();
+
+    CellGradient::Array_t gx1, gy1, gx2, gy2;
+    InstructionSet::select(InstructionSet::SCALAR);
+    gradient.compute(cell_values, gx1, gy1);
+    InstructionSet::select(InstructionSet::AVX2);
+    gradient.compute(cell_values, gx2, gy2);
+
+    InstructionSet::select(previous);
+
+    for (std::size_t i = 0; i < gx1.size(); ++i) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Different x-derivative", gx1[i], gx2[i], 1E-12);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Different y-derivative", gy1[i], gy2[i], 1E-12);
+    }
+}
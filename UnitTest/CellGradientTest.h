@@ -0,0 +1,34 @@
+/*
+ * Name  : CellGradientTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class CellGradientTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(CellGradientTest);
+    CPPUNIT_TEST(testLeastSquares);
+    CPPUNIT_TEST(testGreenGauss);
+    CPPUNIT_TEST(testBoundary);
+    CPPUNIT_TEST(testExtrapolated);
+    CPPUNIT_TEST(testThreads);
+    CPPUNIT_TEST(testVectorKernel);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testLeastSquares();
+    void testGreenGauss();
+    void testBoundary();
+    void testExtrapolated();
+    void testThreads();
+    void testVectorKernel();
+};
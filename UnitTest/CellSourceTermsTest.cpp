@@ -0,0 +1,214 @@
+#include "CellSourceTermsTest.h"
+
+#include "TestMeshFactory.h"
+
+#include "FiniteVolume2D/CellSourceTerms.h"
+#include "FiniteVolume2D/DeferredCorrectionSolver.h"
+#include "FiniteVolume2D/DiffusionFluxEvaluator.h"
+#include "FiniteVolume2D/ComputationalMesh.h"
+#include "FiniteVolume2D/ComputationalVariableManager.h"
+
+#include "FiniteVolume2DLib/MeshGeometry.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+
+
+void
+CellSourceTermsTest::setUp() {}
+
+void
+CellSourceTermsTest::tearDown() {}
+
+void
+CellSourceTermsTest::testAssemble() {
+    TestMeshFactory factory(4);
+    factory.setDistortion(0.0, 29).setChannel(0.0, 0.0);
+
+    Mesh::Ptr mesh = factory.getMesh();
+    MeshGeometry geometry(*mesh);
+
+    DiffusionFluxEvaluator temperature(*mesh, "Temperature");
+    DiffusionFluxEvaluator concentration(*mesh, "Concentration");
+    ComputationalMesh::CPtr cmesh = factory.buildComputationalMesh({&temperature, &concentration});
+
+    ComputationalMeshSolverHelper helper(*cmesh);
+    helper.setupMatrix();
+
+    LinearSolver::RHS_t b = helper.getRHS();
+    LinearSolver::RHS_t d;
+    helper.getSparseMatrix().getDiagonal(d);
+
+    std::size_t ncells = geometry.getNumberOfCells();
+
+    CellSourceTerms::Array_t su(ncells);
+    CellSourceTerms::Array_t sp(ncells);
+    for (std::size_t cell = 0; cell < ncells; ++cell) {
+        su[cell] = 1.0 + cell;
+        sp[cell] = -0.5 * cell;
+    }
+
+    CellSourceTerms sources(*cmesh, *mesh);
+    sources.set("Concentration", su, sp);
+
+    CPPUNIT_ASSERT_MESSAGE("Source not set", sources.contains("Concentration"));
+    CPPUNIT_ASSERT_MESSAGE("Source not expected", !sources.contains("Temperature"));
+
+    sources.assemble(helper);
+
+    LinearSolver::RHS_t d_new;
+    helper.getSparseMatrix().getDiagonal(d_new);
+
+    short t = cmesh->getComputationalVariableManager().getBaseIndex("Temperature");
+    short c = cmesh->getComputationalVariableManager().getBaseIndex("Concentration");
+
+    for (std::size_t cell = 0; cell < ncells; ++cell) {
+        double volume = std::fabs(geometry.cellVolume()[cell]);
+
+        boost::uint64_t row_t = helper.getRow(cell, t);
+        boost::uint64_t row_c = helper.getRow(cell, c);
+
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong r.h.s.", b[row_c] + su[cell] * volume, helper.getRHS()[row_c], 1E-12);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong diagonal", d[row_c] - sp[cell] * volume, d_new[row_c], 1E-12);
+
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Other variable changed", b[row_t], helper.getRHS()[row_t], 0.0);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Other variable changed", d[row_t], d_new[row_t], 0.0);
+    }
+
+    // the volumes add up to the domain
+    CellSourceTerms::Array_t const & volumes = sources.getCellVolumes();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong volumes", 1.0, std::accumulate(volumes.begin(), volumes.end(), 0.0), 1E-12);
+}
+
+void
+CellSourceTermsTest::testLinearised() {
+    // no flux anywhere: the source vanishes, i.e. phi = -S_u / S_p
+    TestMeshFactory factory(6);
+    factory.setDistortion(0.0, 29).setChannel(0.0, 0.0, BoundaryConditionCollection::NEUMANN);
+
+    Mesh::Ptr mesh = factory.getMesh();
+    std::size_t ncells = MeshGeometry(*mesh).getNumberOfCells();
+
+    DiffusionFluxEvaluator evaluator(*mesh, "Phi");
+    ComputationalMesh::CPtr cmesh = factory.buildComputationalMesh({&evaluator});
+
+    CellSourceTerms sources(*cmesh, *mesh);
+    sources.set("Phi", CellSourceTerms::Array_t(ncells, 6.0), CellSourceTerms::Array_t(ncells, -2.0));
+
+    ComputationalMeshSolverHelper helper(*cmesh);
+    helper.setSolverMethod(ComputationalMeshSolverHelper::SPARSE_LU);
+    helper.setupMatrix();
+    sources.assemble(helper);
+
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solveSystem());
+
+    LinearSolver::RHS_t phi;
+    helper.gatherSolutionFromCMesh(phi);
+
+    std::for_each(phi.begin(), phi.end(), [](double value) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution", 3.0, value, 1E-10);
+    });
+}
+
+void
+CellSourceTermsTest::testPoisson() {
+    // -phi'' = 1, phi(0) = phi(1) = 0: phi = x (1 - x) / 2
+    TestMeshFactory factory(12);
+    factory.setDistortion(0.0, 29).setChannel(0.0, 0.0);
+
+    Mesh::Ptr mesh = factory.getMesh();
+    MeshGeometry geometry(*mesh);
+
+    DiffusionFluxEvaluator evaluator(*mesh, "Phi");
+    ComputationalMesh::CPtr cmesh = factory.buildComputationalMesh({&evaluator});
+
+    CellSourceTerms sources(*cmesh, *mesh);
+    sources.set("Phi", CellSourceTerms::Array_t(geometry.getNumberOfCells(), 1.0));
+
+    DeferredCorrectionSolver solver(*cmesh, *mesh, evaluator);
+    solver.setSolverMethod(ComputationalMeshSolverHelper::SPARSE_LU);
+    solver.setSource(&sources);
+
+    CPPUNIT_ASSERT_MESSAGE(DeferredCorrectionSolver::toString(solver.getStatistics().reason), solver.solve());
+
+    LinearSolver::RHS_t phi;
+    solver.getHelper().gatherSolutionFromCMesh(phi);
+
+    double error = 0.0;
+    for (std::size_t cell = 0; cell < geometry.getNumberOfCells(); ++cell) {
+        double x = geometry.cellCentroidX()[cell];
+        error = std::max(error, std::fabs(phi[cell] - 0.5 * x * (1.0 - x)));
+    }
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution", 0.0, error, 2E-3);
+
+    // without the source
+    solver.setSource(nullptr);
+    CPPUNIT_ASSERT_MESSAGE(DeferredCorrectionSolver::toString(solver.getStatistics().reason), solver.solve());
+
+    solver.getHelper().gatherSolutionFromCMesh(phi);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Source not removed", 0.0, *std::max_element(phi.begin(), phi.end()), 1E-10);
+}
+
+void
+CellSourceTermsTest::testThreads() {
+    TestMeshFactory factory(TestMeshFactory::THREADED_SIZE);
+    factory.setDistortion(0.0, 29).setChannel(0.0, 0.0);
+
+    Mesh::Ptr mesh = factory.getMesh();
+    std::size_t ncells = MeshGeometry(*mesh).getNumberOfCells();
+
+    DiffusionFluxEvaluator evaluator(*mesh, "Phi");
+    ComputationalMesh::CPtr cmesh = factory.buildComputationalMesh({&evaluator});
+
+    CellSourceTerms::Array_t su(ncells);
+    CellSourceTerms::Array_t sp(ncells);
+    for (std::size_t cell = 0; cell < ncells; ++cell) {
+        su[cell] = std::sin(0.01 * cell);
+        sp[cell] = -std::cos(0.01 * cell) - 1.0;
+    }
+
+    CellSourceTerms serial(*cmesh, *mesh, 1);
+    CellSourceTerms parallel(*cmesh, *mesh, 4);
+    serial.set("Phi", su, sp);
+    parallel.set("Phi", su, sp);
+
+    ComputationalMeshSolverHelper helper1(*cmesh);
+    ComputationalMeshSolverHelper helper4(*cmesh);
+    helper1.setupMatrix();
+    helper4.setupMatrix();
+
+    serial.assemble(helper1);
+    parallel.assemble(helper4);
+
+    LinearSolver::RHS_t d1, d4;
+    helper1.getSparseMatrix().getDiagonal(d1);
+    helper4.getSparseMatrix().getDiagonal(d4);
+
+    CPPUNIT_ASSERT_MESSAGE("Threads change the r.h.s.", helper1.getRHS() == helper4.getRHS());
+    CPPUNIT_ASSERT_MESSAGE("Threads change the diagonal", d1 == d4);
+}
+
+void
+CellSourceTermsTest::testWrongInput() {
+    TestMeshFactory factory(2);
+    factory.setDistortion(0.0, 29).setChannel(0.0, 0.0);
+
+    Mesh::Ptr mesh = factory.getMesh();
+
+    DiffusionFluxEvaluator evaluator(*mesh, "Phi");
+    ComputationalMesh::CPtr cmesh = factory.buildComputationalMesh({&evaluator});
+
+    CellSourceTerms sources(*cmesh, *mesh);
+    std::size_t ncells = sources.getNumberOfCells();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE("Unknown variable not detected", sources.set("Other", CellSourceTerms::Array_t(ncells)), std::logic_error);
+    CPPUNIT_ASSERT_THROW_MESSAGE("Wrong number of cells not detected", sources.set("Phi", CellSourceTerms::Array_t(ncells + 1)), std::out_of_range);
+    CPPUNIT_ASSERT_THROW_MESSAGE("Wrong number of cells not detected", sources.set("Phi", CellSourceTerms::Array_t(ncells), CellSourceTerms::Array_t(1)), std::out_of_range);
+
+    sources.set("Phi", CellSourceTerms::Array_t(ncells));
+    sources.remove("Phi");
+    CPPUNIT_ASSERT_MESSAGE("Source not removed", !sources.contains("Phi"));
+}
@@ -0,0 +1,32 @@
+/*
+ * Name  : CellSourceTermsTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class CellSourceTermsTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(CellSourceTermsTest);
+    CPPUNIT_TEST(testAssemble);
+    CPPUNIT_TEST(testLinearised);
+    CPPUNIT_TEST(testPoisson);
+    CPPUNIT_TEST(testThreads);
+    CPPUNIT_TEST(testWrongInput);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testAssemble();
+    void testLinearised();
+    void testPoisson();
+    void testThreads();
+    void testWrongInput();
+};
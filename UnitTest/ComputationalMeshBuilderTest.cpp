@@ -556,9 +556,86 @@ ComputationalMeshBuilderTest::cellIndexTest() {
         ComputationalCell::Ptr const & ccell = cell_thread.getEntityAt(i);
         size_t cell_index = cmesh->getCellIndex(ccell);
         CPPUNIT_ASSERT_EQUAL_MESSAGE("Linear cell index mismatch", i, cell_index);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Linear cell index mismatch", i, ccell->index());
     }
 }
 
+void
+ComputationalMeshBuilderTest::faceIndexTest() {
+    ComputationalMeshBuilder builder(mesh_, bc_);
+
+    builder.addComputationalVariable("Temperature", dummy_flux_eval);
+    builder.addEvaluateCellMolecules(cell_evaluator);
+
+    ComputationalMesh::CPtr cmesh = builder.build();
+
+    // interior faces first
+    Thread<ComputationalFace> const & interior_faces = cmesh->getFaceThread(IGeometricEntity::INTERIOR);
+    Thread<ComputationalFace> const & boundary_faces = cmesh->getFaceThread(IGeometricEntity::BOUNDARY);
+
+    for (size_t i = 0; i < interior_faces.size(); ++i)
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Linear face index mismatch", i, interior_faces.getEntityAt(i)->index());
+
+    for (size_t i = 0; i < boundary_faces.size(); ++i)
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Linear face index mismatch", interior_faces.size() + i, boundary_faces.getEntityAt(i)->index());
+}
+
+void
+ComputationalMeshBuilderTest::attributeTest() {
+    ComputationalMeshBuilder builder(mesh_, bc_);
+
+    AttributeRegistry::Handle<int>    flux_count = builder.addFaceAttribute<int>("FluxCount");
+    AttributeRegistry::Handle<Vertex> centroid   = builder.addCellAttribute<Vertex>("Centroid");
+    AttributeRegistry::Handle<double> volume     = builder.addCellAttribute<double>("Volume", -1.0);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE("Attribute declared twice", builder.addFaceAttribute<double>("FluxCount"), std::logic_error);
+    CPPUNIT_ASSERT_THROW_MESSAGE("Unknown location accepted", builder.getAttributes().declare<double>(AttributeRegistry::END, "Pressure"), std::out_of_range);
+    CPPUNIT_ASSERT_THROW_MESSAGE("Invalid handle accepted", builder.getAttributes().array(AttributeRegistry::Handle<double>()), std::out_of_range);
+
+    // the flux evaluators fill the attributes while the mesh is built
+    AttributeRegistry & attributes = builder.getAttributes();
+
+    builder.addComputationalVariable("Temperature", [&](IComputationalGridAccessor const & /*cgrid*/, ComputationalCell::Ptr const & ccell, ComputationalFace::Ptr const & cface) -> bool {
+        attributes(flux_count, *cface)++;
+        attributes(centroid, *ccell) = ccell->centroid();
+        return true;
+    });
+    builder.addEvaluateCellMolecules(cell_evaluator);
+
+    ComputationalMesh::CPtr cmesh = builder.build();
+
+    AttributeRegistry const & mesh_attributes = cmesh->getAttributes();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of faces", size_t(16), mesh_attributes.size(AttributeRegistry::FACE));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of cells", size_t(8), mesh_attributes.size(AttributeRegistry::CELL));
+
+    // interior faces are evaluated for both cells
+    IGeometricEntity::Entity_t face_types[] = {IGeometricEntity::INTERIOR, IGeometricEntity::BOUNDARY};
+    for (int t = 0; t < 2; ++t) {
+        Thread<ComputationalFace> const & faces = cmesh->getFaceThread(face_types[t]);
+
+        for (size_t i = 0; i < faces.size(); ++i)
+            CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong flux count", t == 0 ? 2 : 1, mesh_attributes(flux_count, *faces.getEntityAt(i)));
+    }
+
+    Thread<ComputationalCell> const & cells = cmesh->getCellThread();
+    for (size_t i = 0; i < cells.size(); ++i) {
+        ComputationalCell::Ptr const & ccell = cells.getEntityAt(i);
+
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong centroid", ccell->centroid().x(), mesh_attributes(centroid, *ccell).x(), 1E-15);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong centroid", ccell->centroid().y(), mesh_attributes(centroid, *ccell).y(), 1E-15);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong initial value", -1.0, mesh_attributes.array(volume)[i]);
+    }
+
+    // look up by name and type
+    CPPUNIT_ASSERT_MESSAGE("Attribute not found", bool(mesh_attributes.find<int>(AttributeRegistry::FACE, "FluxCount")));
+    CPPUNIT_ASSERT_MESSAGE("Attribute of wrong type found", !mesh_attributes.find<double>(AttributeRegistry::FACE, "FluxCount"));
+    CPPUNIT_ASSERT_MESSAGE("Attribute at wrong location found", !mesh_attributes.find<int>(AttributeRegistry::CELL, "FluxCount"));
+
+    // declared after the build
+    AttributeRegistry::Handle<Vector> gradient = cmesh->getAttributes().declare(AttributeRegistry::CELL, "Gradient", Vector(0, 0));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of cells", size_t(8), mesh_attributes.array(gradient).size());
+}
+
 void
 ComputationalMeshBuilderTest::initMesh() {
     static bool init = false;
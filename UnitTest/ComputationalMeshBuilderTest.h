@@ -29,6 +29,8 @@ class ComputationalMeshBuilderTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(addCellVarsTest);
     CPPUNIT_TEST(evaluateFluxesTest);
     CPPUNIT_TEST(cellIndexTest);
+    CPPUNIT_TEST(faceIndexTest);
+    CPPUNIT_TEST(attributeTest);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -49,6 +51,8 @@ protected:
     void addCellVarsTest();
     void evaluateFluxesTest();
     void cellIndexTest();
+    void faceIndexTest();
+    void attributeTest();
 
 private:
     void initMesh();
@@ -5,6 +5,7 @@
 #include "FiniteVolume2DLib/ASCIIMeshReader.h"
 #include "FiniteVolume2DLib/Math.h"
 #include "FiniteVolume2DLib/MeshChecker.h"
+#include "FiniteVolume2DLib/MeshGenerator.h"
 
 #include "FiniteVolume2D/ComputationalMeshBuilder.h"
 #include "FiniteVolume2D/IComputationalGridAccessor.h"
@@ -12,6 +13,7 @@
 #include <boost/filesystem.hpp>
 
 #include <algorithm>
+#include <map>
 
 #include <cmath>
 
@@ -208,6 +210,64 @@ namespace {
         return true;
     }
 
+    // same as flux_evaluator for an arbitrary variable name
+    ComputationalMeshBuilder::FluxEvaluator_t
+    namedFluxEvaluator(std::string const & var_name) {
+        return [var_name](IComputationalGridAccessor const & cgrid, ComputationalCell::Ptr const & ccell, ComputationalFace::Ptr const & cface) -> bool {
+            FluxComputationalMolecule & flux_molecule = cface->getComputationalMolecule(var_name);
+
+            if (!flux_molecule.empty())
+                return true;
+
+            flux_molecule.setCell(ccell);
+
+            ComputationalVariable::Ptr const & cvar = ccell->getComputationalVariable(var_name);
+
+            BoundaryCondition::Ptr const & bc = cface->getBoundaryCondition();
+            if (bc) {
+                if (bc->type() == BoundaryConditionCollection::DIRICHLET) {
+                    Vertex midpoint = (cface->startNode().location() + cface->endNode().location()) / 2.0;
+                    double dist = Math::dist(ccell->centroid(), midpoint);
+
+                    flux_molecule.getSourceTerm() += cface->area() / dist * bc->getValue();
+                    flux_molecule.add(*cvar, cface->area() / dist);
+                }
+                else
+                    flux_molecule.getSourceTerm() += bc->getValue();
+
+                return true;
+            }
+
+            ComputationalCell::Ptr const & cell_nbr = cgrid.getOtherCell(cface, ccell);
+            double weight = cface->area() / Math::dist(ccell->centroid(), cell_nbr->centroid());
+
+            flux_molecule.add(*cvar, weight);
+            flux_molecule.add(*cell_nbr->getComputationalVariable(var_name), -weight);
+
+            return true;
+        };
+    }
+
+    bool two_variable_cell_evaluator(ComputationalCell::Ptr const & ccell) {
+        char const * var_names[] = {"Temperature", "Temperature2"};
+
+        for (int i = 0; i < 2; ++i) {
+            ComputationalMolecule & cmolecule = ccell->getComputationalMolecule(var_names[i]);
+
+            EntityCollection<ComputationalFace> const & cface_coll = ccell->getComputationalFaces();
+            std::for_each(cface_coll.begin(), cface_coll.end(), [&](ComputationalFace::Ptr const & cface) {
+                FluxComputationalMolecule & flux_molecule = cface->getComputationalMolecule(var_names[i]);
+
+                if (flux_molecule.getCell() != ccell)
+                    flux_molecule = -flux_molecule;
+
+                cmolecule += flux_molecule;
+            });
+        }
+
+        return true;
+    }
+
 }
 
 void
@@ -437,3 +497,466 @@ ComputationalMeshSolverHelperTest::initMesh() {
         CPPUNIT_ASSERT_EQUAL_MESSAGE("Mesh check failed!", true, success);
     }
 }
+
+void
+ComputationalMeshSolverHelperTest::warmStartTest() {
+    ComputationalMeshBuilder builder(mesh_, bc_);
+
+    builder.addComputationalVariable("Temperature", flux_evaluator);
+    builder.addEvaluateCellMolecules(cell_evaluator);
+    ComputationalMesh::CPtr cmesh(builder.build());
+
+    ComputationalMeshSolverHelper helper(*cmesh);
+    CPPUNIT_ASSERT_MESSAGE("Warm start not enabled by default", helper.getWarmStart());
+
+    // the cell values are zero initially, i.e. this is a cold start
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+    unsigned int cold_iterations = helper.getSolverStatistics().iterations;
+
+    // starting from the converged solution
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+    unsigned int warm_iterations = helper.getSolverStatistics().iterations;
+
+    CPPUNIT_ASSERT_MESSAGE("Warm start did not reduce the number of iterations", warm_iterations * 10 < cold_iterations);
+
+    double flux_balance = checkFluxBalance(*cmesh, "Temperature");
+    CPPUNIT_ASSERT_MESSAGE("Flux balance error", std::fabs(flux_balance) < 1E-10);
+
+    // without warm start, the solver starts from zero again
+    helper.setWarmStart(false);
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Unexpected number of iterations", cold_iterations, helper.getSolverStatistics().iterations);
+}
+
+void
+ComputationalMeshSolverHelperTest::multipleVariablesTest() {
+    // reference solution with one variable
+    ComputationalMeshBuilder builder(mesh_, bc_);
+    builder.addComputationalVariable("Temperature", flux_evaluator);
+    builder.addEvaluateCellMolecules(cell_evaluator);
+    ComputationalMesh::CPtr cmesh(builder.build());
+
+    ComputationalMeshSolverHelper helper(*cmesh);
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+
+    // two independent variables, interleaved in the linear system
+    ComputationalMeshBuilder builder2(mesh_, bc_);
+    builder2.addComputationalVariable("Temperature", namedFluxEvaluator("Temperature"));
+    builder2.addComputationalVariable("Temperature2", namedFluxEvaluator("Temperature2"));
+    builder2.addEvaluateCellMolecules(two_variable_cell_evaluator);
+    ComputationalMesh::CPtr cmesh2(builder2.build());
+
+    ComputationalMeshSolverHelper helper2(*cmesh2);
+    helper2.setupMatrix();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong size of r.h.s.", 2 * cmesh->getCellThread().size(), helper2.getRHS().size());
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper2.solveSystem());
+
+    Thread<ComputationalCell> const & cells  = cmesh->getCellThread();
+    Thread<ComputationalCell> const & cells2 = cmesh2->getCellThread();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of cells", cells.size(), cells2.size());
+
+    for (Thread<ComputationalCell>::size_type i = 0; i < cells.size(); ++i) {
+        double T = cells.getEntityAt(i)->getComputationalMolecule("Temperature").getValue();
+
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution value", T, cells2.getEntityAt(i)->getComputationalMolecule("Temperature").getValue(), 1E-10);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution value", T, cells2.getEntityAt(i)->getComputationalMolecule("Temperature2").getValue(), 1E-10);
+    }
+}
+
+namespace {
+
+    // unit square, Dirichlet on the left and on the right, insulated otherwise
+    bool
+    generateMesh(MeshBuilderMock & mesh_builder, BoundaryConditionCollection & bc, double T_left) {
+        MeshGenerator generator(0.0, 0.0, 1.0, 1.0, 6, 6);
+        generator.setBoundaryCondition(MeshGenerator::LEFT,   BoundaryConditionCollection::DIRICHLET, T_left);
+        generator.setBoundaryCondition(MeshGenerator::RIGHT,  BoundaryConditionCollection::DIRICHLET, 0.0);
+        generator.setBoundaryCondition(MeshGenerator::TOP,    BoundaryConditionCollection::NEUMANN,   0.0);
+        generator.setBoundaryCondition(MeshGenerator::BOTTOM, BoundaryConditionCollection::NEUMANN,   0.0);
+
+        return generator.generate(mesh_builder, bc);
+    }
+
+    void
+    checkSameSystem(ComputationalMeshSolverHelper const & helper, ComputationalMeshSolverHelper const & reference) {
+        LinearSolver::RHS_t const & b     = helper.getRHS();
+        LinearSolver::RHS_t const & b_ref = reference.getRHS();
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong size of r.h.s.", b_ref.size(), b.size());
+
+        // compare the matrices by their action on some vector
+        LinearSolver::RHS_t x(b.size()), y(b.size()), y_ref(b.size());
+        for (LinearSolver::RHS_t::size_type i = 0; i < x.size(); ++i)
+            x[i] = 1.0 + double(i % 7);
+
+        helper.getSparseMatrix().multiply(x, y);
+        reference.getSparseMatrix().multiply(x, y_ref);
+
+        for (LinearSolver::RHS_t::size_type i = 0; i < b.size(); ++i) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong r.h.s.", b_ref[i], b[i], 1E-12);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong matrix", y_ref[i], y[i], 1E-12);
+        }
+    }
+
+}
+
+void
+ComputationalMeshSolverHelperTest::reevaluateBoundaryConditionTest() {
+    MeshBuilderMock mesh_builder;
+    BoundaryConditionCollection bc;
+    CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generateMesh(mesh_builder, bc, 100.0));
+
+    ComputationalMeshBuilder builder(*mesh_builder.getMesh(), bc);
+    builder.addComputationalVariable("Temperature", flux_evaluator);
+    builder.addEvaluateCellMolecules(cell_evaluator);
+    ComputationalMesh::CPtr cmesh(builder.build());
+
+    ComputationalMeshSolverHelper helper(*cmesh);
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+
+    // lower the temperature on the left boundary
+    std::vector<ComputationalFace::Ptr> changed;
+
+    Thread<ComputationalFace> const & bfaces = cmesh->getFaceThread(IGeometricEntity::BOUNDARY);
+    std::for_each(bfaces.begin(), bfaces.end(), [&changed](ComputationalFace::Ptr const & cface) {
+        BoundaryCondition::Ptr const & face_bc = cface->getBoundaryCondition();
+
+        if (face_bc->type() == BoundaryConditionCollection::DIRICHLET && face_bc->getValue() > 0.0) {
+            cface->setBoundaryCondition(std::make_shared<BoundaryCondition>(BoundaryConditionCollection::Pair(BoundaryConditionCollection::DIRICHLET, 40.0)));
+            changed.push_back(cface);
+        }
+    });
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of changed faces", std::size_t(6), changed.size());
+
+    std::vector<size_t> cell_indices = cmesh->reevaluate(changed);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of re-evaluated cells", changed.size(), cell_indices.size());
+    CPPUNIT_ASSERT_MESSAGE("Cell indices not sorted", std::is_sorted(cell_indices.begin(), cell_indices.end()));
+
+    helper.updateRows(cell_indices);
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solveSystem());
+
+
+    // reference: the mesh built with the new boundary condition
+    MeshBuilderMock mesh_builder_ref;
+    BoundaryConditionCollection bc_ref;
+    CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generateMesh(mesh_builder_ref, bc_ref, 40.0));
+
+    ComputationalMeshBuilder builder_ref(*mesh_builder_ref.getMesh(), bc_ref);
+    builder_ref.addComputationalVariable("Temperature", flux_evaluator);
+    builder_ref.addEvaluateCellMolecules(cell_evaluator);
+    ComputationalMesh::CPtr cmesh_ref(builder_ref.build());
+
+    ComputationalMeshSolverHelper helper_ref(*cmesh_ref);
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper_ref.solve());
+
+    checkSameSystem(helper, helper_ref);
+
+    Thread<ComputationalCell> const & cells     = cmesh->getCellThread();
+    Thread<ComputationalCell> const & cells_ref = cmesh_ref->getCellThread();
+
+    for (Thread<ComputationalCell>::size_type i = 0; i < cells.size(); ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution value",
+            cells_ref.getEntityAt(i)->getComputationalMolecule("Temperature").getValue(),
+            cells.getEntityAt(i)->getComputationalMolecule("Temperature").getValue(), 1E-8);
+
+    double flux_balance = checkFluxBalance(*cmesh, "Temperature");
+    CPPUNIT_ASSERT_MESSAGE("Flux balance error", std::fabs(flux_balance) < 1E-8);
+}
+
+void
+ComputationalMeshSolverHelperTest::reevaluateSourceTermTest() {
+    // heat source per cell (mesh id)
+    typedef std::map<IGeometricEntity::Id_t, double> Sources_t;
+    std::shared_ptr<Sources_t> sources = std::make_shared<Sources_t>();
+
+    auto source_cell_evaluator = [sources](ComputationalCell::Ptr const & ccell) -> bool {
+        cell_evaluator(ccell);
+
+        Sources_t::const_iterator it = sources->find(ccell->geometricEntity()->meshId());
+        if (it != sources->end())
+            ccell->getComputationalMolecule("Temperature").getSourceTerm() += it->second * ccell->volume();
+
+        return true;
+    };
+
+    MeshBuilderMock mesh_builder;
+    BoundaryConditionCollection bc;
+    CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generateMesh(mesh_builder, bc, 100.0));
+
+    ComputationalMeshBuilder builder(*mesh_builder.getMesh(), bc);
+    builder.addComputationalVariable("Temperature", flux_evaluator);
+    builder.addEvaluateCellMolecules(source_cell_evaluator);
+    ComputationalMesh::CPtr cmesh(builder.build());
+
+    ComputationalMeshSolverHelper helper(*cmesh);
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+
+    // an interior cell
+    Thread<ComputationalCell> const & cells = cmesh->getCellThread();
+    ComputationalCell::Ptr const & ccell = cells.getEntityAt(cells.size() / 2);
+    (*sources)[ccell->geometricEntity()->meshId()] = 1000.0;
+
+    std::vector<ComputationalCell::Ptr> changed(1, ccell);
+    std::vector<size_t> cell_indices = cmesh->reevaluate(std::vector<ComputationalFace::Ptr>(), changed);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of re-evaluated cells", std::size_t(1), cell_indices.size());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong cell index", cells.size() / 2, cell_indices[0]);
+
+    helper.updateRows(cell_indices);
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solveSystem());
+
+
+    // reference: the mesh built with the source
+    MeshBuilderMock mesh_builder_ref;
+    BoundaryConditionCollection bc_ref;
+    CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generateMesh(mesh_builder_ref, bc_ref, 100.0));
+
+    ComputationalMeshBuilder builder_ref(*mesh_builder_ref.getMesh(), bc_ref);
+    builder_ref.addComputationalVariable("Temperature", flux_evaluator);
+    builder_ref.addEvaluateCellMolecules(source_cell_evaluator);
+    ComputationalMesh::CPtr cmesh_ref(builder_ref.build());
+
+    ComputationalMeshSolverHelper helper_ref(*cmesh_ref);
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper_ref.solve());
+
+    checkSameSystem(helper, helper_ref);
+
+    Thread<ComputationalCell> const & cells_ref = cmesh_ref->getCellThread();
+
+    for (Thread<ComputationalCell>::size_type i = 0; i < cells.size(); ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution value",
+            cells_ref.getEntityAt(i)->getComputationalMolecule("Temperature").getValue(),
+            cells.getEntityAt(i)->getComputationalMolecule("Temperature").getValue(), 1E-8);
+}
+
+void
+ComputationalMeshSolverHelperTest::boundaryConditionSweepTest() {
+    MeshBuilderMock mesh_builder;
+    BoundaryConditionCollection bc;
+    CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generateMesh(mesh_builder, bc, 100.0));
+
+    ComputationalMeshBuilder builder(*mesh_builder.getMesh(), bc);
+    builder.addComputationalVariable("Temperature", flux_evaluator);
+    builder.addEvaluateCellMolecules(cell_evaluator);
+    ComputationalMesh::CPtr cmesh(builder.build());
+
+    ComputationalMeshSolverHelper helper(*cmesh);
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+
+    // the matrix must not change during the sweep
+    LinearSolver::RHS_t x(helper.getRHS().size()), y(x.size()), y_initial(x.size());
+    for (LinearSolver::RHS_t::size_type i = 0; i < x.size(); ++i)
+        x[i] = 1.0 + double(i % 5);
+
+    helper.getSparseMatrix().multiply(x, y_initial);
+
+    CPPUNIT_ASSERT_MESSAGE("Unchanged boundary conditions", helper.updateBoundaryConditions(bc));
+
+    double const T_lefts[] = {40.0, 70.0, 20.0};
+
+    for (std::size_t k = 0; k < sizeof(T_lefts) / sizeof(T_lefts[0]); ++k) {
+        // the same mesh, i.e. the same face ids
+        MeshBuilderMock mesh_builder_ref;
+        BoundaryConditionCollection bc_ref;
+        CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generateMesh(mesh_builder_ref, bc_ref, T_lefts[k]));
+
+        CPPUNIT_ASSERT_MESSAGE("Matrix changed", helper.updateBoundaryConditions(bc_ref));
+        CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solveSystem());
+
+        helper.getSparseMatrix().multiply(x, y);
+        for (LinearSolver::RHS_t::size_type i = 0; i < y.size(); ++i)
+            CPPUNIT_ASSERT_EQUAL_MESSAGE("Matrix changed", y_initial[i], y[i]);
+
+        // reference: the mesh built with the new boundary condition
+        ComputationalMeshBuilder builder_ref(*mesh_builder_ref.getMesh(), bc_ref);
+        builder_ref.addComputationalVariable("Temperature", flux_evaluator);
+        builder_ref.addEvaluateCellMolecules(cell_evaluator);
+        ComputationalMesh::CPtr cmesh_ref(builder_ref.build());
+
+        ComputationalMeshSolverHelper helper_ref(*cmesh_ref);
+        CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper_ref.solve());
+
+        checkSameSystem(helper, helper_ref);
+
+        Thread<ComputationalCell> const & cells     = cmesh->getCellThread();
+        Thread<ComputationalCell> const & cells_ref = cmesh_ref->getCellThread();
+
+        for (Thread<ComputationalCell>::size_type i = 0; i < cells.size(); ++i)
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution value",
+                cells_ref.getEntityAt(i)->getComputationalMolecule("Temperature").getValue(),
+                cells.getEntityAt(i)->getComputationalMolecule("Temperature").getValue(), 1E-8);
+    }
+
+
+    // a change of the type updates the matrix as well
+    MeshGenerator generator(0.0, 0.0, 1.0, 1.0, 6, 6);
+    generator.setBoundaryCondition(MeshGenerator::LEFT,   BoundaryConditionCollection::NEUMANN,   0.0);
+    generator.setBoundaryCondition(MeshGenerator::RIGHT,  BoundaryConditionCollection::DIRICHLET, 0.0);
+    generator.setBoundaryCondition(MeshGenerator::TOP,    BoundaryConditionCollection::DIRICHLET, 50.0);
+    generator.setBoundaryCondition(MeshGenerator::BOTTOM, BoundaryConditionCollection::NEUMANN,   0.0);
+
+    MeshBuilderMock mesh_builder_ref;
+    BoundaryConditionCollection bc_ref;
+    CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generator.generate(mesh_builder_ref, bc_ref));
+
+    CPPUNIT_ASSERT_MESSAGE("Matrix not changed", !helper.updateBoundaryConditions(bc_ref));
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solveSystem());
+
+    ComputationalMeshBuilder builder_ref(*mesh_builder_ref.getMesh(), bc_ref);
+    builder_ref.addComputationalVariable("Temperature", flux_evaluator);
+    builder_ref.addEvaluateCellMolecules(cell_evaluator);
+    ComputationalMesh::CPtr cmesh_ref(builder_ref.build());
+
+    ComputationalMeshSolverHelper helper_ref(*cmesh_ref);
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper_ref.solve());
+
+    checkSameSystem(helper, helper_ref);
+}
+
+void
+ComputationalMeshSolverHelperTest::multipleRHSTest() {
+    MeshBuilderMock mesh_builder;
+    BoundaryConditionCollection bc;
+    CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generateMesh(mesh_builder, bc, 100.0));
+
+    ComputationalMeshBuilder builder(*mesh_builder.getMesh(), bc);
+    builder.addComputationalVariable("Temperature", flux_evaluator);
+    builder.addEvaluateCellMolecules(cell_evaluator);
+    ComputationalMesh::CPtr cmesh(builder.build());
+
+    ComputationalMeshSolverHelper helper(*cmesh);
+    helper.setupMatrix();
+    helper.setWarmStart(false);
+
+    LinearSolver::Control control;
+    control.relative_tolerance = 1E-13;
+    helper.setSolverControl(control);
+
+    // the r.h.s. of a sweep over the temperature on the left boundary
+    double const T_lefts[] = {100.0, 40.0, 70.0, 20.0};
+    std::size_t const ncases = sizeof(T_lefts) / sizeof(T_lefts[0]);
+
+    LinearSolver::RHSBlock_t b;
+    LinearSolver::RHSBlock_t x_single;
+
+    for (std::size_t k = 0; k < ncases; ++k) {
+        MeshBuilderMock mesh_builder_k;
+        BoundaryConditionCollection bc_k;
+        CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generateMesh(mesh_builder_k, bc_k, T_lefts[k]));
+
+        CPPUNIT_ASSERT_MESSAGE("Matrix changed", helper.updateBoundaryConditions(bc_k));
+        b.push_back(helper.getRHS());
+
+        CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solveSystem());
+
+        LinearSolver::RHS_t x;
+        helper.gatherSolutionFromCMesh(x);
+        x_single.push_back(x);
+    }
+
+    LinearSolver::RHSBlock_t x_block;
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solveSystems(b, x_block));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of solutions", ncases, x_block.size());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of statistics", ncases, helper.getBlockStatistics().size());
+
+    for (std::size_t k = 0; k < ncases; ++k) {
+        CPPUNIT_ASSERT_MESSAGE("Not converged", helper.getBlockStatistics()[k].converged());
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong size of solution", x_single[k].size(), x_block[k].size());
+
+        // linear in the boundary value
+        for (LinearSolver::RHS_t::size_type i = 0; i < x_block[k].size(); ++i) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution value", x_single[k][i], x_block[k][i], 1E-10);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution value", T_lefts[k] / 100.0 * x_block[0][i], x_block[k][i], 1E-8);
+        }
+    }
+}
+
+void
+ComputationalMeshSolverHelperTest::directSolverTest() {
+    MeshBuilderMock mesh_builder;
+    BoundaryConditionCollection bc;
+    CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generateMesh(mesh_builder, bc, 100.0));
+
+    ComputationalMeshBuilder builder(*mesh_builder.getMesh(), bc);
+    builder.addComputationalVariable("Temperature", flux_evaluator);
+    builder.addEvaluateCellMolecules(cell_evaluator);
+    ComputationalMesh::CPtr cmesh(builder.build());
+
+    // reference: SOR
+    ComputationalMeshSolverHelper helper(*cmesh);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong default method", ComputationalMeshSolverHelper::SOR, helper.getSolverMethod());
+
+    LinearSolver::Control control;
+    control.relative_tolerance = 1E-14;
+    helper.setSolverControl(control);
+
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+
+    LinearSolver::RHS_t x_sor;
+    helper.gatherSolutionFromCMesh(x_sor);
+
+    helper.setSolverMethod(ComputationalMeshSolverHelper::SPARSE_LU);
+    helper.setWarmStart(false);
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solveSystem());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong reason", LinearSolver::SOLVED_DIRECT, helper.getSolverStatistics().reason);
+    CPPUNIT_ASSERT_MESSAGE("Residual too large", helper.getSolverStatistics().residual_norm < 1E-10 * helper.getSolverStatistics().rhs_norm);
+
+    LinearSolver::RHS_t x_lu;
+    helper.gatherSolutionFromCMesh(x_lu);
+
+    for (LinearSolver::RHS_t::size_type i = 0; i < x_lu.size(); ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution value", x_sor[i], x_lu[i], 1E-9);
+
+    // the sweep reuses the factor
+    MeshBuilderMock mesh_builder_ref;
+    BoundaryConditionCollection bc_ref;
+    CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generateMesh(mesh_builder_ref, bc_ref, 40.0));
+
+    CPPUNIT_ASSERT_MESSAGE("Matrix changed", helper.updateBoundaryConditions(bc_ref));
+
+    LinearSolver::RHSBlock_t b(2, helper.getRHS()), x;
+    for (LinearSolver::RHS_t::size_type i = 0; i < b[1].size(); ++i)
+        b[1][i] *= 2.0;
+
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solveSystems(b, x));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of statistics", std::size_t(2), helper.getBlockStatistics().size());
+
+    for (LinearSolver::RHS_t::size_type i = 0; i < x_lu.size(); ++i) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution value", 0.4 * x_lu[i], x[0][i], 1E-9);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution value", 0.8 * x_lu[i], x[1][i], 1E-9);
+    }
+}
+
+void
+ComputationalMeshSolverHelperTest::directSolverFailureTest() {
+    MeshBuilderMock mesh_builder;
+    BoundaryConditionCollection bc;
+    CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generateMesh(mesh_builder, bc, 100.0));
+
+    ComputationalMeshBuilder builder(*mesh_builder.getMesh(), bc);
+    builder.addComputationalVariable("Temperature", flux_evaluator);
+    builder.addEvaluateCellMolecules(cell_evaluator);
+    ComputationalMesh::CPtr cmesh(builder.build());
+
+    ComputationalMeshSolverHelper helper(*cmesh);
+    helper.setSolverMethod(ComputationalMeshSolverHelper::SPARSE_LU);
+
+    // no system before the matrix is set up
+    CPPUNIT_ASSERT_THROW_MESSAGE("Matrix modified before setup", helper.modifySparseMatrix(), std::logic_error);
+    CPPUNIT_ASSERT_THROW_MESSAGE("RHS modified before setup", helper.modifyRHS(), std::logic_error);
+
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+
+    LinearSolver::RHS_t x_lu;
+    helper.gatherSolutionFromCMesh(x_lu);
+
+    // singular, i.e. a zero pivot
+    helper.modifySparseMatrix().setZero(0);
+
+    CPPUNIT_ASSERT_MESSAGE("Failure not detected", !helper.solveSystem());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong reason", LinearSolver::DIRECT_FAILED, helper.getSolverStatistics().reason);
+
+    LinearSolver::RHS_t x;
+    helper.gatherSolutionFromCMesh(x);
+    CPPUNIT_ASSERT_MESSAGE("Solution changed", x == x_lu);
+
+}
@@ -18,6 +18,14 @@ class ComputationalMeshSolverHelperTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(rhsTest);
     CPPUNIT_TEST(solutionInMeshTest);
     CPPUNIT_TEST(checkFluxBalanceTest);
+    CPPUNIT_TEST(warmStartTest);
+    CPPUNIT_TEST(multipleVariablesTest);
+    CPPUNIT_TEST(reevaluateBoundaryConditionTest);
+    CPPUNIT_TEST(reevaluateSourceTermTest);
+    CPPUNIT_TEST(boundaryConditionSweepTest);
+    CPPUNIT_TEST(multipleRHSTest);
+    CPPUNIT_TEST(directSolverTest);
+    CPPUNIT_TEST(directSolverFailureTest);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -29,6 +37,14 @@ protected:
     void rhsTest();
     void solutionInMeshTest();
     void checkFluxBalanceTest();
+    void warmStartTest();
+    void multipleVariablesTest();
+    void reevaluateBoundaryConditionTest();
+    void reevaluateSourceTermTest();
+    void boundaryConditionSweepTest();
+    void multipleRHSTest();
+    void directSolverTest();
+    void directSolverFailureTest();
 
 private:
     void initMesh();
@@ -0,0 +1,182 @@
+#include "ConvectionSchemeTest.h"
+
+#include "TestMeshFactory.h"
+
+#include "FiniteVolume2D/ConvectionScheme.h"
+#include "FiniteVolume2D/DeferredCorrectionSolver.h"
+#include "FiniteVolume2D/DiffusionFluxEvaluator.h"
+#include "FiniteVolume2D/ComputationalMesh.h"
+
+#include "FiniteVolume2DLib/MeshGeometry.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+
+namespace {
+    /* Versteeg, Malalasekera, example 5.1 across the unit square: u = 1,
+     * phi = 1 at the left, 0 at the right, no flux at the top and the bottom
+     */
+    void
+    setChannel(TestMeshFactory & factory) {
+        factory.setDistortion(0.0, 23).setChannel(1.0, 0.0);
+    }
+
+    // solution at the cell centroids
+    LinearSolver::RHS_t
+    solve(unsigned int n, double gamma, ConvectionScheme::Scheme scheme, ConvectionScheme::Limiter limiter = ConvectionScheme::VAN_LEER,
+          DiffusionFluxEvaluator::Correction correction = DiffusionFluxEvaluator::OVER_RELAXED) {
+        TestMeshFactory factory(n);
+        setChannel(factory);
+
+        Mesh::Ptr mesh = factory.getMesh();
+
+        DiffusionFluxEvaluator evaluator(*mesh, "Phi", gamma, correction);
+        ComputationalMesh::CPtr cmesh = factory.buildComputationalMesh({&evaluator});
+
+        ConvectionScheme convection(*cmesh, *mesh, evaluator, scheme, limiter);
+        convection.setVelocity(1.0, 0.0);
+
+        DeferredCorrectionSolver solver(*cmesh, *mesh, evaluator);
+        solver.setSolverMethod(ComputationalMeshSolverHelper::SPARSE_LU);
+        solver.setConvection(&convection);
+
+        DeferredCorrectionSolver::Control control;
+        control.absolute_tolerance = 1E-11;
+        control.relative_tolerance = 0;
+        control.max_iterations     = 200;
+        solver.setControl(control);
+
+        if (!solver.solve())
+            throw std::logic_error(DeferredCorrectionSolver::toString(solver.getStatistics().reason));
+
+        LinearSolver::RHS_t phi;
+        solver.getHelper().gatherSolutionFromCMesh(phi);
+
+        return phi;
+    }
+
+    // max deviation from the exact solution
+    double
+    error(unsigned int n, double gamma, LinearSolver::RHS_t const & phi) {
+        TestMeshFactory factory(n);
+        setChannel(factory);
+
+        MeshGeometry geometry(*factory.getMesh());
+
+        double result = 0.0;
+        for (std::size_t cell = 0; cell < geometry.getNumberOfCells(); ++cell) {
+            double x = geometry.cellCentroidX()[cell];
+            double exact = 1.0 - std::expm1(x / gamma) / std::expm1(1.0 / gamma);
+
+            result = std::max(result, std::fabs(phi[cell] - exact));
+        }
+
+        return result;
+    }
+
+}
+
+void
+ConvectionSchemeTest::setUp() {}
+
+void
+ConvectionSchemeTest::tearDown() {}
+
+void
+ConvectionSchemeTest::testLimiters() {
+    ConvectionScheme::Limiter limiters[] = {ConvectionScheme::MINMOD, ConvectionScheme::VAN_LEER, ConvectionScheme::VAN_ALBADA,
+                                            ConvectionScheme::SUPERBEE, ConvectionScheme::UMIST};
+
+    std::for_each(std::begin(limiters), std::end(limiters), [](ConvectionScheme::Limiter limiter) {
+        // first order at extrema, second order for smooth fields
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Extremum not limited", 0.0, ConvectionScheme::limit(limiter, -0.5), 1E-15);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Extremum not limited", 0.0, ConvectionScheme::limit(limiter, 0.0), 1E-15);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Not second order", 1.0, ConvectionScheme::limit(limiter, 1.0), 1E-15);
+
+        // Sweby's TVD region
+        for (double r = 0.05; r < 10.0; r += 0.05) {
+            double psi = ConvectionScheme::limit(limiter, r);
+            CPPUNIT_ASSERT_MESSAGE("Outside the TVD region", psi >= 0.0 && psi <= 2.0 * r + 1E-15 && psi <= 2.0 + 1E-15);
+        }
+    });
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong minmod", 1.0, ConvectionScheme::limit(ConvectionScheme::MINMOD, 3.0), 1E-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong van Leer", 4.0 / 3.0, ConvectionScheme::limit(ConvectionScheme::VAN_LEER, 2.0), 1E-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong superbee", 1.0, ConvectionScheme::limit(ConvectionScheme::SUPERBEE, 0.5), 1E-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong superbee", 2.0, ConvectionScheme::limit(ConvectionScheme::SUPERBEE, 3.0), 1E-15);
+}
+
+void
+ConvectionSchemeTest::testLowPeclet() {
+    // cell Peclet numbers below 2: hybrid is central
+    LinearSolver::RHS_t central = solve(8, 1.0, ConvectionScheme::CENTRAL);
+    LinearSolver::RHS_t hybrid  = solve(8, 1.0, ConvectionScheme::HYBRID);
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Hybrid differs from central", 0.0, TestMeshFactory::maxDifference(central, hybrid), 1E-10);
+
+    LinearSolver::RHS_t upwind = solve(8, 1.0, ConvectionScheme::UPWIND);
+
+    CPPUNIT_ASSERT_MESSAGE("Central not more accurate than upwind", error(8, 1.0, central) < error(8, 1.0, upwind));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Central inaccurate", 0.0, error(8, 1.0, central), 5E-3);
+}
+
+void
+ConvectionSchemeTest::testBoundedness() {
+    /* cell Peclet numbers about 10; without the explicit cross-diffusion,
+     * i.e. the matrix alone decides
+     */
+    double gamma = 0.01;
+    DiffusionFluxEvaluator::Correction none = DiffusionFluxEvaluator::NONE;
+
+    ConvectionScheme::Scheme schemes[] = {ConvectionScheme::UPWIND, ConvectionScheme::HYBRID, ConvectionScheme::POWER_LAW, ConvectionScheme::TVD};
+
+    std::for_each(std::begin(schemes), std::end(schemes), [=](ConvectionScheme::Scheme scheme) {
+        LinearSolver::RHS_t phi = solve(10, gamma, scheme, ConvectionScheme::VAN_LEER, none);
+
+        CPPUNIT_ASSERT_MESSAGE(std::string("Unbounded: ") + ConvectionScheme::toString(scheme),
+                               *std::min_element(phi.begin(), phi.end()) >= -1E-9 && *std::max_element(phi.begin(), phi.end()) <= 1.0 + 1E-9);
+    });
+
+    // central oscillates
+    LinearSolver::RHS_t phi = solve(10, gamma, ConvectionScheme::CENTRAL, ConvectionScheme::VAN_LEER, none);
+    CPPUNIT_ASSERT_MESSAGE("Central expected to be unbounded",
+                           *std::min_element(phi.begin(), phi.end()) < -1E-3 || *std::max_element(phi.begin(), phi.end()) > 1.0 + 1E-3);
+}
+
+void
+ConvectionSchemeTest::testAccuracy() {
+    unsigned int n = 16;
+    double gamma = 0.1;
+
+    double upwind = error(n, gamma, solve(n, gamma, ConvectionScheme::UPWIND));
+    double tvd    = error(n, gamma, solve(n, gamma, ConvectionScheme::TVD));
+    double power  = error(n, gamma, solve(n, gamma, ConvectionScheme::POWER_LAW));
+
+    CPPUNIT_ASSERT_MESSAGE("TVD not more accurate than upwind", tvd < upwind);
+    CPPUNIT_ASSERT_MESSAGE("Power-law not more accurate than upwind", power < upwind);
+
+    // all limiters converge
+    ConvectionScheme::Limiter limiters[] = {ConvectionScheme::MINMOD, ConvectionScheme::VAN_ALBADA, ConvectionScheme::SUPERBEE, ConvectionScheme::UMIST};
+
+    std::for_each(std::begin(limiters), std::end(limiters), [=](ConvectionScheme::Limiter limiter) {
+        CPPUNIT_ASSERT_MESSAGE("TVD not more accurate than upwind", error(n, gamma, solve(n, gamma, ConvectionScheme::TVD, limiter)) < upwind);
+    });
+}
+
+void
+ConvectionSchemeTest::testWrongMassFlux() {
+    TestMeshFactory factory(2);
+    setChannel(factory);
+
+    Mesh::Ptr mesh = factory.getMesh();
+
+    DiffusionFluxEvaluator evaluator(*mesh, "Phi");
+    ComputationalMesh::CPtr cmesh = factory.buildComputationalMesh({&evaluator});
+
+    ConvectionScheme convection(*cmesh, *mesh, evaluator);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE("Wrong number of faces not detected", convection.setMassFlux(ConvectionScheme::Array_t(3)), std::out_of_range);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of faces", evaluator.getNumberOfFaces(), convection.getMassFlux().size());
+}
@@ -0,0 +1,32 @@
+/*
+ * Name  : ConvectionSchemeTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class ConvectionSchemeTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(ConvectionSchemeTest);
+    CPPUNIT_TEST(testLimiters);
+    CPPUNIT_TEST(testLowPeclet);
+    CPPUNIT_TEST(testBoundedness);
+    CPPUNIT_TEST(testAccuracy);
+    CPPUNIT_TEST(testWrongMassFlux);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testLimiters();
+    void testLowPeclet();
+    void testBoundedness();
+    void testAccuracy();
+    void testWrongMassFlux();
+};
@@ -0,0 +1,146 @@
+#include "DeferredCorrectionSolverTest.h"
+
+#include "TestMeshFactory.h"
+
+#include "FiniteVolume2D/DeferredCorrectionSolver.h"
+#include "FiniteVolume2D/DiffusionFluxEvaluator.h"
+#include "FiniteVolume2D/ComputationalMesh.h"
+
+#include "FiniteVolume2DLib/MeshGeometry.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+
+namespace {
+    // phi = x: Dirichlet left and right, no flux at the top and the bottom
+    void
+    setChannel(TestMeshFactory & factory, double perturbation) {
+        factory.setDistortion(perturbation, 17).setChannel(0.0, 1.0);
+    }
+
+    // max deviation from phi = x
+    double
+    error(MeshGeometry const & geometry, ComputationalMeshSolverHelper const & helper) {
+        LinearSolver::RHS_t phi;
+        helper.gatherSolutionFromCMesh(phi);
+
+        double result = 0.0;
+        for (std::size_t cell = 0; cell < geometry.getNumberOfCells(); ++cell)
+            result = std::max(result, std::fabs(phi[helper.getRow(cell, 0)] - geometry.cellCentroidX()[cell]));
+
+        return result;
+    }
+
+}
+
+void
+DeferredCorrectionSolverTest::setUp() {}
+
+void
+DeferredCorrectionSolverTest::tearDown() {}
+
+void
+DeferredCorrectionSolverTest::testLinearField() {
+    TestMeshFactory factory(8);
+    setChannel(factory, 0.3);
+
+    Mesh::Ptr mesh = factory.getMesh();
+    MeshGeometry geometry(*mesh);
+
+    DiffusionFluxEvaluator evaluator(*mesh, "Temperature", 2.0, DiffusionFluxEvaluator::OVER_RELAXED);
+    ComputationalMesh::CPtr cmesh = factory.buildComputationalMesh({&evaluator});
+
+    DeferredCorrectionSolver solver(*cmesh, *mesh, evaluator);
+    solver.setSolverMethod(ComputationalMeshSolverHelper::SPARSE_LU);
+
+    DeferredCorrectionSolver::Control control;
+    control.absolute_tolerance = 1E-12;
+    control.relative_tolerance = 0;
+    solver.setControl(control);
+
+    // without the correction the compact stencil is not exact on the distorted mesh
+    ComputationalMeshSolverHelper & helper = solver.getHelper();
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+    CPPUNIT_ASSERT_MESSAGE("Orthogonal part alone expected to be inexact", error(geometry, helper) > 1E-4);
+
+    CPPUNIT_ASSERT_MESSAGE(DeferredCorrectionSolver::toString(solver.getStatistics().reason), solver.solve());
+    CPPUNIT_ASSERT_MESSAGE("More than one iteration expected", solver.getStatistics().iterations > 1);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Linear field not reproduced", 0.0, error(geometry, helper), 1E-9);
+
+    // converged: no further iteration
+    CPPUNIT_ASSERT_MESSAGE("Not converged", solver.solve());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of iterations", 0u, solver.getStatistics().iterations);
+}
+
+void
+DeferredCorrectionSolverTest::testIterativeSolver() {
+    TestMeshFactory factory(6);
+    setChannel(factory, 0.25);
+
+    Mesh::Ptr mesh = factory.getMesh();
+    MeshGeometry geometry(*mesh);
+
+    DiffusionFluxEvaluator evaluator(*mesh, "Temperature", 1.0, DiffusionFluxEvaluator::MINIMUM_CORRECTION);
+    ComputationalMesh::CPtr cmesh = factory.buildComputationalMesh({&evaluator});
+
+    DeferredCorrectionSolver solver(*cmesh, *mesh, evaluator, CellGradient::LEAST_SQUARES, 2);
+
+    LinearSolver::Control linear_control;
+    linear_control.relative_tolerance = 1E-13;
+    linear_control.absolute_tolerance = 0;
+    linear_control.max_iterations     = 10000;
+    solver.setSolverControl(linear_control);
+
+    DeferredCorrectionSolver::Control control;
+    control.update_tolerance = 1E-11;
+    solver.setControl(control);
+
+    CPPUNIT_ASSERT_MESSAGE(DeferredCorrectionSolver::toString(solver.getStatistics().reason), solver.solve());
+    CPPUNIT_ASSERT_MESSAGE("Linear solver not used", solver.getStatistics().linear_iterations > 0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Linear field not reproduced", 0.0, error(geometry, solver.getHelper()), 1E-8);
+}
+
+void
+DeferredCorrectionSolverTest::testMonitor() {
+    TestMeshFactory factory(4);
+    setChannel(factory, 0.3);
+
+    Mesh::Ptr mesh = factory.getMesh();
+
+    DiffusionFluxEvaluator evaluator(*mesh, "Temperature");
+    ComputationalMesh::CPtr cmesh = factory.buildComputationalMesh({&evaluator});
+
+    DeferredCorrectionSolver solver(*cmesh, *mesh, evaluator);
+    solver.setSolverMethod(ComputationalMeshSolverHelper::SPARSE_LU);
+
+    std::vector<double> residuals;
+
+    DeferredCorrectionSolver::Control control;
+    control.monitor = [&residuals](unsigned int iteration, double residual, double) {
+        residuals.push_back(residual);
+        return iteration < 2;
+    };
+    solver.setControl(control);
+
+    CPPUNIT_ASSERT_MESSAGE("Abort expected", !solver.solve());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong reason", DeferredCorrectionSolver::ABORTED, solver.getStatistics().reason);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of iterations", 2u, solver.getStatistics().iterations);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of calls", std::size_t(3), residuals.size());
+    CPPUNIT_ASSERT_MESSAGE("Residual not decreasing", residuals[2] < residuals[1] && residuals[1] < residuals[0]);
+}
+
+void
+DeferredCorrectionSolverTest::testUnknownVariable() {
+    TestMeshFactory factory(3);
+    setChannel(factory, 0.1);
+
+    Mesh::Ptr mesh = factory.getMesh();
+
+    DiffusionFluxEvaluator evaluator(*mesh, "Temperature");
+    ComputationalMesh::CPtr cmesh = factory.buildComputationalMesh({&evaluator});
+
+    DiffusionFluxEvaluator other(*mesh, "Pressure");
+    CPPUNIT_ASSERT_THROW_MESSAGE("Unknown variable not detected", DeferredCorrectionSolver(*cmesh, *mesh, other), std::logic_error);
+}
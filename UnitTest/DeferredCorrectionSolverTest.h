@@ -0,0 +1,30 @@
+/*
+ * Name  : DeferredCorrectionSolverTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class DeferredCorrectionSolverTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(DeferredCorrectionSolverTest);
+    CPPUNIT_TEST(testLinearField);
+    CPPUNIT_TEST(testIterativeSolver);
+    CPPUNIT_TEST(testMonitor);
+    CPPUNIT_TEST(testUnknownVariable);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testLinearField();
+    void testIterativeSolver();
+    void testMonitor();
+    void testUnknownVariable();
+};
@@ -0,0 +1,159 @@
+#include "DenseLUTest.h"
+
+#include "Solver/DenseLU.h"
+#include "Solver/CMatrix2D.h"
+#include "Solver/LinearSolver.h"
+
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+
+
+namespace {
+    // deterministic, not diagonally dominant
+    CMatrix2D
+    generateMatrix(unsigned int n) {
+        CMatrix2D A(n, n);
+
+        for (unsigned int i = 0; i < n; ++i)
+            for (unsigned int j = 0; j < n; ++j)
+                A(i, j) = std::sin(double(7 * i + 3 * j + 1)) + (i == j ? 1.0 : 0.0);
+
+        return A;
+    }
+
+    std::vector<double>
+    generateRHS(unsigned int n) {
+        std::vector<double> b(n);
+        for (unsigned int i = 0; i < n; ++i)
+            b[i] = std::cos(double(i));
+
+        return b;
+    }
+
+    double
+    residualNorm(CMatrix2D const & A, std::vector<double> const & x, std::vector<double> const & b) {
+        std::vector<double> y(b.size());
+        A.solve(x, y);
+
+        double sum = 0;
+        for (std::vector<double>::size_type i = 0; i < b.size(); ++i)
+            sum += (b[i] - y[i]) * (b[i] - y[i]);
+
+        return std::sqrt(sum);
+    }
+
+}
+
+void
+DenseLUTest::setUp() {
+}
+
+void
+DenseLUTest::tearDown() {
+}
+
+void
+DenseLUTest::testSolve() {
+    // more than one block
+    unsigned int const n = 150;
+
+    CMatrix2D A = generateMatrix(n);
+    std::vector<double> b = generateRHS(n);
+
+    DenseLU lu;
+    CPPUNIT_ASSERT_MESSAGE("Factorized too early", !lu.isFactorized());
+    CPPUNIT_ASSERT_THROW_MESSAGE("Solve without factor not detected", lu.solve(b, b), std::exception);
+
+    lu.factorize(A);
+    CPPUNIT_ASSERT_MESSAGE("Not factorized", lu.isFactorized());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong size", boost::uint64_t(n), lu.size());
+
+    std::vector<double> x;
+    lu.solve(b, x);
+    CPPUNIT_ASSERT_MESSAGE("Wrong solution", residualNorm(A, x, b) < 1E-10);
+
+    // the same as Gauss-Jordan, for a diagonally dominant matrix (no row exchanges)
+    for (unsigned int i = 0; i < n; ++i)
+        A(i, i) += double(n);
+
+    lu.factorize(A);
+    lu.solve(b, x);
+
+    std::vector<double> x_gauss;
+    std::tie(std::ignore, std::ignore, x_gauss) = LinearSolver::GaussElim(A, b);
+
+    for (unsigned int i = 0; i < n; ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Different solution", x_gauss[i], x[i], 1E-12);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE("Size mismatch not detected", lu.solve(std::vector<double>(n + 1, 0.0), x), std::out_of_range);
+    CPPUNIT_ASSERT_THROW_MESSAGE("Non-square matrix not detected", lu.factorize(CMatrix2D(2, 3)), std::out_of_range);
+}
+
+void
+DenseLUTest::testPivoting() {
+    // zero on the diagonal
+    CMatrix2D A(3, 3);
+    A(0, 1) = 2.0;
+    A(1, 0) = 1.0;
+    A(1, 2) = 1.0;
+    A(2, 2) = 3.0;
+    A(2, 0) = 1.0;
+
+    std::vector<double> b(3);
+    b[0] = 2.0;
+    b[1] = 2.0;
+    b[2] = 4.0;
+
+    DenseLU lu(2);
+    lu.factorize(A);
+
+    std::vector<double> x;
+    lu.solve(b, x);
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution", 1.0, x[0], 1E-14);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution", 1.0, x[1], 1E-14);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution", 1.0, x[2], 1E-14);
+}
+
+void
+DenseLUTest::testBlockSize() {
+    unsigned int const n = 70;
+
+    CMatrix2D A = generateMatrix(n);
+    std::vector<double> b = generateRHS(n);
+
+    DenseLU unblocked(1);
+    unblocked.factorize(A);
+
+    std::vector<double> x_unblocked;
+    unblocked.solve(b, x_unblocked);
+
+    // block sizes which do and do not divide n, larger than n
+    unsigned int const block_sizes[] = {7, 16, 64, 100};
+
+    for (unsigned int k = 0; k < sizeof(block_sizes) / sizeof(block_sizes[0]); ++k) {
+        DenseLU lu(block_sizes[k]);
+        lu.factorize(A);
+
+        std::vector<double> x;
+        lu.solve(b, x);
+
+        for (unsigned int i = 0; i < n; ++i)
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Different solution", x_unblocked[i], x[i], 1E-10 * (1.0 + std::fabs(x[i])));
+    }
+}
+
+void
+DenseLUTest::testSingular() {
+    CMatrix2D A(3, 3);
+    A(0, 0) = 1.0;
+    A(0, 1) = 2.0;
+    A(1, 0) = 2.0;
+    A(1, 1) = 4.0;
+    A(2, 2) = 1.0;
+
+    DenseLU lu;
+    CPPUNIT_ASSERT_THROW_MESSAGE("Singular matrix not detected", lu.factorize(A), std::exception);
+    CPPUNIT_ASSERT_MESSAGE("Factorized", !lu.isFactorized());
+}
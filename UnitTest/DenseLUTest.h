@@ -0,0 +1,30 @@
+/*
+ * Name  : DenseLUTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class DenseLUTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(DenseLUTest);
+    CPPUNIT_TEST(testSolve);
+    CPPUNIT_TEST(testPivoting);
+    CPPUNIT_TEST(testBlockSize);
+    CPPUNIT_TEST(testSingular);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testSolve();
+    void testPivoting();
+    void testBlockSize();
+    void testSingular();
+};
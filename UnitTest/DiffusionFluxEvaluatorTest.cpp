@@ -0,0 +1,205 @@
+#include "DiffusionFluxEvaluatorTest.h"
+
+#include "TestMeshFactory.h"
+
+#include "FiniteVolume2D/DiffusionFluxEvaluator.h"
+#include "FiniteVolume2D/ComputationalMeshBuilder.h"
+#include "FiniteVolume2D/ComputationalMeshSolverHelper.h"
+#include "FiniteVolume2D/IComputationalGridAccessor.h"
+
+#include "FiniteVolume2DLib/MeshGeometry.h"
+#include "FiniteVolume2DLib/Math.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+
+namespace {
+    // Dirichlet 100 at the left, 0 at the right, no flux at the top and the bottom
+    void
+    setChannel(TestMeshFactory & factory, double perturbation) {
+        if (perturbation > 0)
+            factory.setDistortion(perturbation, 3);
+
+        factory.setChannel(100.0, 0.0);
+    }
+
+    // the orthogonal two point flux, as in Main.cpp
+    bool
+    reference_flux_evaluator(IComputationalGridAccessor const & cgrid, ComputationalCell::Ptr const & ccell, ComputationalFace::Ptr const & cface) {
+        FluxComputationalMolecule & flux_molecule = cface->getComputationalMolecule("Temperature");
+
+        if (!flux_molecule.empty())
+            return true;
+
+        flux_molecule.setCell(ccell);
+
+        ComputationalVariable::Ptr const & cvar = ccell->getComputationalVariable("Temperature");
+
+        BoundaryCondition::Ptr const & bc = cface->getBoundaryCondition();
+        if (bc) {
+            if (bc->type() == BoundaryConditionCollection::DIRICHLET) {
+                Vertex midpoint = (cface->startNode().location() + cface->endNode().location()) / 2.0;
+                double dist = Math::dist(ccell->centroid(), midpoint);
+
+                flux_molecule.getSourceTerm() += cface->area() / dist * bc->getValue();
+                flux_molecule.add(*cvar, cface->area() / dist);
+            }
+            else
+                flux_molecule.getSourceTerm() += bc->getValue();
+
+            return true;
+        }
+
+        ComputationalCell::Ptr const & cell_nbr = cgrid.getOtherCell(cface, ccell);
+        double weight = cface->area() / Math::dist(ccell->centroid(), cell_nbr->centroid());
+
+        flux_molecule.add(*cvar, weight);
+        flux_molecule.add(*cell_nbr->getComputationalVariable("Temperature"), -weight);
+
+        return true;
+    }
+
+    void
+    solve(Mesh::Ptr const & mesh, BoundaryConditionCollection const & bc, ComputationalMeshBuilder::FluxEvaluator_t const & flux_evaluator,
+          ComputationalMeshBuilder::CellMoleculeEvaluator_t const & cell_evaluator, LinearSolver::RHS_t & x) {
+        ComputationalMeshBuilder builder(mesh, bc);
+        builder.addComputationalVariable("Temperature", flux_evaluator);
+        builder.addEvaluateCellMolecules(cell_evaluator);
+
+        ComputationalMesh::CPtr cmesh = builder.build();
+
+        ComputationalMeshSolverHelper helper(*cmesh);
+        helper.setSolverMethod(ComputationalMeshSolverHelper::SPARSE_LU);
+        CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+
+        helper.gatherSolutionFromCMesh(x);
+    }
+
+}
+
+void
+DiffusionFluxEvaluatorTest::setUp() {}
+
+void
+DiffusionFluxEvaluatorTest::tearDown() {}
+
+void
+DiffusionFluxEvaluatorTest::testWeights() {
+    TestMeshFactory factory(6);
+    setChannel(factory, 0.3);
+
+    Mesh::Ptr mesh = factory.getMesh();
+    MeshGeometry geometry(*mesh);
+
+    DiffusionFluxEvaluator::Correction corrections[] = {
+        DiffusionFluxEvaluator::NONE, DiffusionFluxEvaluator::MINIMUM_CORRECTION, DiffusionFluxEvaluator::ORTHOGONAL_CORRECTION, DiffusionFluxEvaluator::OVER_RELAXED
+    };
+
+    double const gamma = 2.5;
+
+    for (int c = 0; c < 4; ++c) {
+        DiffusionFluxEvaluator evaluator(*mesh, "Temperature", gamma, corrections[c]);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of faces", geometry.getNumberOfFaces(), evaluator.getNumberOfFaces());
+
+        for (std::size_t face = 0; face < geometry.getNumberOfFaces(); ++face) {
+            boost::uint64_t c1 = evaluator.faceCells()[2 * face];
+            boost::uint64_t c2 = evaluator.faceCells()[2 * face + 1];
+
+            bool boundary = c2 == MeshGeometry::NO_CELL;
+
+            double dx = (boundary ? geometry.faceCentroidX()[face] : geometry.cellCentroidX()[c2]) - geometry.cellCentroidX()[c1];
+            double dy = (boundary ? geometry.faceCentroidY()[face] : geometry.cellCentroidY()[c2]) - geometry.cellCentroidY()[c1];
+            double dist = std::sqrt(dx * dx + dy * dy);
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong distance", dist, evaluator.distance()[face], 1E-14);
+
+            // E = coefficient |d| / gamma d / |d|
+            double ex = evaluator.coefficient()[face] / gamma * dx;
+            double ey = evaluator.coefficient()[face] / gamma * dy;
+            double tx = evaluator.correctionX()[face];
+            double ty = evaluator.correctionY()[face];
+
+            double area = geometry.faceArea()[face];
+
+            if (corrections[c] == DiffusionFluxEvaluator::NONE) {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong coefficient", gamma * area / dist, evaluator.coefficient()[face], 1E-12);
+                CPPUNIT_ASSERT_EQUAL_MESSAGE("Correction not zero", 0.0, tx);
+                CPPUNIT_ASSERT_EQUAL_MESSAGE("Correction not zero", 0.0, ty);
+                continue;
+            }
+
+            // S = E + T points away from the first cell
+            double sx = ex + tx;
+            double sy = ey + ty;
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong face vector", area, std::sqrt(sx * sx + sy * sy), 1E-12);
+            CPPUNIT_ASSERT_MESSAGE("Wrong orientation", sx * dx + sy * dy > 0);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Not a normal", 0.0, sx * geometry.faceNormalY()[face] - sy * geometry.faceNormalX()[face], 1E-12);
+
+            if (corrections[c] == DiffusionFluxEvaluator::MINIMUM_CORRECTION)
+                CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("T not normal to d", 0.0, tx * dx + ty * dy, 1E-12);
+            else if (corrections[c] == DiffusionFluxEvaluator::ORTHOGONAL_CORRECTION)
+                CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("|E| not |S|", area, std::sqrt(ex * ex + ey * ey), 1E-12);
+            else
+                CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("T not normal to S", 0.0, tx * sx + ty * sy, 1E-12);
+
+            double g = evaluator.interpolation()[face];
+            if (boundary)
+                CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong interpolation factor", 1.0, g);
+            else
+                CPPUNIT_ASSERT_MESSAGE("Wrong interpolation factor", g > 0.0 && g < 1.0);
+        }
+    }
+}
+
+void
+DiffusionFluxEvaluatorTest::testOrthogonalAsReference() {
+    TestMeshFactory factory(6);
+    setChannel(factory, 0.2);
+
+    Mesh::Ptr mesh = factory.getMesh();
+    BoundaryConditionCollection const & bc = factory.getBoundaryConditions();
+
+    DiffusionFluxEvaluator evaluator(*mesh, "Temperature", 1.0, DiffusionFluxEvaluator::NONE);
+
+    LinearSolver::RHS_t x;
+    solve(mesh, bc, evaluator, [&evaluator](ComputationalCell::Ptr const & ccell) { return evaluator.evaluateCell(ccell); }, x);
+
+    LinearSolver::RHS_t x_ref;
+    DiffusionFluxEvaluator cell_evaluator(*mesh, "Temperature");
+    solve(mesh, bc, reference_flux_evaluator, [&cell_evaluator](ComputationalCell::Ptr const & ccell) { return cell_evaluator.evaluateCell(ccell); }, x_ref);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of unknowns", x_ref.size(), x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Solution differs", x_ref[i], x[i], 1E-10);
+
+    // the implicit part of the other decompositions only differs on a non-orthogonal mesh
+    DiffusionFluxEvaluator over_relaxed(*mesh, "Temperature");
+
+    LinearSolver::RHS_t x_or;
+    solve(mesh, bc, over_relaxed, [&over_relaxed](ComputationalCell::Ptr const & ccell) { return over_relaxed.evaluateCell(ccell); }, x_or);
+
+    double diff = 0.0;
+    for (std::size_t i = 0; i < x.size(); ++i)
+        diff = std::max(diff, std::fabs(x_or[i] - x[i]));
+
+    CPPUNIT_ASSERT_MESSAGE("Over-relaxed solution expected to differ", diff > 1E-6);
+}
+
+void
+DiffusionFluxEvaluatorTest::testWrongMesh() {
+    TestMeshFactory factory(4);
+    setChannel(factory, 0.0);
+
+    TestMeshFactory small_factory(2);
+    setChannel(small_factory, 0.0);
+
+    DiffusionFluxEvaluator evaluator(*small_factory.getMesh(), "Temperature");
+
+    ComputationalMeshBuilder builder(factory.getMesh(), factory.getBoundaryConditions());
+    builder.addComputationalVariable("Temperature", evaluator);
+    builder.addEvaluateCellMolecules([&evaluator](ComputationalCell::Ptr const & ccell) { return evaluator.evaluateCell(ccell); });
+
+    CPPUNIT_ASSERT_THROW_MESSAGE("Weights of the wrong mesh not detected", builder.build(), std::logic_error);
+}
@@ -0,0 +1,28 @@
+/*
+ * Name  : DiffusionFluxEvaluatorTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class DiffusionFluxEvaluatorTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(DiffusionFluxEvaluatorTest);
+    CPPUNIT_TEST(testWeights);
+    CPPUNIT_TEST(testOrthogonalAsReference);
+    CPPUNIT_TEST(testWrongMesh);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testWeights();
+    void testOrthogonalAsReference();
+    void testWrongMesh();
+};
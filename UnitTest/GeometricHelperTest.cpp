@@ -4,6 +4,11 @@
 #include "FiniteVolume2DLib/LineSegment.h"
 #include "FiniteVolume2DLib/Ray.h"
 #include "FiniteVolume2DLib/Line.h"
+#include "FiniteVolume2DLib/InstructionSet.h"
+
+#include <vector>
+#include <random>
+#include <algorithm>
 
 
 void
@@ -222,3 +227,163 @@ GeometricHelperTest::LineSegmentLineIntersectionTest() {
         CPPUNIT_ASSERT_MESSAGE("No intersection point expected", !bool(intersection_point_opt));
     }
 }
+
+void
+GeometricHelperTest::BatchIntersectionTest() {
+    // random pairs, not a multiple of the SIMD width, compared to the single versions
+    std::size_t const n = 103;
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    std::vector<double> x0(n), y0(n), x1(n), y1(n), px(n), py(n), dx(n), dy(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        x0[i] = distribution(generator);
+        y0[i] = distribution(generator);
+        x1[i] = distribution(generator);
+        y1[i] = distribution(generator);
+        px[i] = distribution(generator);
+        py[i] = distribution(generator);
+        dx[i] = distribution(generator);
+        dy[i] = distribution(generator);
+    }
+
+    std::vector<double> s(n), t(n);
+    std::vector<GeometricHelper::IntersectionType> type(n);
+
+    for (int ray = 0; ray < 2; ++ray) {
+        if (ray)
+            GeometricHelper::intersectRays(n, &x0[0], &y0[0], &x1[0], &y1[0], &px[0], &py[0], &dx[0], &dy[0], &s[0], &t[0], &type[0]);
+        else
+            GeometricHelper::intersectLines(n, &x0[0], &y0[0], &x1[0], &y1[0], &px[0], &py[0], &dx[0], &dy[0], &s[0], &t[0], &type[0]);
+
+        std::size_t nunique = 0;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            LineSegment ls(Vertex(x0[i], y0[i]), Vertex(x1[i], y1[i]));
+            Vertex p(px[i], py[i]);
+            Vertex q(px[i] + dx[i], py[i] + dy[i]);
+
+            boost::optional<Vertex> intersection_point_opt = ray ? GeometricHelper::intersect(ls, Ray(p, q)) : GeometricHelper::intersect(ls, Line(p, q));
+
+            CPPUNIT_ASSERT_MESSAGE("Intersection type error", type[i] == GeometricHelper::UNIQUE_INTERSECTION || type[i] == GeometricHelper::EMPTY);
+            CPPUNIT_ASSERT_EQUAL_MESSAGE("Intersection type differs", bool(intersection_point_opt), type[i] == GeometricHelper::UNIQUE_INTERSECTION);
+
+            // both parameters give the same point
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Parameter error", x0[i] + s[i] * (x1[i] - x0[i]), px[i] + t[i] * dx[i], 1E-8);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Parameter error", y0[i] + s[i] * (y1[i] - y0[i]), py[i] + t[i] * dy[i], 1E-8);
+
+            if (intersection_point_opt) {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Intersection point error", intersection_point_opt->x(), x0[i] + s[i] * (x1[i] - x0[i]), 1E-10);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Intersection point error", intersection_point_opt->y(), y0[i] + s[i] * (y1[i] - y0[i]), 1E-10);
+
+                nunique++;
+            }
+        }
+
+        CPPUNIT_ASSERT_MESSAGE("Intersections expected", nunique > 0 && nunique < n);
+    }
+}
+
+void
+GeometricHelperTest::BatchParallelTest() {
+    // segment (0, 1) -> (1, 1) against the cases above; the parallel ones amid crossing ones
+    std::size_t const n = 6;
+
+    double px[n] = {0.0,  0.0, 0.5, 0.0, 1.5, 0.25};
+    double py[n] = {0.0,  0.0, 1.0, 1.0, 1.0, 2.0};
+    double dx[n] = {1.0,  2.0, 1.5, 2.0, 0.5, 0.75};
+    double dy[n] = {2.0,  1.0, 0.0, 0.0, 0.0, 2.0};
+
+    double x0[n], y0[n], x1[n], y1[n];
+    std::fill(x0, x0 + n, 0.0);
+    std::fill(y0, y0 + n, 1.0);
+    std::fill(x1, x1 + n, 1.0);
+    std::fill(y1, y1 + n, 1.0);
+
+    double s[n], t[n];
+    GeometricHelper::IntersectionType type[n];
+
+    GeometricHelper::intersectLines(n, x0, y0, x1, y1, px, py, dx, dy, s, t, type);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Intersection expected", GeometricHelper::UNIQUE_INTERSECTION, type[0]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Parameter error", 0.5, s[0], 1E-10);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Parameter error", 0.5, t[0], 1E-10);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("No intersection expected", GeometricHelper::EMPTY, type[1]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Parameter error", 2.0, s[1], 1E-10);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Overlap expected", GeometricHelper::OVERLAP, type[2]);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Overlap expected", GeometricHelper::OVERLAP, type[3]);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Overlap expected", GeometricHelper::OVERLAP, type[4]);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("No intersection expected", GeometricHelper::EMPTY, type[5]);
+
+    GeometricHelper::intersectRays(n, x0, y0, x1, y1, px, py, dx, dy, s, t, type);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Intersection expected", GeometricHelper::UNIQUE_INTERSECTION, type[0]);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Overlap expected", GeometricHelper::OVERLAP, type[2]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Overlap start error", 0.5, s[2], 1E-10);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Overlap expected", GeometricHelper::OVERLAP, type[3]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Overlap start error", 0.0, s[3], 1E-10);
+
+    // the ray starts behind the segment
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Parallel expected", GeometricHelper::EMPTY_PARALLEL, type[4]);
+
+    // the ray points away from the segment
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("No intersection expected", GeometricHelper::EMPTY, type[5]);
+    CPPUNIT_ASSERT_MESSAGE("Ray parameter error", t[5] < 0);
+
+    // parallel but not collinear
+    py[3] = 0.0;
+    GeometricHelper::intersectLines(n, x0, y0, x1, y1, px, py, dx, dy, s, t, type);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Parallel expected", GeometricHelper::EMPTY_PARALLEL, type[3]);
+}
+
+void
+GeometricHelperTest::BatchVectorTest() {
+    // random pairs, every fifth one parallel, with the scalar code and the vector path if the processor supports it
+    std::size_t const n = 103;
+
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    std::vector<double> x0(n), y0(n), x1(n), y1(n), px(n), py(n), dx(n), dy(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        x0[i] = distribution(generator);
+        y0[i] = distribution(generator);
+        x1[i] = distribution(generator);
+        y1[i] = distribution(generator);
+        px[i] = distribution(generator);
+        py[i] = distribution(generator);
+        dx[i] = i % 5 == 0 ? 2.0 * (x1[i] - x0[i]) : distribution(generator);
+        dy[i] = i % 5 == 0 ? 2.0 * (y1[i] - y0[i]) : distribution(generator);
+    }
+
+    InstructionSet::Type types[] = {InstructionSet::SCALAR, InstructionSet::AVX2};
+
+    std::vector<double> s[2], t[2];
+    std::vector<GeometricHelper::IntersectionType> type[2];
+
+    InstructionSet::Type previous = InstructionSet::active();
+
+    for (int ray = 0; ray < 2; ++ray) {
+        for (int k = 0; k < 2; ++k) {
+            s[k].assign(n, 0.0);
+            t[k].assign(n, 0.0);
+            type[k].assign(n, GeometricHelper::EMPTY);
+
+            InstructionSet::select(types[k]);
+
+            if (ray)
+                GeometricHelper::intersectRays(n, &x0[0], &y0[0], &x1[0], &y1[0], &px[0], &py[0], &dx[0], &dy[0], &s[k][0], &t[k][0], &type[k][0]);
+            else
+                GeometricHelper::intersectLines(n, &x0[0], &y0[0], &x1[0], &y1[0], &px[0], &py[0], &dx[0], &dy[0], &s[k][0], &t[k][0], &type[k][0]);
+        }
+
+        InstructionSet::select(previous);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            CPPUNIT_ASSERT_EQUAL_MESSAGE("Intersection type differs", type[0][i], type[1][i]);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Parameter differs", s[0][i], s[1][i], 1E-12);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Parameter differs", t[0][i], t[1][i], 1E-12);
+        }
+    }
+}
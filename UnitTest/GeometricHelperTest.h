@@ -15,6 +15,9 @@ class GeometricHelperTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(LineSegmentIntersectionTest);
     CPPUNIT_TEST(LineSegmentRayIntersectionTest);
     CPPUNIT_TEST(LineSegmentLineIntersectionTest);
+    CPPUNIT_TEST(BatchIntersectionTest);
+    CPPUNIT_TEST(BatchParallelTest);
+    CPPUNIT_TEST(BatchVectorTest);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -25,4 +28,7 @@ protected:
     void LineSegmentIntersectionTest();
     void LineSegmentRayIntersectionTest();
     void LineSegmentLineIntersectionTest();
+    void BatchIntersectionTest();
+    void BatchParallelTest();
+    void BatchVectorTest();
 };
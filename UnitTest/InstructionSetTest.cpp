@@ -0,0 +1,39 @@
+#include "InstructionSetTest.h"
+
+#include "FiniteVolume2DLib/InstructionSet.h"
+#include "FiniteVolume2DLib/MeshGeometry.h"
+
+#include <string>
+
+
+void
+InstructionSetTest::setUp() {}
+
+void
+InstructionSetTest::tearDown() {}
+
+void
+InstructionSetTest::testSelect() {
+    InstructionSet::Type previous = InstructionSet::active();
+
+    InstructionSet::Type scalar = InstructionSet::select(InstructionSet::SCALAR);
+    std::string scalar_name = MeshGeometry::instructionSet();
+
+    // limited to the processor
+    InstructionSet::Type best = InstructionSet::select(InstructionSet::AVX2);
+    InstructionSet::Type active = InstructionSet::active();
+    std::string best_name = MeshGeometry::instructionSet();
+
+    InstructionSet::select(previous);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Scalar not selected", InstructionSet::SCALAR, scalar);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong instruction set of the kernels", std::string("scalar"), scalar_name);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Not limited to the processor", InstructionSet::supported(), best);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong active instruction set", best, active);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong instruction set of the kernels", std::string(InstructionSet::toString(best)), best_name);
+
+#if !defined(FV2D_AVX2_KERNELS)
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("No AVX2 kernels compiled", InstructionSet::SCALAR, InstructionSet::supported());
+#endif
+}
@@ -0,0 +1,24 @@
+/*
+ * Name  : InstructionSetTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class InstructionSetTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(InstructionSetTest);
+    CPPUNIT_TEST(testSelect);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testSelect();
+};
@@ -0,0 +1,159 @@
+#include "InterpolationOperatorTest.h"
+
+#include "TestMeshFactory.h"
+
+#include "FiniteVolume2D/InterpolationOperator.h"
+
+#include "FiniteVolume2DLib/MeshGeometry.h"
+#include "FiniteVolume2DLib/Mesh.h"
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace {
+    // phi = 2 x + 5 y - 1
+    double
+    linear(double x, double y) {
+        return 2.0 * x + 5.0 * y - 1.0;
+    }
+
+}
+
+void
+InterpolationOperatorTest::setUp() {
+}
+
+void
+InterpolationOperatorTest::tearDown() {
+}
+
+void
+InterpolationOperatorTest::testInverseDistance() {
+    TestMeshFactory factory(5);
+    factory.setDistortion(0.2, 23);
+
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+
+    InterpolationOperator::Location locations[] = {InterpolationOperator::NODE, InterpolationOperator::FACE};
+
+    for (int l = 0; l < 2; ++l) {
+        InterpolationOperator op(geometry, locations[l], InterpolationOperator::INVERSE_DISTANCE, 1);
+
+        std::size_t nrows = locations[l] == InterpolationOperator::NODE ? geometry.getNumberOfNodes() : geometry.getNumberOfFaces();
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of rows", nrows, op.getNumberOfRows());
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of rows", boost::uint64_t(nrows), op.getMatrix().rows());
+
+        // convex combinations: constant fields are kept, values stay within the bounds
+        InterpolationOperator::Array_t values;
+        op.apply(InterpolationOperator::Array_t(geometry.getNumberOfCells(), 4.0), values);
+
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of values", nrows, values.size());
+        for (std::size_t i = 0; i < values.size(); ++i)
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Constant field not kept", 4.0, values[i], 1E-12);
+
+        InterpolationOperator::Array_t cell_values(geometry.getNumberOfCells());
+        for (std::size_t i = 0; i < cell_values.size(); ++i)
+            cell_values[i] = linear(geometry.cellCentroidX()[i], geometry.cellCentroidY()[i]);
+
+        op.apply(cell_values, values);
+
+        double min = *std::min_element(cell_values.begin(), cell_values.end());
+        double max = *std::max_element(cell_values.begin(), cell_values.end());
+        for (std::size_t i = 0; i < values.size(); ++i)
+            CPPUNIT_ASSERT_MESSAGE("Value out of bounds", values[i] >= min - 1E-12 && values[i] <= max + 1E-12);
+    }
+
+    // faces: the two cells of the face
+    InterpolationOperator op(geometry, InterpolationOperator::FACE, InterpolationOperator::INVERSE_DISTANCE, 1);
+
+    MeshGeometry::Index_t const & face_cells = geometry.faceCells();
+
+    boost::uint64_t nweights = 0;
+    for (std::size_t face = 0; face < geometry.getNumberOfFaces(); ++face)
+        nweights += face_cells[2 * face + 1] == MeshGeometry::NO_CELL ? 1 : 2;
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of weights", nweights, op.getMatrix().nonZeros());
+
+    InterpolationOperator::Array_t cell_values(geometry.getNumberOfCells(), 0.0), values;
+    cell_values[0] = 1.0;
+    op.apply(cell_values, values);
+
+    for (std::size_t face = 0; face < geometry.getNumberOfFaces(); ++face)
+        if (face_cells[2 * face] != 0 && face_cells[2 * face + 1] != 0)
+            CPPUNIT_ASSERT_EQUAL_MESSAGE("Weight of a cell not at the face", 0.0, values[face]);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE("Wrong number of cell values not detected", op.apply(InterpolationOperator::Array_t(3), values), std::out_of_range);
+}
+
+void
+InterpolationOperatorTest::testPseudoLaplacian() {
+    // linear fields are exact wherever the cells span the plane
+    TestMeshFactory factory(6);
+    factory.setDistortion(0.3, 23);
+
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+
+    InterpolationOperator::Array_t cell_values(geometry.getNumberOfCells());
+    for (std::size_t i = 0; i < cell_values.size(); ++i)
+        cell_values[i] = linear(geometry.cellCentroidX()[i], geometry.cellCentroidY()[i]);
+
+    InterpolationOperator faces(geometry, InterpolationOperator::FACE, InterpolationOperator::PSEUDO_LAPLACIAN, 1);
+
+    InterpolationOperator::Array_t values;
+    faces.apply(cell_values, values);
+
+    for (std::size_t face = 0; face < geometry.getNumberOfFaces(); ++face)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong face value", linear(geometry.faceCentroidX()[face], geometry.faceCentroidY()[face]), values[face], 1E-10);
+
+    InterpolationOperator nodes(geometry, InterpolationOperator::NODE, InterpolationOperator::PSEUDO_LAPLACIAN, 1);
+    nodes.apply(cell_values, values);
+
+    // cells per node
+    std::vector<int> ncells(geometry.getNumberOfNodes(), 0);
+    for (std::size_t i = 0; i < geometry.cellNodes().size(); ++i)
+        ncells[geometry.cellNodes()[i]]++;
+
+    std::size_t nexact = 0;
+    for (std::size_t node = 0; node < geometry.getNumberOfNodes(); ++node) {
+        if (ncells[node] < 3)
+            continue;
+
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong node value", linear(geometry.nodeX()[node], geometry.nodeY()[node]), values[node], 1E-10);
+        nexact++;
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Too few nodes checked", nexact > geometry.getNumberOfNodes() / 2);
+}
+
+void
+InterpolationOperatorTest::testThreads() {
+    TestMeshFactory factory(TestMeshFactory::THREADED_SIZE);
+    factory.setDistortion(0.3, 23);
+
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+
+    InterpolationOperator::Array_t cell_values(geometry.getNumberOfCells());
+    for (std::size_t i = 0; i < cell_values.size(); ++i)
+        cell_values[i] = std::sin(4.0 * geometry.cellCentroidX()[i]) + geometry.cellCentroidY()[i];
+
+    InterpolationOperator::Location locations[] = {InterpolationOperator::NODE, InterpolationOperator::FACE};
+
+    for (int l = 0; l < 2; ++l) {
+        InterpolationOperator serial(geometry, locations[l], InterpolationOperator::PSEUDO_LAPLACIAN, 1);
+        InterpolationOperator parallel(geometry, locations[l], InterpolationOperator::PSEUDO_LAPLACIAN, 4);
+
+        InterpolationOperator::Array_t values1, values2;
+        serial.apply(cell_values, values1);
+        parallel.apply(cell_values, values2);
+
+        CPPUNIT_ASSERT_MESSAGE("Different values", values1 == values2);
+    }
+}
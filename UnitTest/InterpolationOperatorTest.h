@@ -0,0 +1,28 @@
+/*
+ * Name  : InterpolationOperatorTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class InterpolationOperatorTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(InterpolationOperatorTest);
+    CPPUNIT_TEST(testInverseDistance);
+    CPPUNIT_TEST(testPseudoLaplacian);
+    CPPUNIT_TEST(testThreads);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testInverseDistance();
+    void testPseudoLaplacian();
+    void testThreads();
+};
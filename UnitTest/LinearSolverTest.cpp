@@ -0,0 +1,382 @@
+#include "LinearSolverTest.h"
+
+#include "Solver/LinearSolver.h"
+#include "Solver/CSparseMatrixImpl.h"
+#include "Solver/CMatrix2D.h"
+
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+
+
+namespace {
+    // 1D Laplacian with Dirichlet ends, -x_{i-1} + 2 x_i - x_{i+1} = f_i
+    void laplacian(CSparseMatrixImpl & A, std::vector<double> & f, unsigned int n) {
+        f.assign(n, 0.0);
+
+        for (unsigned int i = 0; i < n; ++i) {
+            A(i, i) = 2.0;
+            if (i > 0)
+                A(i, i - 1) = -1.0;
+            if (i + 1 < n)
+                A(i, i + 1) = -1.0;
+        }
+
+        // boundary values 1 and 0
+        f[0] = 1.0;
+
+        A.finalize();
+    }
+
+    // exact solution of the system above
+    double exact(unsigned int i, unsigned int n) {
+        return 1.0 - double(i + 1) / double(n + 1);
+    }
+
+}
+
+void
+LinearSolverTest::setUp() {
+}
+
+void
+LinearSolverTest::tearDown() {
+}
+
+void
+LinearSolverTest::testDefaultControl() {
+    unsigned int const n = 20;
+
+    CSparseMatrixImpl A(n);
+    std::vector<double> f;
+    laplacian(A, f, n);
+
+    LinearSolver::Statistics stats;
+    bool success;
+    std::vector<double> x;
+    std::tie(success, x) = LinearSolver::sparseSOR(A, f, 1.5, LinearSolver::Control(), stats);
+
+    CPPUNIT_ASSERT_MESSAGE("Solver did not converge", success);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong reason", LinearSolver::CONVERGED_UPDATE, stats.reason);
+    CPPUNIT_ASSERT_MESSAGE("No iterations reported", stats.iterations > 0 && stats.iterations < 10000);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong rhs norm", 1.0, stats.rhs_norm, 1E-15);
+
+    for (unsigned int i = 0; i < n; ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution", exact(i, n), x[i], 1E-12);
+
+    // the former interface behaves the same
+    std::vector<double> x_old;
+    std::tie(success, x_old) = LinearSolver::sparseSOR(A, f, 1.5);
+    CPPUNIT_ASSERT_MESSAGE("Solver did not converge", success);
+    CPPUNIT_ASSERT_MESSAGE("Different solution", x == x_old);
+}
+
+void
+LinearSolverTest::testRelativeTolerance() {
+    unsigned int const n = 20;
+
+    CSparseMatrixImpl A(n);
+    std::vector<double> f;
+    laplacian(A, f, n);
+
+    LinearSolver::Statistics stats_default;
+    std::vector<double> x;
+    std::tie(std::ignore, x) = LinearSolver::sparseSOR(A, f, 1.5, stats_default);
+
+    LinearSolver::Control control;
+    control.relative_tolerance = 1E-6;
+
+    LinearSolver::Statistics stats;
+    bool success;
+    std::tie(success, x) = LinearSolver::sparseSOR(A, f, 1.5, control, stats);
+
+    CPPUNIT_ASSERT_MESSAGE("Solver did not converge", success);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong reason", LinearSolver::CONVERGED_RELATIVE, stats.reason);
+    CPPUNIT_ASSERT_MESSAGE("Residual above tolerance", stats.residual_norm <= 1E-6 * stats.rhs_norm);
+    CPPUNIT_ASSERT_MESSAGE("No early termination", stats.iterations < stats_default.iterations);
+
+    // check the true residual
+    std::vector<double> Ax(n);
+    A.solve(x, Ax);
+
+    double residual = 0;
+    for (unsigned int i = 0; i < n; ++i)
+        residual += (f[i] - Ax[i]) * (f[i] - Ax[i]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong residual reported", std::sqrt(residual), stats.residual_norm, 1E-14);
+}
+
+void
+LinearSolverTest::testAbsoluteTolerance() {
+    unsigned int const n = 20;
+
+    CSparseMatrixImpl A(n);
+    std::vector<double> f;
+    laplacian(A, f, n);
+
+    LinearSolver::Control control;
+    control.absolute_tolerance = 1E-8;
+
+    LinearSolver::Statistics stats;
+    bool success;
+    std::tie(success, std::ignore) = LinearSolver::sparseSOR(A, f, 1.5, control, stats);
+
+    CPPUNIT_ASSERT_MESSAGE("Solver did not converge", success);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong reason", LinearSolver::CONVERGED_ABSOLUTE, stats.reason);
+    CPPUNIT_ASSERT_MESSAGE("Residual above tolerance", stats.residual_norm <= 1E-8);
+}
+
+void
+LinearSolverTest::testMaxIterations() {
+    unsigned int const n = 50;
+
+    CSparseMatrixImpl A(n);
+    std::vector<double> f;
+    laplacian(A, f, n);
+
+    LinearSolver::Control control;
+    control.max_iterations = 5;
+
+    LinearSolver::Statistics stats;
+    bool success;
+    std::tie(success, std::ignore) = LinearSolver::sparseSOR(A, f, 1.0, control, stats);
+
+    CPPUNIT_ASSERT_MESSAGE("Solver converged unexpectedly", !success);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong reason", LinearSolver::MAX_ITERATIONS, stats.reason);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of iterations", 5u, stats.iterations);
+}
+
+void
+LinearSolverTest::testStagnation() {
+    unsigned int const n = 50;
+
+    CSparseMatrixImpl A(n);
+    std::vector<double> f;
+    laplacian(A, f, n);
+
+    // demand a reduction the solver cannot deliver within the window
+    LinearSolver::Control control;
+    control.stagnation_window = 10;
+    control.stagnation_factor = 1E-3;
+
+    LinearSolver::Statistics stats;
+    bool success;
+    std::tie(success, std::ignore) = LinearSolver::sparseSOR(A, f, 1.0, control, stats);
+
+    CPPUNIT_ASSERT_MESSAGE("Solver converged unexpectedly", !success);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong reason", LinearSolver::STAGNATED, stats.reason);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of iterations", 11u, stats.iterations);
+}
+
+void
+LinearSolverTest::testMonitor() {
+    unsigned int const n = 20;
+
+    CSparseMatrixImpl A(n);
+    std::vector<double> f;
+    laplacian(A, f, n);
+
+    std::vector<unsigned int> iterations;
+    std::vector<double> residuals;
+
+    LinearSolver::Control control;
+    control.monitor = [&](unsigned int iteration, double /*update_norm*/, double residual_norm) {
+        iterations.push_back(iteration);
+        residuals.push_back(residual_norm);
+        return iteration < 7;
+    };
+
+    LinearSolver::Statistics stats;
+    bool success;
+    std::vector<double> x;
+    std::tie(success, x) = LinearSolver::sparseSOR(A, f, 1.0, control, stats);
+
+    CPPUNIT_ASSERT_MESSAGE("Solver converged unexpectedly", !success);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong reason", LinearSolver::ABORTED, stats.reason);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of monitor calls", std::size_t(7), iterations.size());
+
+    for (std::size_t i = 0; i < iterations.size(); ++i)
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong iteration", static_cast<unsigned int>(i + 1), iterations[i]);
+
+    CPPUNIT_ASSERT_MESSAGE("Residual not decreasing", residuals.back() < residuals.front());
+
+    // the monitor sees the residual of the sweeps, the statistics f - A x
+    std::vector<double> Ax(n);
+    A.solve(x, Ax);
+
+    double residual = 0;
+    for (unsigned int i = 0; i < n; ++i)
+        residual += (f[i] - Ax[i]) * (f[i] - Ax[i]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong residual reported", std::sqrt(residual), stats.residual_norm, 1E-14);
+}
+
+void
+LinearSolverTest::testDenseSOR() {
+    unsigned int const n = 10;
+
+    CMatrix2D A(n, n);
+    std::vector<double> f(n, 0.0);
+
+    for (unsigned int i = 0; i < n; ++i) {
+        A(i, i) = 2.0;
+        if (i > 0)
+            A(i, i - 1) = -1.0;
+        if (i + 1 < n)
+            A(i, i + 1) = -1.0;
+    }
+    f[0] = 1.0;
+
+    LinearSolver::Control control;
+    control.relative_tolerance = 1E-10;
+
+    LinearSolver::Statistics stats;
+    bool success;
+    std::vector<double> x;
+    std::tie(success, x) = LinearSolver::SOR(A, f, 1.5, control, stats);
+
+    CPPUNIT_ASSERT_MESSAGE("Solver did not converge", success);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong reason", LinearSolver::CONVERGED_RELATIVE, stats.reason);
+
+    for (unsigned int i = 0; i < n; ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution", exact(i, n), x[i], 1E-8);
+}
+
+void
+LinearSolverTest::testInitialGuess() {
+    unsigned int const n = 20;
+
+    CSparseMatrixImpl A(n);
+    std::vector<double> f;
+    laplacian(A, f, n);
+
+    LinearSolver::Statistics cold;
+    std::tie(std::ignore, std::ignore) = LinearSolver::sparseSOR(A, f, 1.5, LinearSolver::Control(), cold);
+
+    // start next to the exact solution
+    std::vector<double> x0(n);
+    for (unsigned int i = 0; i < n; ++i)
+        x0[i] = exact(i, n) + 1E-6;
+
+    LinearSolver::Statistics warm;
+    bool success;
+    std::vector<double> x;
+    std::tie(success, x) = LinearSolver::sparseSOR(A, f, x0, 1.5, LinearSolver::Control(), warm);
+
+    CPPUNIT_ASSERT_MESSAGE("Solver did not converge", success);
+    CPPUNIT_ASSERT_MESSAGE("Initial guess did not reduce the number of iterations", warm.iterations < cold.iterations);
+
+    for (unsigned int i = 0; i < n; ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution", exact(i, n), x[i], 1E-12);
+
+    // starting from zero explicitly is the same as the default
+    LinearSolver::Statistics zero;
+    std::tie(std::ignore, std::ignore) = LinearSolver::sparseSOR(A, f, std::vector<double>(n, 0.0), 1.5, LinearSolver::Control(), zero);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Different number of iterations", cold.iterations, zero.iterations);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE("Size mismatch not detected", LinearSolver::sparseSOR(A, f, std::vector<double>(n + 1, 0.0), 1.5, LinearSolver::Control(), zero), std::out_of_range);
+}
+
+void
+LinearSolverTest::testMatrixOperations() {
+    unsigned int const n = 5;
+
+    CSparseMatrixImpl A(n);
+    std::vector<double> f;
+    laplacian(A, f, n);
+
+    std::vector<double> x(n), y(n);
+    for (unsigned int i = 0; i < n; ++i)
+        x[i] = double(i + 1);
+
+    // A x for x = 1, 2, ..., n
+    A.multiply(x, y);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong size", std::size_t(n), y.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong product", 0.0, y[0], 1E-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong product", 0.0, y[2], 1E-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong product", double(n + 1), y[n - 1], 1E-15);
+
+    std::vector<double> d;
+    A.getDiagonal(d);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong size", std::size_t(n), d.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong diagonal", 2.0, d[3], 1E-15);
+
+    A.scale(0.5);
+    A.multiply(x, y);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong scaled product", 0.5 * double(n + 1), y[n - 1], 1E-15);
+
+    // 3 x_i - (x_{i-1} + x_{i+1}) / 2
+    d.assign(n, 3.0);
+    A.setDiagonal(d);
+    A.multiply(x, y);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong product", 6.0, y[2], 1E-15);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Sparsity pattern changed", boost::uint64_t(3 * n - 2), A.nonZeros());
+
+    // no stored diagonal element
+    CSparseMatrixImpl B(2);
+    B(0, 1) = 1.0;
+    B(1, 1) = 1.0;
+    B.finalize();
+    CPPUNIT_ASSERT_THROW_MESSAGE("Missing diagonal not detected", B.getDiagonal(d), std::out_of_range);
+}
+
+void
+LinearSolverTest::testBlockSOR() {
+    unsigned int const n    = 20;
+    unsigned int const nrhs = 3;
+
+    CSparseMatrixImpl A(n);
+    std::vector<double> f;
+    laplacian(A, f, n);
+
+    // boundary values 1, 2 and 3, i.e. scaled solutions
+    LinearSolver::RHSBlock_t F(nrhs, f);
+    for (unsigned int k = 0; k < nrhs; ++k)
+        F[k][0] = double(k + 1);
+
+    LinearSolver::RHSBlock_t X0(nrhs, std::vector<double>(n, 0.0));
+
+    LinearSolver::Control control;
+    control.relative_tolerance = 1E-14;
+
+    std::vector<LinearSolver::Statistics> stats;
+    bool success;
+    LinearSolver::RHSBlock_t X;
+    std::tie(success, X) = LinearSolver::sparseSOR(A, F, X0, 1.5, control, stats);
+
+    CPPUNIT_ASSERT_MESSAGE("Solver did not converge", success);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of solutions", std::size_t(nrhs), X.size());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of statistics", std::size_t(nrhs), stats.size());
+
+    // the same iterates as the individual solves
+    for (unsigned int k = 0; k < nrhs; ++k) {
+        LinearSolver::Statistics single;
+        std::vector<double> x;
+        std::tie(std::ignore, x) = LinearSolver::sparseSOR(A, F[k], X0[k], 1.5, control, single);
+
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Different number of iterations", single.iterations, stats[k].iterations);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Different reason", single.reason, stats[k].reason);
+
+        for (unsigned int i = 0; i < n; ++i) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Different solution", x[i], X[k][i], 1E-15);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution", (k + 1) * exact(i, n), X[k][i], 1E-12);
+        }
+    }
+
+    // blocked product, interleaved storage
+    std::vector<double> Xi(n * nrhs), Yi(n * nrhs), y(n);
+    for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int k = 0; k < nrhs; ++k)
+            Xi[i * nrhs + k] = X[k][i];
+
+    A.multiply(Xi, Yi, nrhs);
+
+    for (unsigned int k = 0; k < nrhs; ++k) {
+        A.multiply(X[k], y);
+
+        for (unsigned int i = 0; i < n; ++i)
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong blocked product", y[i], Yi[i * nrhs + k], 1E-15);
+    }
+
+    CPPUNIT_ASSERT_THROW_MESSAGE("Size mismatch not detected", A.multiply(Xi, Yi, nrhs + 1), std::out_of_range);
+    CPPUNIT_ASSERT_THROW_MESSAGE("Size mismatch not detected",
+        LinearSolver::sparseSOR(A, F, LinearSolver::RHSBlock_t(nrhs - 1, std::vector<double>(n, 0.0)), 1.5, control, stats), std::out_of_range);
+}
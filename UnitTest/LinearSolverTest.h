@@ -0,0 +1,42 @@
+/*
+ * Name  : LinearSolverTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class LinearSolverTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(LinearSolverTest);
+    CPPUNIT_TEST(testDefaultControl);
+    CPPUNIT_TEST(testRelativeTolerance);
+    CPPUNIT_TEST(testAbsoluteTolerance);
+    CPPUNIT_TEST(testMaxIterations);
+    CPPUNIT_TEST(testStagnation);
+    CPPUNIT_TEST(testMonitor);
+    CPPUNIT_TEST(testDenseSOR);
+    CPPUNIT_TEST(testInitialGuess);
+    CPPUNIT_TEST(testMatrixOperations);
+    CPPUNIT_TEST(testBlockSOR);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testDefaultControl();
+    void testRelativeTolerance();
+    void testAbsoluteTolerance();
+    void testMaxIterations();
+    void testStagnation();
+    void testMonitor();
+    void testDenseSOR();
+    void testInitialGuess();
+    void testMatrixOperations();
+    void testBlockSOR();
+};
@@ -0,0 +1,220 @@
+#include "MeshBuilderBulkTest.h"
+
+#include "FiniteVolume2DLib/ASCIIMeshReader.h"
+#include "FiniteVolume2DLib/ParallelASCIIMeshReader.h"
+
+#include <boost/format.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+
+// Static class data members
+MeshBuilderMock              MeshBuilderBulkTest::single_builder_;
+MeshBuilderMock              MeshBuilderBulkTest::bulk_builder_;
+MeshBuilderBulkTest::MeshPtr MeshBuilderBulkTest::single_mesh_;
+MeshBuilderBulkTest::MeshPtr MeshBuilderBulkTest::bulk_mesh_;
+
+
+namespace {
+    // mesh ids of a collection in insertion order
+    template<typename Entity>
+    std::vector<IGeometricEntity::Id_t> meshIds(boost::optional<EntityCollection<Entity>> const & collection) {
+        std::vector<IGeometricEntity::Id_t> ids;
+        if (collection) {
+            std::for_each(collection->begin(), collection->end(), [&ids](typename Entity::Ptr const & e) {
+                ids.push_back(e->meshId());
+            });
+        }
+        return ids;
+    }
+
+    template<typename Entity>
+    std::vector<IGeometricEntity::Id_t> meshIds(Thread<Entity> const & thread) {
+        std::vector<IGeometricEntity::Id_t> ids;
+        std::for_each(thread.begin(), thread.end(), [&ids](typename Entity::Ptr const & e) {
+            ids.push_back(e->meshId());
+        });
+        return ids;
+    }
+
+    template<typename Entity>
+    typename Entity::Ptr findByMeshId(Thread<Entity> const & thread, IGeometricEntity::Id_t mesh_id) {
+        typename Thread<Entity>::iterator it = std::find_if(thread.begin(), thread.end(), [mesh_id](typename Entity::Ptr const & e) {
+            return e->meshId() == mesh_id;
+        });
+        CPPUNIT_ASSERT_MESSAGE("Entity not found", it != thread.end());
+        return *it;
+    }
+
+}
+
+void
+MeshBuilderBulkTest::setUp() {
+    mesh_filename_ = "Data\\Versteeg_Malalasekera_11_25.mesh";
+
+    initMesh();
+}
+
+void
+MeshBuilderBulkTest::tearDown() {
+}
+
+void
+MeshBuilderBulkTest::testThreads() {
+    IGeometricEntity::Entity_t types[] = { IGeometricEntity::BOUNDARY, IGeometricEntity::INTERIOR };
+
+    for (int i = 0; i < 2; ++i) {
+        CPPUNIT_ASSERT_MESSAGE("Node thread mismatch", meshIds(single_mesh_->getNodeThread(types[i])) == meshIds(bulk_mesh_->getNodeThread(types[i])));
+        CPPUNIT_ASSERT_MESSAGE("Face thread mismatch", meshIds(single_mesh_->getFaceThread(types[i])) == meshIds(bulk_mesh_->getFaceThread(types[i])));
+    }
+    CPPUNIT_ASSERT_MESSAGE("Cell thread mismatch", meshIds(single_mesh_->getCellThread()) == meshIds(bulk_mesh_->getCellThread()));
+    CPPUNIT_ASSERT_MESSAGE("Empty mesh", single_mesh_->getCellThread().size() > 0);
+}
+
+void
+MeshBuilderBulkTest::testNodeConnectivity() {
+    IMeshConnectivity const & single = single_mesh_->getMeshConnectivity();
+    IMeshConnectivity const & bulk = bulk_mesh_->getMeshConnectivity();
+
+    IGeometricEntity::Entity_t types[] = { IGeometricEntity::BOUNDARY, IGeometricEntity::INTERIOR };
+
+    for (int i = 0; i < 2; ++i) {
+        Thread<Node> const & nodes = single_mesh_->getNodeThread(types[i]);
+
+        std::for_each(nodes.begin(), nodes.end(), [&](Node::Ptr const & node) {
+            Node::Ptr other = findByMeshId(bulk_mesh_->getNodeThread(types[i]), node->meshId());
+            std::string msg = (boost::format("node %1%") % node->meshId()).str();
+
+            CPPUNIT_ASSERT_MESSAGE(msg + ": neighbor mismatch", meshIds(single.getNodeNeighbors(node)) == meshIds(bulk.getNodeNeighbors(other)));
+            CPPUNIT_ASSERT_MESSAGE(msg + ": face mismatch", meshIds(single.getFacesAttachedToNode(node)) == meshIds(bulk.getFacesAttachedToNode(other)));
+            CPPUNIT_ASSERT_MESSAGE(msg + ": cell mismatch", meshIds(single.getCellsAttachedToNode(node)) == meshIds(bulk.getCellsAttachedToNode(other)));
+        });
+    }
+}
+
+void
+MeshBuilderBulkTest::testFaceConnectivity() {
+    IMeshConnectivity const & single = single_mesh_->getMeshConnectivity();
+    IMeshConnectivity const & bulk = bulk_mesh_->getMeshConnectivity();
+
+    IGeometricEntity::Entity_t types[] = { IGeometricEntity::BOUNDARY, IGeometricEntity::INTERIOR };
+
+    for (int i = 0; i < 2; ++i) {
+        Thread<Face> const & faces = single_mesh_->getFaceThread(types[i]);
+
+        std::for_each(faces.begin(), faces.end(), [&](Face::Ptr const & face) {
+            Face::Ptr other = findByMeshId(bulk_mesh_->getFaceThread(types[i]), face->meshId());
+            std::string msg = (boost::format("face %1%") % face->meshId()).str();
+
+            CPPUNIT_ASSERT_MESSAGE(msg + ": cell mismatch", meshIds(single.getCellsAttachedToFace(face)) == meshIds(bulk.getCellsAttachedToFace(other)));
+        });
+    }
+}
+
+void
+MeshBuilderBulkTest::testCellGeometry() {
+    Thread<Cell> const & cells = single_mesh_->getCellThread();
+
+    std::for_each(cells.begin(), cells.end(), [&](Cell::Ptr const & cell) {
+        Cell::Ptr other = findByMeshId(bulk_mesh_->getCellThread(), cell->meshId());
+
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Cell volume mismatch", cell->volume(), other->volume(), 1E-15);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Cell centroid mismatch", cell->centroid().x(), other->centroid().x(), 1E-15);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Cell centroid mismatch", cell->centroid().y(), other->centroid().y(), 1E-15);
+    });
+}
+
+void
+MeshBuilderBulkTest::testDuplicateId() {
+    MeshBuilderMock builder;
+
+    std::vector<IGeometricEntity::Id_t> ids;
+    ids.push_back(0);
+    ids.push_back(1);
+    ids.push_back(0);
+
+    std::vector<IGeometricEntity::Entity_t> types(3, IGeometricEntity::BOUNDARY);
+    std::vector<double> x(3, 0.0);
+    std::vector<double> y(3, 0.0);
+
+    CPPUNIT_ASSERT_MESSAGE("Duplicate vertex id not detected", !builder.buildNodes(ids, types, x, y));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Vertices created despite duplicate id", 0ull, Mesh::CPtr(*builder.getMesh())->getNodeThread(IGeometricEntity::BOUNDARY).size());
+
+    // the ids of the failed call can be used again
+    ids.pop_back();
+    types.pop_back();
+    x.pop_back();
+    y.pop_back();
+    CPPUNIT_ASSERT_MESSAGE("Failed to build vertices", builder.buildNodes(ids, types, x, y));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of vertices", 2ull, Mesh::CPtr(*builder.getMesh())->getNodeThread(IGeometricEntity::BOUNDARY).size());
+}
+
+void
+MeshBuilderBulkTest::testUnknownReference() {
+    MeshBuilderMock builder;
+
+    std::vector<IGeometricEntity::Id_t> ids(2);
+    ids[0] = 0;
+    ids[1] = 1;
+    std::vector<IGeometricEntity::Entity_t> types(2, IGeometricEntity::BOUNDARY);
+    std::vector<double> coords(2, 0.0);
+    CPPUNIT_ASSERT_MESSAGE("Failed to build vertices", builder.buildNodes(ids, types, coords, coords));
+
+    std::vector<IGeometricEntity::Id_t> face_ids(1, 0);
+    std::vector<IGeometricEntity::Entity_t> face_types(1, IGeometricEntity::BOUNDARY);
+    std::vector<IGeometricEntity::Id_t> node_ids;
+    node_ids.push_back(0);
+    node_ids.push_back(7);
+
+    CPPUNIT_ASSERT_MESSAGE("Unknown vertex not detected", !builder.buildFaces(face_ids, face_types, node_ids));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Face created despite unknown vertex", 0ull, Mesh::CPtr(*builder.getMesh())->getFaceThread(IGeometricEntity::BOUNDARY).size());
+}
+
+void
+MeshBuilderBulkTest::testTooManyCells() {
+    MeshBuilderMock builder;
+
+    // triangle with one boundary face shared by two cells
+    std::vector<IGeometricEntity::Id_t> ids;
+    for (IGeometricEntity::Id_t i = 0; i < 3; ++i)
+        ids.push_back(i);
+
+    std::vector<IGeometricEntity::Entity_t> types(3, IGeometricEntity::BOUNDARY);
+    double xs[] = { 0.0, 1.0, 0.0 };
+    double ys[] = { 0.0, 0.0, 1.0 };
+    CPPUNIT_ASSERT(builder.buildNodes(ids, types, std::vector<double>(xs, xs + 3), std::vector<double>(ys, ys + 3)));
+
+    IGeometricEntity::Id_t fn[] = { 0, 1, 1, 2, 2, 0 };
+    CPPUNIT_ASSERT(builder.buildFaces(ids, types, std::vector<IGeometricEntity::Id_t>(fn, fn + 6)));
+
+    std::vector<IGeometricEntity::Id_t> cell_ids;
+    cell_ids.push_back(0);
+    cell_ids.push_back(1);
+
+    std::size_t off[] = { 0, 3, 6 };
+    IGeometricEntity::Id_t cf[] = { 0, 1, 2, 0, 1, 2 };
+
+    CPPUNIT_ASSERT_THROW_MESSAGE("Boundary face with two cells not detected",
+        builder.buildCells(cell_ids, std::vector<std::size_t>(off, off + 3), std::vector<IGeometricEntity::Id_t>(cf, cf + 6)),
+        std::logic_error);
+}
+
+void
+MeshBuilderBulkTest::initMesh() {
+    static bool init = false;
+    if (!init)
+    {
+        init = true;
+
+        ASCIIMeshReader reader(mesh_filename_, single_builder_);
+        CPPUNIT_ASSERT_MESSAGE("Failed to read mesh file!", reader.read());
+
+        // uses the bulk interface
+        ParallelASCIIMeshReader bulk_reader(mesh_filename_, bulk_builder_, 2);
+        CPPUNIT_ASSERT_MESSAGE("Failed to read mesh file!", bulk_reader.read());
+
+        single_mesh_ = *single_builder_.getMesh();
+        bulk_mesh_ = *bulk_builder_.getMesh();
+    }
+}
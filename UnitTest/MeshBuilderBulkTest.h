@@ -0,0 +1,53 @@
+/*
+ * Name  : MeshBuilderBulkTest
+ * Path  : 
+ * Use   : Checks that the bulk interface of the mesh builder
+ *         yields the same mesh and connectivity as building
+ *         one entity at a time.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "internal/MeshBuilderMock.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class MeshBuilderBulkTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(MeshBuilderBulkTest);
+    CPPUNIT_TEST(testThreads);
+    CPPUNIT_TEST(testNodeConnectivity);
+    CPPUNIT_TEST(testFaceConnectivity);
+    CPPUNIT_TEST(testCellGeometry);
+    CPPUNIT_TEST(testDuplicateId);
+    CPPUNIT_TEST(testUnknownReference);
+    CPPUNIT_TEST(testTooManyCells);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testThreads();
+    void testNodeConnectivity();
+    void testFaceConnectivity();
+    void testCellGeometry();
+    void testDuplicateId();
+    void testUnknownReference();
+    void testTooManyCells();
+
+private:
+    void initMesh();
+
+private:
+    typedef Mesh::CPtr MeshPtr;
+
+private:
+    std::string            mesh_filename_;
+    static MeshBuilderMock single_builder_;
+    static MeshBuilderMock bulk_builder_;
+    static MeshPtr         single_mesh_;
+    static MeshPtr         bulk_mesh_;
+};
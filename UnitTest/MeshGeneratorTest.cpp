@@ -0,0 +1,173 @@
+#include "MeshGeneratorTest.h"
+
+#include "internal/MeshBuilderMock.h"
+
+#include "FiniteVolume2DLib/MeshGenerator.h"
+#include "FiniteVolume2DLib/MeshChecker.h"
+#include "FiniteVolume2DLib/ASCIIMeshReader.h"
+
+#include <algorithm>
+#include <cstdio>
+
+
+namespace {
+    double totalVolume(Mesh::CPtr const & mesh, double & min_volume) {
+        Thread<Cell> const & cells = mesh->getCellThread();
+
+        double volume = 0.0;
+        min_volume = std::numeric_limits<double>::max();
+        std::for_each(cells.begin(), cells.end(), [&](Cell::Ptr const & cell) {
+            volume += cell->volume();
+            min_volume = std::min(min_volume, cell->volume());
+        });
+        return volume;
+    }
+
+}
+
+void
+MeshGeneratorTest::setUp() {
+}
+
+void
+MeshGeneratorTest::tearDown() {
+}
+
+void
+MeshGeneratorTest::testNumberOfEntities() {
+    MeshGenerator generator(0.0, 0.0, 2.0, 1.0, 4, 3);
+
+    MeshBuilderMock builder;
+    BoundaryConditionCollection bc;
+    CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generator.generate(builder, bc));
+
+    Mesh::CPtr mesh = *builder.getMesh();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of boundary vertices", 14ull, mesh->getNodeThread(IGeometricEntity::BOUNDARY).size());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of interior vertices", 6ull, mesh->getNodeThread(IGeometricEntity::INTERIOR).size());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of boundary faces", 14ull, mesh->getFaceThread(IGeometricEntity::BOUNDARY).size());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of interior faces", 29ull, mesh->getFaceThread(IGeometricEntity::INTERIOR).size());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of cells", 24ull, mesh->getCellThread().size());
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of cells", std::size_t(24), generator.getNumberOfCells());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of faces", std::size_t(43), generator.getNumberOfFaces());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of vertices", std::size_t(20), generator.getNumberOfNodes());
+}
+
+void
+MeshGeneratorTest::testMeshCheck() {
+    MeshGenerator generator(-1.0, -1.0, 1.0, 1.0, 5, 7);
+    generator.setRandomDiagonals(true, 3);
+    generator.setPerturbation(0.1, 5);
+
+    MeshBuilderMock builder;
+    BoundaryConditionCollection bc;
+    CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generator.generate(builder, bc));
+    CPPUNIT_ASSERT_MESSAGE("Mesh check failed", MeshChecker::checkMesh(*builder.getMesh(), bc));
+}
+
+void
+MeshGeneratorTest::testPositiveVolumes() {
+    bool const random_diagonals[] = { false, true };
+
+    for (int k = 0; k < 2; ++k) {
+        MeshGenerator generator(0.0, 0.0, 3.0, 1.5, 12, 9);
+        generator.setRandomDiagonals(random_diagonals[k], 7);
+
+        // larger than supported, gets limited
+        generator.setPerturbation(1.0, 11);
+
+        MeshBuilderMock builder;
+        BoundaryConditionCollection bc;
+        CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generator.generate(builder, bc));
+
+        double min_volume;
+        double volume = totalVolume(*builder.getMesh(), min_volume);
+
+        CPPUNIT_ASSERT_MESSAGE("Non-positive cell volume", min_volume > 0.0);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong total volume", 4.5, volume, 1E-12);
+    }
+}
+
+void
+MeshGeneratorTest::testBoundaryConditions() {
+    MeshGenerator generator(0.0, 0.0, 1.0, 1.0, 3, 2);
+    generator.setBoundaryCondition(MeshGenerator::LEFT, BoundaryConditionCollection::DIRICHLET, 100.0);
+    generator.setBoundaryCondition(MeshGenerator::RIGHT, BoundaryConditionCollection::DIRICHLET, 50.0);
+    generator.setBoundaryCondition(MeshGenerator::TOP, BoundaryConditionCollection::NEUMANN, 2.0);
+
+    MeshBuilderMock builder;
+    BoundaryConditionCollection bc;
+    CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generator.generate(builder, bc));
+
+    Mesh::CPtr mesh = *builder.getMesh();
+    Thread<Face> const & bfaces = mesh->getFaceThread(IGeometricEntity::BOUNDARY);
+
+    std::for_each(bfaces.begin(), bfaces.end(), [&bc](Face::Ptr const & face) {
+        auto item = bc.find(face->meshId());
+        CPPUNIT_ASSERT_MESSAGE("Missing boundary condition", item.is_initialized());
+
+        Vertex c = face->centroid();
+        BoundaryConditionCollection::Type expected_type = BoundaryConditionCollection::DIRICHLET;
+        double expected_value = 0.0;
+
+        if (c.x() < 1E-12)
+            expected_value = 100.0;
+        else if (c.x() > 1.0 - 1E-12)
+            expected_value = 50.0;
+        else if (c.y() > 1.0 - 1E-12) {
+            expected_type = BoundaryConditionCollection::NEUMANN;
+            expected_value = 2.0;
+        }
+
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong boundary condition type", expected_type, std::get<0>(*item));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong boundary condition value", expected_value, std::get<1>(*item), 1E-15);
+    });
+}
+
+void
+MeshGeneratorTest::testWriteAndRead() {
+    std::string filename = "generated_mesh.mesh";
+
+    MeshGenerator generator(0.0, 0.0, 1.0, 2.0, 6, 5);
+    generator.setRandomDiagonals(true);
+    generator.setPerturbation(0.1);
+    generator.setBoundaryCondition(MeshGenerator::BOTTOM, BoundaryConditionCollection::NEUMANN, -1.5);
+    CPPUNIT_ASSERT_MESSAGE("Failed to write mesh file", generator.write(filename));
+
+    MeshBuilderMock read_builder;
+    ASCIIMeshReader reader(filename, read_builder);
+    bool read = reader.read();
+    std::remove(filename.c_str());
+    CPPUNIT_ASSERT_MESSAGE("Failed to read generated mesh file", read);
+
+    MeshBuilderMock builder;
+    BoundaryConditionCollection bc;
+    CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generator.generate(builder, bc));
+
+    Mesh::CPtr read_mesh = *read_builder.getMesh();
+    Mesh::CPtr mesh = *builder.getMesh();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of cells", mesh->getCellThread().size(), read_mesh->getCellThread().size());
+    CPPUNIT_ASSERT_MESSAGE("Mesh check failed", MeshChecker::checkMesh(read_mesh, reader.getBoundaryConditions()));
+
+    for (Thread<Cell>::size_type i = 0; i < mesh->getCellThread().size(); ++i) {
+        Cell::Ptr expected = mesh->getCellThread().getEntityAt(i);
+        Cell::Ptr actual = read_mesh->getCellThread().getEntityAt(i);
+
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Cell mesh id mismatch", expected->meshId(), actual->meshId());
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Cell volume mismatch", expected->volume(), actual->volume(), 1E-14);
+    }
+
+    auto item = reader.getBoundaryConditions().find(0);
+    CPPUNIT_ASSERT_MESSAGE("Missing boundary condition", item.is_initialized());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong boundary condition type", BoundaryConditionCollection::NEUMANN, std::get<0>(*item));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong boundary condition value", -1.5, std::get<1>(*item), 1E-15);
+}
+
+void
+MeshGeneratorTest::testInvalidRectangle() {
+    MeshGenerator generator(1.0, 0.0, 0.0, 1.0, 2, 2);
+
+    MeshGenerator::MeshData data;
+    CPPUNIT_ASSERT_MESSAGE("Invalid rectangle not detected", !generator.generate(data));
+}
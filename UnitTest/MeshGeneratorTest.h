@@ -0,0 +1,34 @@
+/*
+ * Name  : MeshGeneratorTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class MeshGeneratorTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(MeshGeneratorTest);
+    CPPUNIT_TEST(testNumberOfEntities);
+    CPPUNIT_TEST(testMeshCheck);
+    CPPUNIT_TEST(testPositiveVolumes);
+    CPPUNIT_TEST(testBoundaryConditions);
+    CPPUNIT_TEST(testWriteAndRead);
+    CPPUNIT_TEST(testInvalidRectangle);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testNumberOfEntities();
+    void testMeshCheck();
+    void testPositiveVolumes();
+    void testBoundaryConditions();
+    void testWriteAndRead();
+    void testInvalidRectangle();
+};
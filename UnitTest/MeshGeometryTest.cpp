@@ -0,0 +1,241 @@
+#include "MeshGeometryTest.h"
+
+#include "TestMeshFactory.h"
+
+#include "FiniteVolume2DLib/MeshGeometry.h"
+#include "FiniteVolume2DLib/InstructionSet.h"
+#include "FiniteVolume2DLib/Mesh.h"
+
+#include <map>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+
+
+namespace {
+    // perturbed, i.e. faces of different length and orientation
+    struct PerturbedMesh : TestMeshFactory {
+        PerturbedMesh() : TestMeshFactory(-1.0, 0.0, 2.0, 1.5, 7, 5) {
+            setDistortion(0.2, 11);
+        }
+    };
+
+    /* faceKernel() and triangleKernel() with the instruction set type
+     * for n faces and triangles: area, nx, ny, cx, cy, volume, cx, cy
+     */
+    std::vector<double>
+    runKernels(InstructionSet::Type type, std::size_t n) {
+        std::vector<double> x(3 * n), y(3 * n);
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            x[i] = std::sin(1.7 * double(i));
+            y[i] = std::cos(0.3 * double(i * i));
+        }
+
+        std::vector<double> out(8 * n);
+
+        InstructionSet::Type previous = InstructionSet::active();
+        InstructionSet::select(type);
+
+        MeshGeometry::faceKernel(n, &x[0], &y[0], &x[n], &y[n], &out[0], &out[n], &out[2 * n], &out[3 * n], &out[4 * n]);
+        MeshGeometry::triangleKernel(n, &x[0], &y[0], &x[n], &y[n], &x[2 * n], &y[2 * n], &out[5 * n], &out[6 * n], &out[7 * n]);
+
+        InstructionSet::select(previous);
+
+        return out;
+    }
+
+    void
+    checkFaces(Thread<Face> const & faces, MeshGeometry const & geometry, std::size_t offset) {
+        for (Thread<Face>::size_type i = 0; i < faces.size(); ++i) {
+            Face::Ptr const & face = faces.getEntityAt(i);
+
+            std::size_t index = offset + i;
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong area", face->area(), geometry.faceArea()[index], 1E-14);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong normal", face->normal().x(), geometry.faceNormalX()[index], 1E-14);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong normal", face->normal().y(), geometry.faceNormalY()[index], 1E-14);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong centroid", face->centroid().x(), geometry.faceCentroidX()[index], 1E-14);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong centroid", face->centroid().y(), geometry.faceCentroidY()[index], 1E-14);
+        }
+    }
+
+}
+
+void
+MeshGeometryTest::setUp() {
+}
+
+void
+MeshGeometryTest::tearDown() {
+}
+
+void
+MeshGeometryTest::testFaces() {
+    PerturbedMesh factory;
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+
+    Thread<Face> const & interior_faces = mesh->getFaceThread(IGeometricEntity::INTERIOR);
+    Thread<Face> const & boundary_faces = mesh->getFaceThread(IGeometricEntity::BOUNDARY);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of faces", std::size_t(interior_faces.size() + boundary_faces.size()), geometry.getNumberOfFaces());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of nodes",
+        std::size_t(mesh->getNodeThread(IGeometricEntity::INTERIOR).size() + mesh->getNodeThread(IGeometricEntity::BOUNDARY).size()), geometry.getNumberOfNodes());
+
+    // interior faces first
+    checkFaces(interior_faces, geometry, 0);
+    checkFaces(boundary_faces, geometry, interior_faces.size());
+}
+
+void
+MeshGeometryTest::testCells() {
+    PerturbedMesh factory;
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+
+    Thread<Cell> const & cells = mesh->getCellThread();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of cells", std::size_t(cells.size()), geometry.getNumberOfCells());
+
+    double total = 0.0;
+
+    for (Thread<Cell>::size_type i = 0; i < cells.size(); ++i) {
+        Cell::Ptr const & cell = cells.getEntityAt(i);
+
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong volume", cell->volume(), geometry.cellVolume()[i], 1E-14);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong centroid", cell->centroid().x(), geometry.cellCentroidX()[i], 1E-14);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong centroid", cell->centroid().y(), geometry.cellCentroidY()[i], 1E-14);
+
+        total += std::fabs(geometry.cellVolume()[i]);
+    }
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong total volume", 3.0 * 1.5, total, 1E-12);
+}
+
+void
+MeshGeometryTest::testFaceCells() {
+    PerturbedMesh factory;
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+
+    Thread<Cell> const & cells = mesh->getCellThread();
+
+    std::map<IGeometricEntity::Id_t, boost::uint64_t> cell_index;
+    for (Thread<Cell>::size_type i = 0; i < cells.size(); ++i)
+        cell_index[cells.getEntityAt(i)->id()] = i;
+
+    IMeshConnectivity const & connectivity = mesh->getMeshConnectivity();
+    MeshGeometry::Index_t const & face_cells = geometry.faceCells();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of face cells", 2 * geometry.getNumberOfFaces(), face_cells.size());
+
+    IGeometricEntity::Entity_t face_types[] = {IGeometricEntity::INTERIOR, IGeometricEntity::BOUNDARY};
+    std::size_t index = 0;
+
+    for (int t = 0; t < 2; ++t) {
+        Thread<Face> const & faces = mesh->getFaceThread(face_types[t]);
+
+        for (Thread<Face>::size_type i = 0; i < faces.size(); ++i, ++index) {
+            boost::optional<EntityCollection<Cell>> cell_nbrs = connectivity.getCellsAttachedToFace(faces.getEntityAt(i));
+            CPPUNIT_ASSERT_MESSAGE("Face without cells", bool(cell_nbrs));
+
+            boost::uint64_t c1 = face_cells[2 * index];
+            boost::uint64_t c2 = face_cells[2 * index + 1];
+
+            if (face_types[t] == IGeometricEntity::BOUNDARY) {
+                CPPUNIT_ASSERT_EQUAL_MESSAGE("Boundary face with two cells", MeshGeometry::NO_CELL, c2);
+                CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong cell", cell_index[cell_nbrs->getEntity(0)->id()], c1);
+                continue;
+            }
+
+            CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of cells", EntityCollection<Cell>::size_type(2), cell_nbrs->size());
+
+            boost::uint64_t n1 = cell_index[cell_nbrs->getEntity(0)->id()];
+            boost::uint64_t n2 = cell_index[cell_nbrs->getEntity(1)->id()];
+
+            CPPUNIT_ASSERT_MESSAGE("Wrong cells", (c1 == n1 && c2 == n2) || (c1 == n2 && c2 == n1));
+        }
+    }
+}
+
+void
+MeshGeometryTest::testKernels() {
+    // not a multiple of the vector width
+    std::size_t const n = 7;
+
+    std::vector<double> x0(n), y0(n), x1(n), y1(n), x2(n), y2(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        x0[i] = double(i);
+        y0[i] = 0.0;
+        x1[i] = double(i) + 3.0;
+        y1[i] = 4.0;
+        x2[i] = double(i);
+        y2[i] = 4.0;
+    }
+
+    std::vector<double> area(n), nx(n), ny(n), cx(n), cy(n);
+    MeshGeometry::faceKernel(n, &x0[0], &y0[0], &x1[0], &y1[0], &area[0], &nx[0], &ny[0], &cx[0], &cy[0]);
+
+    std::vector<double> volume(n), tcx(n), tcy(n);
+    MeshGeometry::triangleKernel(n, &x0[0], &y0[0], &x1[0], &y1[0], &x2[0], &y2[0], &volume[0], &tcx[0], &tcy[0]);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong area", 5.0, area[i], 1E-15);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong normal", 4.0, nx[i], 1E-15);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong normal", -3.0, ny[i], 1E-15);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong centroid", double(i) + 1.5, cx[i], 1E-15);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong centroid", 2.0, cy[i], 1E-15);
+
+        // counter-clockwise, i.e. positive
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong volume", 6.0, volume[i], 1E-14);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong centroid", double(i) + 1.0, tcx[i], 1E-14);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong centroid", 8.0 / 3.0, tcy[i], 1E-14);
+    }
+
+    std::string instruction_set = MeshGeometry::instructionSet();
+    CPPUNIT_ASSERT_MESSAGE("Unknown instruction set", instruction_set == "AVX2" || instruction_set == "scalar");
+}
+
+void
+MeshGeometryTest::testVectorKernels() {
+    // not a multiple of the vector width
+    std::size_t const n = 37;
+
+    // the vector path if the processor supports it
+    std::vector<double> scalar = runKernels(InstructionSet::SCALAR, n);
+    std::vector<double> vector = runKernels(InstructionSet::AVX2, n);
+
+    for (std::size_t i = 0; i < scalar.size(); ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Vector and scalar kernels differ", scalar[i], vector[i], 1E-14);
+}
+
+void
+MeshGeometryTest::testUpdate() {
+    PerturbedMesh factory;
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+    MeshGeometry::Array_t area   = geometry.faceArea();
+    MeshGeometry::Array_t volume = geometry.cellVolume();
+
+    // scale by 2
+    MeshGeometry::Array_t x = geometry.nodeX();
+    MeshGeometry::Array_t y = geometry.nodeY();
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        x[i] *= 2.0;
+        y[i] *= 2.0;
+    }
+
+    geometry.setNodeCoordinates(x, y);
+    geometry.update();
+
+    for (std::size_t i = 0; i < area.size(); ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong area", 2.0 * area[i], geometry.faceArea()[i], 1E-13);
+
+    for (std::size_t i = 0; i < volume.size(); ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong volume", 4.0 * volume[i], geometry.cellVolume()[i], 1E-13);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE("Wrong number of nodes not detected", geometry.setNodeCoordinates(MeshGeometry::Array_t(1), y), std::out_of_range);
+}
@@ -0,0 +1,34 @@
+/*
+ * Name  : MeshGeometryTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class MeshGeometryTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(MeshGeometryTest);
+    CPPUNIT_TEST(testFaces);
+    CPPUNIT_TEST(testCells);
+    CPPUNIT_TEST(testFaceCells);
+    CPPUNIT_TEST(testKernels);
+    CPPUNIT_TEST(testVectorKernels);
+    CPPUNIT_TEST(testUpdate);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testFaces();
+    void testCells();
+    void testFaceCells();
+    void testKernels();
+    void testVectorKernels();
+    void testUpdate();
+};
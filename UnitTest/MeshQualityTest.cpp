@@ -0,0 +1,169 @@
+#include "MeshQualityTest.h"
+
+#include "TestMeshFactory.h"
+
+#include "FiniteVolume2DLib/MeshQuality.h"
+#include "FiniteVolume2DLib/MeshGeometry.h"
+#include "FiniteVolume2DLib/GeometricHelper.h"
+#include "FiniteVolume2DLib/LineSegment.h"
+#include "FiniteVolume2DLib/Line.h"
+#include "FiniteVolume2DLib/Math.h"
+#include "FiniteVolume2DLib/Mesh.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+void
+MeshQualityTest::setUp() {
+}
+
+void
+MeshQualityTest::tearDown() {
+}
+
+void
+MeshQualityTest::testUniformMesh() {
+    TestMeshFactory factory(4);
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+    MeshQuality quality(geometry, 1);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of faces", geometry.getNumberOfFaces(), quality.skewness().size());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of cells", geometry.getNumberOfCells(), quality.aspectRatio().size());
+
+    // right isosceles triangles of equal size
+    for (std::size_t i = 0; i < geometry.getNumberOfCells(); ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong aspect ratio", std::sqrt(2.0), quality.aspectRatio()[i], 1E-12);
+
+    for (std::size_t i = 0; i < geometry.getNumberOfFaces(); ++i) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong volume ratio", 1.0, quality.volumeRatio()[i], 1E-12);
+        CPPUNIT_ASSERT_MESSAGE("Wrong skewness", quality.skewness()[i] >= 0.0 && quality.skewness()[i] < 1.0);
+        CPPUNIT_ASSERT_MESSAGE("Wrong non-orthogonality", quality.nonOrthogonality()[i] >= 0.0 && quality.nonOrthogonality()[i] < std::acos(0.0));
+    }
+}
+
+void
+MeshQualityTest::testDistortedMesh() {
+    // compare to the metrics computed one face at a time, cf. VersteegMalalasekeraMeshDistortedTest
+    TestMeshFactory factory(6);
+    factory.setDistortion(0.25, 5);
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+    MeshQuality quality(geometry, 1);
+
+    MeshGeometry::Index_t const & face_cells = geometry.faceCells();
+    Thread<Cell> const & cells = mesh->getCellThread();
+
+    IGeometricEntity::Entity_t face_types[] = {IGeometricEntity::INTERIOR, IGeometricEntity::BOUNDARY};
+    std::size_t index = 0;
+
+    for (int t = 0; t < 2; ++t) {
+        Thread<Face> const & faces = mesh->getFaceThread(face_types[t]);
+
+        for (Thread<Face>::size_type i = 0; i < faces.size(); ++i, ++index) {
+            Face::Ptr const & face = faces.getEntityAt(i);
+            Cell::Ptr const & c1 = cells.getEntityAt(face_cells[2 * index]);
+
+            Vertex p0 = face->getNodes().getEntity(0)->location();
+            Vertex p1 = face->getNodes().getEntity(1)->location();
+            Vertex midpoint = (p0 + p1) / 2.0;
+
+            Vertex other = face_types[t] == IGeometricEntity::BOUNDARY ? face->centroid() : cells.getEntityAt(face_cells[2 * index + 1])->centroid();
+            Vector d = other - c1->centroid();
+
+            double cos_angle = std::fabs(Math::dot(face->normal(), d)) / (face->area() * d.norm());
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong non-orthogonality", std::acos(std::min(cos_angle, 1.0)), quality.nonOrthogonality()[index], 1E-10);
+
+            if (face_types[t] == IGeometricEntity::BOUNDARY) {
+                CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong skewness", 0.0, quality.skewness()[index]);
+                CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong volume ratio", 1.0, quality.volumeRatio()[index]);
+                continue;
+            }
+
+            Cell::Ptr const & c2 = cells.getEntityAt(face_cells[2 * index + 1]);
+
+            boost::optional<Vertex> ip_opt = GeometricHelper::intersect(LineSegment(p0, p1), Line(c1->centroid(), c2->centroid()));
+            CPPUNIT_ASSERT_MESSAGE("Intersection expected", bool(ip_opt));
+
+            double skewness = Math::dist(midpoint, *ip_opt) / Math::dist(p0, midpoint);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong skewness", skewness, quality.skewness()[index], 1E-10);
+
+            double v1 = std::fabs(c1->volume());
+            double v2 = std::fabs(c2->volume());
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong volume ratio", std::max(v1, v2) / std::min(v1, v2), quality.volumeRatio()[index], 1E-10);
+        }
+    }
+
+    for (Thread<Cell>::size_type i = 0; i < cells.size(); ++i) {
+        EntityCollection<Face> const & faces = cells.getEntityAt(i)->getFaces();
+
+        double min_area = std::numeric_limits<double>::max();
+        double max_area = 0.0;
+        for (EntityCollection<Face>::size_type j = 0; j < faces.size(); ++j) {
+            min_area = std::min(min_area, faces.getEntity(j)->area());
+            max_area = std::max(max_area, faces.getEntity(j)->area());
+        }
+
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong aspect ratio", max_area / min_area, quality.aspectRatio()[i], 1E-10);
+    }
+}
+
+void
+MeshQualityTest::testThreads() {
+    TestMeshFactory factory(TestMeshFactory::THREADED_SIZE);
+    factory.setDistortion(0.3, 5);
+    Mesh::CPtr mesh = factory.getMesh();
+
+    MeshGeometry geometry(*mesh);
+    MeshQuality serial(geometry, 1);
+    MeshQuality parallel(geometry, 4);
+
+    CPPUNIT_ASSERT_MESSAGE("Different non-orthogonality", serial.nonOrthogonality() == parallel.nonOrthogonality());
+    CPPUNIT_ASSERT_MESSAGE("Different skewness", serial.skewness() == parallel.skewness());
+    CPPUNIT_ASSERT_MESSAGE("Different volume ratio", serial.volumeRatio() == parallel.volumeRatio());
+    CPPUNIT_ASSERT_MESSAGE("Different aspect ratio", serial.aspectRatio() == parallel.aspectRatio());
+
+    // the metrics follow the geometry
+    MeshGeometry::Array_t x = geometry.nodeX();
+    MeshGeometry::Array_t y = geometry.nodeY();
+    for (std::size_t i = 0; i < x.size(); ++i)
+        x[i] *= 2.0;
+
+    MeshGeometry stretched(*mesh);
+    stretched.setNodeCoordinates(x, y);
+    stretched.update();
+
+    MeshQuality quality(stretched, 4);
+    CPPUNIT_ASSERT_MESSAGE("Aspect ratio not updated", quality.aspectRatio() != serial.aspectRatio());
+}
+
+void
+MeshQualityTest::testHistogram() {
+    MeshQuality::Array_t values;
+    values.push_back(1.0);
+    values.push_back(2.0);
+    values.push_back(2.5);
+    values.push_back(5.0);
+    values.push_back(std::numeric_limits<double>::infinity());
+
+    MeshQuality::Histogram histogram = MeshQuality::histogram(values, 4);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of bins", std::size_t(4), histogram.counts.size());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of infinite values", std::size_t(1), histogram.nonfinite);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong minimum", 1.0, histogram.min, 1E-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong maximum", 5.0, histogram.max, 1E-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong mean", 2.625, histogram.mean, 1E-15);
+
+    // bins [1, 2), [2, 3), [3, 4), [4, 5]
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong count", std::size_t(1), histogram.counts[0]);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong count", std::size_t(2), histogram.counts[1]);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong count", std::size_t(0), histogram.counts[2]);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong count", std::size_t(1), histogram.counts[3]);
+
+    histogram = MeshQuality::histogram(MeshQuality::Array_t(), 4);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong count", std::size_t(0), histogram.counts[0]);
+}
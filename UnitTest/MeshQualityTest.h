@@ -0,0 +1,30 @@
+/*
+ * Name  : MeshQualityTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class MeshQualityTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(MeshQualityTest);
+    CPPUNIT_TEST(testUniformMesh);
+    CPPUNIT_TEST(testDistortedMesh);
+    CPPUNIT_TEST(testThreads);
+    CPPUNIT_TEST(testHistogram);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testUniformMesh();
+    void testDistortedMesh();
+    void testThreads();
+    void testHistogram();
+};
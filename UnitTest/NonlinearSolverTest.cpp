@@ -0,0 +1,218 @@
+#include "NonlinearSolverTest.h"
+
+#include "TestMeshFactory.h"
+
+#include "FiniteVolume2D/NonlinearSolver.h"
+#include "FiniteVolume2D/ComputationalMeshSolverHelper.h"
+#include "FiniteVolume2D/ComputationalMeshBuilder.h"
+#include "FiniteVolume2D/IComputationalGridAccessor.h"
+
+#include "FiniteVolume2DLib/Math.h"
+
+#include <vector>
+
+
+namespace {
+
+    double const T_left = 100.0;
+
+    // conductivity k(T) = 1 + beta T
+    ComputationalMeshBuilder::FluxEvaluator_t
+    conductionFluxEvaluator(double beta) {
+        return [beta](IComputationalGridAccessor const & cgrid, ComputationalCell::Ptr const & ccell, ComputationalFace::Ptr const & cface) -> bool {
+            FluxComputationalMolecule & flux_molecule = cface->getComputationalMolecule("Temperature");
+
+            if (!flux_molecule.empty())
+                return true;
+
+            flux_molecule.setCell(ccell);
+
+            double T_P = ccell->getComputationalMolecule("Temperature").getValue();
+            ComputationalVariable::Ptr const & cvar = ccell->getComputationalVariable("Temperature");
+
+            BoundaryCondition::Ptr const & bc = cface->getBoundaryCondition();
+
+            if (bc) {
+                SourceTerm & face_source = flux_molecule.getSourceTerm();
+
+                if (bc->type() == BoundaryConditionCollection::DIRICHLET) {
+                    Vertex midpoint = (cface->startNode().location() + cface->endNode().location()) / 2.0;
+                    double k = 1.0 + beta * 0.5 * (T_P + bc->getValue());
+                    double weight = k * cface->area() / Math::dist(ccell->centroid(), midpoint);
+
+                    face_source += weight * bc->getValue();
+                    flux_molecule.add(*cvar, weight);
+                }
+                else
+                    face_source += bc->getValue();
+
+                return true;
+            }
+
+            ComputationalCell::Ptr const & cell_nbr = cgrid.getOtherCell(cface, ccell);
+
+            double T_N = cell_nbr->getComputationalMolecule("Temperature").getValue();
+            double k = 1.0 + beta * 0.5 * (T_P + T_N);
+            double weight = k * cface->area() / Math::dist(ccell->centroid(), cell_nbr->centroid());
+
+            flux_molecule.add(*cvar,                                               weight);
+            flux_molecule.add(*cell_nbr->getComputationalVariable("Temperature"), -weight);
+
+            return true;
+        };
+    }
+
+    // conduction in the unit square, T = 100 on the left, T = 0 on the right
+    ComputationalMesh::CPtr
+    buildMesh(TestMeshFactory & factory, double beta) {
+        return factory.setChannel(T_left, 0.0).buildComputationalMesh("Temperature", conductionFluxEvaluator(beta));
+    }
+
+    std::vector<double>
+    temperature(IComputationalMesh const & cmesh) {
+        return TestMeshFactory::cellValues(cmesh, "Temperature");
+    }
+
+}
+
+void
+NonlinearSolverTest::setUp() {
+}
+
+void
+NonlinearSolverTest::tearDown() {
+}
+
+void
+NonlinearSolverTest::testLinearProblem() {
+    // constant conductivity: the first iteration solves the problem
+    TestMeshFactory factory(8);
+    ComputationalMesh::CPtr cmesh = buildMesh(factory, 0.0);
+
+    ComputationalMeshSolverHelper helper(*cmesh);
+    LinearSolver::Control linear_control;
+    linear_control.relative_tolerance = 1E-14;
+    helper.setSolverControl(linear_control);
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+    std::vector<double> T_linear = temperature(*cmesh);
+
+    TestMeshFactory factory_nl(8);
+    ComputationalMesh::CPtr cmesh_nl = buildMesh(factory_nl, 0.0);
+
+    NonlinearSolver solver(*cmesh_nl, TestMeshFactory::cellEvaluator("Temperature"));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong reason", NonlinearSolver::NOT_RUN, solver.getStatistics().reason);
+    CPPUNIT_ASSERT_MESSAGE("Nonlinear solve failed", solver.solve());
+
+    NonlinearSolver::Statistics const & stats = solver.getStatistics();
+    CPPUNIT_ASSERT_MESSAGE("Not converged", stats.converged());
+    CPPUNIT_ASSERT_MESSAGE("Too many iterations", stats.iterations <= 10);
+    CPPUNIT_ASSERT_MESSAGE("No linear iterations", stats.linear_iterations > 0);
+    CPPUNIT_ASSERT_MESSAGE("Residual not reduced", stats.residual_norm <= 1E-8 * stats.initial_residual);
+
+    CPPUNIT_ASSERT_MESSAGE("Wrong solution", TestMeshFactory::maxDifference(T_linear, temperature(*cmesh_nl)) < 1E-4);
+
+    // starting from a solution within the tolerance, no iteration is needed
+    NonlinearSolver::Control control;
+    control.absolute_tolerance = 2.0 * stats.residual_norm;
+    solver.setControl(control);
+
+    CPPUNIT_ASSERT_MESSAGE("Nonlinear solve failed", solver.solve());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong reason", NonlinearSolver::CONVERGED_ABSOLUTE, solver.getStatistics().reason);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Unexpected iterations", 0u, solver.getStatistics().iterations);
+}
+
+void
+NonlinearSolverTest::testVariableConductivity() {
+    double const beta = 0.01;
+
+    TestMeshFactory factory(8);
+    ComputationalMesh::CPtr cmesh = buildMesh(factory, beta);
+
+    NonlinearSolver solver(*cmesh, TestMeshFactory::cellEvaluator("Temperature"));
+
+    unsigned int ncalls = 0;
+    NonlinearSolver::Control control;
+    control.monitor = [&ncalls](unsigned int iteration, double, double) {
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong iteration", ncalls, iteration);
+        ++ncalls;
+        return true;
+    };
+    solver.setControl(control);
+
+    CPPUNIT_ASSERT_MESSAGE("Nonlinear solve failed", solver.solve());
+    CPPUNIT_ASSERT_MESSAGE("Linear convergence", solver.getStatistics().iterations > 1);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of monitor calls", solver.getStatistics().iterations, ncalls);
+
+    /* With the Kirchhoff transform u = T + beta T^2 / 2, the face flux
+     * k_f (T_P - T_N) becomes u_P - u_N, i.e. u solves the linear problem
+     * with u(T_left) on the left boundary.
+     */
+    TestMeshFactory factory_linear(8);
+    ComputationalMesh::CPtr cmesh_linear = buildMesh(factory_linear, 0.0);
+
+    ComputationalMeshSolverHelper helper(*cmesh_linear);
+    LinearSolver::Control linear_control;
+    linear_control.relative_tolerance = 1E-14;
+    helper.setSolverControl(linear_control);
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+
+    double const u_left = T_left + 0.5 * beta * T_left * T_left;
+
+    std::vector<double> T_linear = temperature(*cmesh_linear);
+    std::vector<double> T = temperature(*cmesh);
+
+    for (std::vector<double>::size_type i = 0; i < T.size(); ++i) {
+        double u = T[i] + 0.5 * beta * T[i] * T[i];
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong Kirchhoff variable", u_left / T_left * T_linear[i], u, 1E-4);
+    }
+}
+
+void
+NonlinearSolverTest::testEisenstatWalker() {
+    double const beta = 0.01;
+
+    TestMeshFactory factory_exact(8);
+    ComputationalMesh::CPtr cmesh_exact = buildMesh(factory_exact, beta);
+
+    // tight linear solves
+    NonlinearSolver exact(*cmesh_exact, TestMeshFactory::cellEvaluator("Temperature"));
+    NonlinearSolver::Control control;
+    control.eisenstat_walker = false;
+    control.eta_initial = 1E-10;
+    exact.setControl(control);
+    CPPUNIT_ASSERT_MESSAGE("Nonlinear solve failed", exact.solve());
+
+    TestMeshFactory factory(8);
+    ComputationalMesh::CPtr cmesh = buildMesh(factory, beta);
+
+    NonlinearSolver inexact(*cmesh, TestMeshFactory::cellEvaluator("Temperature"));
+    CPPUNIT_ASSERT_MESSAGE("Nonlinear solve failed", inexact.solve());
+
+    CPPUNIT_ASSERT_MESSAGE("Eisenstat-Walker did not reduce the linear work",
+        inexact.getStatistics().linear_iterations < exact.getStatistics().linear_iterations);
+    CPPUNIT_ASSERT_MESSAGE("Different solutions", TestMeshFactory::maxDifference(temperature(*cmesh_exact), temperature(*cmesh)) < 1E-4);
+}
+
+void
+NonlinearSolverTest::testMaxIterations() {
+    TestMeshFactory factory(8);
+    ComputationalMesh::CPtr cmesh = buildMesh(factory, 0.01);
+
+    NonlinearSolver solver(*cmesh, TestMeshFactory::cellEvaluator("Temperature"));
+    NonlinearSolver::Control control;
+    control.max_iterations = 2;
+    solver.setControl(control);
+
+    CPPUNIT_ASSERT_MESSAGE("Not converged expected", !solver.solve());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong reason", NonlinearSolver::MAX_ITERATIONS, solver.getStatistics().reason);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of iterations", 2u, solver.getStatistics().iterations);
+    CPPUNIT_ASSERT_MESSAGE("Residual not reduced", solver.getStatistics().residual_norm < solver.getStatistics().initial_residual);
+
+    // aborted by the monitor
+    control.monitor = [](unsigned int iteration, double, double) { return iteration < 1; };
+    control.max_iterations = 50;
+    solver.setControl(control);
+    CPPUNIT_ASSERT_MESSAGE("Not converged expected", !solver.solve());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong reason", NonlinearSolver::ABORTED, solver.getStatistics().reason);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of iterations", 1u, solver.getStatistics().iterations);
+}
@@ -0,0 +1,30 @@
+/*
+ * Name  : NonlinearSolverTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class NonlinearSolverTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(NonlinearSolverTest);
+    CPPUNIT_TEST(testLinearProblem);
+    CPPUNIT_TEST(testVariableConductivity);
+    CPPUNIT_TEST(testEisenstatWalker);
+    CPPUNIT_TEST(testMaxIterations);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testLinearProblem();
+    void testVariableConductivity();
+    void testEisenstatWalker();
+    void testMaxIterations();
+};
@@ -0,0 +1,139 @@
+#include "ParallelASCIIMeshReaderTest.h"
+
+#include "FiniteVolume2DLib/ASCIIMeshReader.h"
+#include "FiniteVolume2DLib/ParallelASCIIMeshReader.h"
+
+#include <boost/format.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+
+
+// Static class data members
+ParallelASCIIMeshReaderTest::RecordingMeshBuilder ParallelASCIIMeshReaderTest::sequential_builder_;
+ParallelASCIIMeshReaderTest::RecordingMeshBuilder ParallelASCIIMeshReaderTest::parallel_builder_;
+BoundaryConditionCollection                       ParallelASCIIMeshReaderTest::sequential_bc_;
+BoundaryConditionCollection                       ParallelASCIIMeshReaderTest::parallel_bc_;
+
+
+void
+ParallelASCIIMeshReaderTest::setUp() {
+    mesh_filename_ = "Data\\Versteeg_Malalasekera_11_25.mesh";
+
+    initMesh();
+}
+
+void
+ParallelASCIIMeshReaderTest::tearDown() {
+}
+
+void
+ParallelASCIIMeshReaderTest::testNodes() {
+    compare("node", sequential_builder_.nodes_, parallel_builder_.nodes_);
+}
+
+void
+ParallelASCIIMeshReaderTest::testFaces() {
+    compare("face", sequential_builder_.faces_, parallel_builder_.faces_);
+}
+
+void
+ParallelASCIIMeshReaderTest::testCells() {
+    compare("cell", sequential_builder_.cells_, parallel_builder_.cells_);
+}
+
+void
+ParallelASCIIMeshReaderTest::testBoundaryConditions() {
+    std::for_each(sequential_builder_.faces_.begin(), sequential_builder_.faces_.end(), [](RecordingMeshBuilder::Record const & face) {
+        auto expected = sequential_bc_.find(face.id_);
+        auto actual = parallel_bc_.find(face.id_);
+
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Boundary condition mismatch", expected.is_initialized(), actual.is_initialized());
+        if (expected) {
+            CPPUNIT_ASSERT_EQUAL_MESSAGE("Boundary condition type mismatch", std::get<0>(*expected), std::get<0>(*actual));
+            CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Boundary condition value mismatch", std::get<1>(*expected), std::get<1>(*actual), 1E-15);
+        }
+    });
+}
+
+void
+ParallelASCIIMeshReaderTest::testIdOrder() {
+    auto is_sorted = [](std::vector<RecordingMeshBuilder::Record> const & records) -> bool {
+        for (std::size_t i = 1; i < records.size(); ++i) {
+            if (records[i - 1].id_ > records[i].id_)
+                return false;
+        }
+        return true;
+    };
+
+    CPPUNIT_ASSERT_MESSAGE("Nodes not built in id order", is_sorted(parallel_builder_.nodes_));
+    CPPUNIT_ASSERT_MESSAGE("Faces not built in id order", is_sorted(parallel_builder_.faces_));
+    CPPUNIT_ASSERT_MESSAGE("Cells not built in id order", is_sorted(parallel_builder_.cells_));
+}
+
+void
+ParallelASCIIMeshReaderTest::testInvalidInput() {
+    std::string filename = "parallel_reader_invalid.mesh";
+    {
+        std::ofstream out(filename.c_str());
+        out << "vertices\n0 1 0 0\n1 1 1 0\n2 1 x 1\nfaces\n0 1 0 1\n";
+    }
+
+    RecordingMeshBuilder builder;
+    ParallelASCIIMeshReader reader(filename, builder, 2);
+    reader.setMinimumChunkSize(1);
+    bool result = reader.read();
+    std::remove(filename.c_str());
+
+    CPPUNIT_ASSERT_MESSAGE("Invalid input not detected", !result);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Entities built despite invalid input", std::size_t(0), builder.nodes_.size());
+}
+
+ParallelASCIIMeshReaderTest::RecordMap_t
+ParallelASCIIMeshReaderTest::byId(std::vector<RecordingMeshBuilder::Record> const & records) {
+    RecordMap_t map;
+    std::for_each(records.begin(), records.end(), [&map](RecordingMeshBuilder::Record const & r) {
+        map[r.id_] = &r;
+    });
+    return map;
+}
+
+void
+ParallelASCIIMeshReaderTest::compare(std::string const & what, std::vector<RecordingMeshBuilder::Record> const & expected, std::vector<RecordingMeshBuilder::Record> const & actual) {
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of " + what + "s", expected.size(), actual.size());
+
+    RecordMap_t actual_map = byId(actual);
+
+    std::for_each(expected.begin(), expected.end(), [&](RecordingMeshBuilder::Record const & e) {
+        std::string msg = (boost::format("%1% %2%") % what % e.id_).str();
+
+        auto it = actual_map.find(e.id_);
+        CPPUNIT_ASSERT_MESSAGE(msg + " missing", it != actual_map.end());
+
+        RecordingMeshBuilder::Record const & a = *it->second;
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(msg + ": wrong entity type", e.entity_type_, a.entity_type_);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(msg + ": wrong x coordinate", e.x_, a.x_, 1E-15);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(msg + ": wrong y coordinate", e.y_, a.y_, 1E-15);
+        CPPUNIT_ASSERT_MESSAGE(msg + ": wrong references", e.refs_ == a.refs_);
+    });
+}
+
+void
+ParallelASCIIMeshReaderTest::initMesh() {
+    static bool init = false;
+    if (!init)
+    {
+        init = true;
+
+        ASCIIMeshReader reader(mesh_filename_, sequential_builder_);
+        CPPUNIT_ASSERT_MESSAGE("Failed to read mesh file!", reader.read());
+        sequential_bc_ = reader.getBoundaryConditions();
+
+        // force several chunks per section even for this small mesh
+        ParallelASCIIMeshReader parallel_reader(mesh_filename_, parallel_builder_, 4);
+        parallel_reader.setMinimumChunkSize(1);
+        CPPUNIT_ASSERT_MESSAGE("Failed to read mesh file in parallel!", parallel_reader.read());
+        parallel_bc_ = parallel_reader.getBoundaryConditions();
+    }
+}
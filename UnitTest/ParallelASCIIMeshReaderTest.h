@@ -0,0 +1,105 @@
+/*
+ * Name  : ParallelASCIIMeshReaderTest
+ * Path  : 
+ * Use   : Checks that the parallel mesh reader delivers exactly
+ *         the same entities as the sequential ASCIIMeshReader.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "FiniteVolume2DLib/IMeshBuilder.h"
+#include "FiniteVolume2DLib/BoundaryConditionCollection.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <map>
+#include <vector>
+#include <string>
+
+
+class ParallelASCIIMeshReaderTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(ParallelASCIIMeshReaderTest);
+    CPPUNIT_TEST(testNodes);
+    CPPUNIT_TEST(testFaces);
+    CPPUNIT_TEST(testCells);
+    CPPUNIT_TEST(testBoundaryConditions);
+    CPPUNIT_TEST(testIdOrder);
+    CPPUNIT_TEST(testInvalidInput);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    // Records all entities in the order they are built
+    class RecordingMeshBuilder : public IMeshBuilder {
+    public:
+        struct Record {
+            Record(IGeometricEntity::Id_t id, IGeometricEntity::Entity_t entity_type, std::vector<IGeometricEntity::Id_t> const & refs, double x = 0, double y = 0)
+                : id_(id), entity_type_(entity_type), refs_(refs), x_(x), y_(y) {}
+
+            IGeometricEntity::Id_t              id_;
+            IGeometricEntity::Entity_t          entity_type_;
+            std::vector<IGeometricEntity::Id_t> refs_;
+            double                              x_;
+            double                              y_;
+        };
+
+    public:
+        bool
+        buildNode(IGeometricEntity::Id_t node_id, IGeometricEntity::Entity_t entity_type, double x, double y) {
+            nodes_.push_back(Record(node_id, entity_type, std::vector<IGeometricEntity::Id_t>(), x, y));
+            return true;
+        }
+
+        bool
+        buildFace(IGeometricEntity::Id_t face_id, IGeometricEntity::Entity_t entity_type, std::vector<IGeometricEntity::Id_t> const & node_ids) {
+            faces_.push_back(Record(face_id, entity_type, node_ids));
+            return true;
+        }
+
+        bool
+        buildCell(IGeometricEntity::Id_t cell_id, std::vector<IGeometricEntity::Id_t> const & face_ids) {
+            cells_.push_back(Record(cell_id, IGeometricEntity::UNKNOWN, face_ids));
+            return true;
+        }
+
+        void
+        outputReport(std::ostream &) const {}
+
+        boost::optional<Mesh::Ptr>
+        getMesh() const {
+            return boost::optional<Mesh::Ptr>();
+        }
+
+    public:
+        std::vector<Record> nodes_;
+        std::vector<Record> faces_;
+        std::vector<Record> cells_;
+    };
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testNodes();
+    void testFaces();
+    void testCells();
+    void testBoundaryConditions();
+    void testIdOrder();
+    void testInvalidInput();
+
+private:
+    typedef std::map<IGeometricEntity::Id_t, RecordingMeshBuilder::Record const *> RecordMap_t;
+
+    static RecordMap_t byId(std::vector<RecordingMeshBuilder::Record> const & records);
+    static void        compare(std::string const & what, std::vector<RecordingMeshBuilder::Record> const & expected, std::vector<RecordingMeshBuilder::Record> const & actual);
+
+    void initMesh();
+
+private:
+    std::string                        mesh_filename_;
+    static RecordingMeshBuilder        sequential_builder_;
+    static RecordingMeshBuilder        parallel_builder_;
+    static BoundaryConditionCollection sequential_bc_;
+    static BoundaryConditionCollection parallel_bc_;
+};
@@ -0,0 +1,63 @@
+#include "ParallelForTest.h"
+
+#include "FiniteVolume2DLib/ParallelFor.hpp"
+
+#include <atomic>
+#include <vector>
+#include <stdexcept>
+
+
+void
+ParallelForTest::setUp() {}
+
+void
+ParallelForTest::tearDown() {}
+
+void
+ParallelForTest::testChunks() {
+    std::size_t sizes[] = {0, 1, ParallelFor::MIN_CHUNK_SIZE - 1, 4 * ParallelFor::MIN_CHUNK_SIZE + 3};
+
+    for (std::size_t n : sizes) {
+        std::vector<int> visited(n, 0);
+        std::atomic<int> nchunks(0);
+
+        ParallelFor::forEachChunk(n, 4, [&](std::size_t begin, std::size_t end) {
+            ++nchunks;
+            for (std::size_t i = begin; i < end; ++i)
+                visited[i]++;
+        });
+
+        for (std::size_t i = 0; i < n; ++i)
+            CPPUNIT_ASSERT_EQUAL_MESSAGE("Element not visited exactly once", 1, visited[i]);
+
+        CPPUNIT_ASSERT_MESSAGE("Wrong number of chunks", nchunks >= 1 && nchunks <= 4);
+    }
+
+    // small ranges are split with a smaller minimum chunk size
+    std::atomic<int> nchunks(0);
+    ParallelFor::forEachChunk(8, 4, 1, [&](std::size_t, std::size_t) { ++nchunks; });
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of chunks", 4, nchunks.load());
+
+    CPPUNIT_ASSERT_MESSAGE("No thread", ParallelFor::numberOfThreads(0) >= 1);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of threads", 3u, ParallelFor::numberOfThreads(3));
+}
+
+void
+ParallelForTest::testException() {
+    std::size_t n = 4 * ParallelFor::MIN_CHUNK_SIZE;
+
+    // thrown by the calling thread and by a worker; all chunks finish before the rethrow
+    for (std::size_t failing = 0; failing < n; failing += 3 * ParallelFor::MIN_CHUNK_SIZE) {
+        std::atomic<int> finished(0);
+
+        CPPUNIT_ASSERT_THROW_MESSAGE("Exception not rethrown",
+            ParallelFor::forEachChunk(n, 4, [&](std::size_t begin, std::size_t end) {
+                ++finished;
+                if (begin <= failing && failing < end)
+                    throw std::runtime_error("chunk failed");
+            }),
+            std::runtime_error);
+
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Threads not joined", 4, finished.load());
+    }
+}
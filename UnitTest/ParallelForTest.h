@@ -0,0 +1,26 @@
+/*
+ * Name  : ParallelForTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class ParallelForTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(ParallelForTest);
+    CPPUNIT_TEST(testChunks);
+    CPPUNIT_TEST(testException);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testChunks();
+    void testException();
+};
@@ -0,0 +1,107 @@
+#include "ProfilerTest.h"
+
+#include "FiniteVolume2DLib/Profiler.h"
+
+#include <sstream>
+#include <string>
+
+
+void
+ProfilerTest::setUp() {
+    Profiler::instance().reset();
+}
+
+void
+ProfilerTest::tearDown() {
+    Profiler::instance().enable(false);
+    Profiler::instance().reset();
+}
+
+void
+ProfilerTest::testDisabled() {
+    Profiler & profiler = Profiler::instance();
+    profiler.enable(false);
+
+    {
+        Profiler::ScopedTimer timer("phase");
+    }
+    profiler.addCount("counter", 3);
+    profiler.addSample("sample", 1.0);
+
+    CPPUNIT_ASSERT_MESSAGE("Timing recorded while disabled", profiler.getTimings().empty());
+    CPPUNIT_ASSERT_MESSAGE("Counter recorded while disabled", profiler.getCounters().empty());
+    CPPUNIT_ASSERT_MESSAGE("Sample recorded while disabled", profiler.getSamples().empty());
+}
+
+void
+ProfilerTest::testTimings() {
+    Profiler & profiler = Profiler::instance();
+    profiler.enable(true);
+
+    for (int i = 0; i < 3; ++i) {
+        Profiler::ScopedTimer timer("phase");
+    }
+    profiler.addTime("manual", 0.5);
+    profiler.addTime("manual", 1.5);
+
+    Profiler::Timings_t timings = profiler.getTimings();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of timers", std::size_t(2), timings.size());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of calls", boost::uint64_t(3), timings["phase"].calls);
+    CPPUNIT_ASSERT_MESSAGE("Negative time", timings["phase"].total >= 0.0);
+
+    Profiler::Timing const & manual = timings["manual"];
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of calls", boost::uint64_t(2), manual.calls);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong total time", 2.0, manual.total, 1E-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong minimum time", 0.5, manual.min, 1E-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong maximum time", 1.5, manual.max, 1E-15);
+
+    profiler.reset();
+    CPPUNIT_ASSERT_MESSAGE("Timings not reset", profiler.getTimings().empty());
+}
+
+void
+ProfilerTest::testCountersAndSamples() {
+    Profiler & profiler = Profiler::instance();
+    profiler.enable(true);
+
+    profiler.addCount("alloc");
+    profiler.addCount("alloc", 41);
+
+    profiler.addSample("residual", 3.0);
+    profiler.addSample("residual", 1.0);
+    profiler.addSample("residual", 2.0);
+
+    Profiler::Counters_t counters = profiler.getCounters();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong counter", boost::uint64_t(42), counters["alloc"]);
+
+    Profiler::Samples_t samples = profiler.getSamples();
+    Profiler::Sample const & residual = samples["residual"];
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of samples", boost::uint64_t(3), residual.count);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong last sample", 2.0, residual.last, 1E-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong minimum sample", 1.0, residual.min, 1E-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong maximum sample", 3.0, residual.max, 1E-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong sum of samples", 6.0, residual.sum, 1E-15);
+}
+
+void
+ProfilerTest::testReport() {
+    Profiler & profiler = Profiler::instance();
+    profiler.enable(true);
+
+    profiler.addTime("build \"phase\"", 0.25);
+    profiler.addCount("alloc/cells", 7);
+    profiler.addSample("solver/iterations", 12);
+
+    std::ostringstream text;
+    profiler.report(text);
+    CPPUNIT_ASSERT_MESSAGE("Timer missing in report", text.str().find("build \"phase\"") != std::string::npos);
+    CPPUNIT_ASSERT_MESSAGE("Counter missing in report", text.str().find("alloc/cells") != std::string::npos);
+    CPPUNIT_ASSERT_MESSAGE("Sample missing in report", text.str().find("solver/iterations") != std::string::npos);
+
+    std::ostringstream json;
+    profiler.reportJSON(json);
+    std::string const & s = json.str();
+    CPPUNIT_ASSERT_MESSAGE("Timer not escaped in JSON report", s.find("\"build \\\"phase\\\"\": {\"calls\": 1") != std::string::npos);
+    CPPUNIT_ASSERT_MESSAGE("Counter missing in JSON report", s.find("\"alloc/cells\": 7") != std::string::npos);
+    CPPUNIT_ASSERT_MESSAGE("Sample missing in JSON report", s.find("\"solver/iterations\": {\"count\": 1") != std::string::npos);
+}
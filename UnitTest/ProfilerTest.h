@@ -0,0 +1,30 @@
+/*
+ * Name  : ProfilerTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class ProfilerTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(ProfilerTest);
+    CPPUNIT_TEST(testDisabled);
+    CPPUNIT_TEST(testTimings);
+    CPPUNIT_TEST(testCountersAndSamples);
+    CPPUNIT_TEST(testReport);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testDisabled();
+    void testTimings();
+    void testCountersAndSamples();
+    void testReport();
+};
@@ -0,0 +1,203 @@
+#include "SparseLUTest.h"
+
+#include "Solver/SparseLU.h"
+#include "Solver/CSparseMatrixImpl.h"
+
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+
+
+namespace {
+    /* Five point stencil on an m x m grid with a convective
+     * (non-symmetric) part and Dirichlet values 1 around.
+     */
+    void convectionDiffusion(CSparseMatrixImpl & A, std::vector<double> & f, unsigned int m, double diagonal_shift) {
+        f.assign(m * m, 0.0);
+
+        for (unsigned int j = 0; j < m; ++j) {
+            for (unsigned int i = 0; i < m; ++i) {
+                unsigned int row = j * m + i;
+
+                A(row, row) = 4.5 + diagonal_shift;
+
+                if (i > 0) A(row, row - 1) = -1.5; else f[row] += 1.5;
+                if (i + 1 < m) A(row, row + 1) = -1.0; else f[row] += 1.0;
+                if (j > 0) A(row, row - m) = -1.0; else f[row] += 1.0;
+                if (j + 1 < m) A(row, row + m) = -1.0; else f[row] += 1.0;
+            }
+        }
+
+        A.finalize();
+    }
+
+    double
+    residualNorm(CSparseMatrixImpl const & A, std::vector<double> const & x, std::vector<double> const & f) {
+        std::vector<double> y(f.size());
+        A.multiply(x, y);
+
+        double sum = 0;
+        for (std::vector<double>::size_type i = 0; i < f.size(); ++i)
+            sum += (f[i] - y[i]) * (f[i] - y[i]);
+
+        return std::sqrt(sum);
+    }
+
+}
+
+void
+SparseLUTest::setUp() {
+}
+
+void
+SparseLUTest::tearDown() {
+}
+
+void
+SparseLUTest::testSolve() {
+    unsigned int const m = 12;
+
+    CSparseMatrixImpl A(m * m);
+    std::vector<double> f;
+    convectionDiffusion(A, f, m, 0.0);
+
+    SparseLU lu;
+    CPPUNIT_ASSERT_MESSAGE("Factorized too early", !lu.isFactorized());
+    CPPUNIT_ASSERT_THROW_MESSAGE("Solve without factor not detected", lu.solve(f, f), std::exception);
+
+    lu.factorize(A);
+    CPPUNIT_ASSERT_MESSAGE("Not factorized", lu.isFactorized());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong size", boost::uint64_t(m * m), lu.size());
+
+    std::vector<double> x;
+    lu.solve(f, x);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong size of solution", f.size(), x.size());
+    CPPUNIT_ASSERT_MESSAGE("Wrong solution", residualNorm(A, x, f) < 1E-12);
+
+    // zero row sums and boundary values 1
+    for (std::vector<double>::size_type i = 0; i < x.size(); ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong solution value", 1.0, x[i], 1E-12);
+
+    // further r.h.s. with the same factor
+    std::vector<double> g(f.size());
+    for (std::vector<double>::size_type i = 0; i < g.size(); ++i)
+        g[i] = std::sin(double(i));
+
+    lu.solve(g, x);
+    CPPUNIT_ASSERT_MESSAGE("Wrong solution", residualNorm(A, x, g) < 1E-12);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE("Size mismatch not detected", lu.solve(std::vector<double>(3, 0.0), x), std::out_of_range);
+}
+
+void
+SparseLUTest::testOrdering() {
+    unsigned int const m = 20;
+
+    CSparseMatrixImpl A(m * m);
+    std::vector<double> f;
+    convectionDiffusion(A, f, m, 0.0);
+
+    SparseLU natural(SparseLU::NATURAL);
+    natural.factorize(A);
+
+    SparseLU minimum_degree(SparseLU::MINIMUM_DEGREE);
+    minimum_degree.factorize(A);
+
+    // the band of the natural ordering fills completely
+    CPPUNIT_ASSERT_MESSAGE("No fill reduction", minimum_degree.nonZeros() < natural.nonZeros());
+    CPPUNIT_ASSERT_MESSAGE("Less than the matrix", minimum_degree.nonZeros() >= A.nonZeros());
+
+    // a permutation
+    std::vector<boost::uint64_t> const & perm = minimum_degree.getPermutation();
+    std::vector<bool> seen(perm.size(), false);
+    for (std::vector<boost::uint64_t>::size_type i = 0; i < perm.size(); ++i) {
+        CPPUNIT_ASSERT_MESSAGE("Not a permutation", perm[i] < perm.size() && !seen[perm[i]]);
+        seen[perm[i]] = true;
+    }
+
+    std::vector<double> x, x_natural;
+    minimum_degree.solve(f, x);
+    natural.solve(f, x_natural);
+
+    for (std::vector<double>::size_type i = 0; i < x.size(); ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Different solution", x_natural[i], x[i], 1E-12);
+}
+
+void
+SparseLUTest::testRefactorize() {
+    unsigned int const m = 10;
+
+    CSparseMatrixImpl A(m * m);
+    std::vector<double> f;
+    convectionDiffusion(A, f, m, 0.0);
+
+    SparseLU lu;
+    lu.factorize(A);
+
+    std::vector<boost::uint64_t> perm = lu.getPermutation();
+
+    // same pattern, different values, e.g. a time derivative
+    CSparseMatrixImpl B(m * m);
+    convectionDiffusion(B, f, m, 10.0);
+
+    lu.refactorize(B);
+    CPPUNIT_ASSERT_MESSAGE("Ordering changed", perm == lu.getPermutation());
+
+    std::vector<double> x;
+    lu.solve(f, x);
+    CPPUNIT_ASSERT_MESSAGE("Wrong solution", residualNorm(B, x, f) < 1E-12);
+
+    // a different pattern is factorized from scratch
+    CSparseMatrixImpl C(3);
+    C(0, 0) = 1.0;
+    C(1, 1) = 1.0;
+    C(1, 2) = 1.0;
+    C.finalize();
+    CPPUNIT_ASSERT_THROW_MESSAGE("Non-square matrix not detected", lu.refactorize(C), std::out_of_range);
+
+    CSparseMatrixImpl D(4);
+    std::vector<double> g;
+    convectionDiffusion(D, g, 2, 0.0);
+
+    lu.refactorize(D);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong size", boost::uint64_t(4), lu.size());
+
+    lu.solve(g, x);
+    CPPUNIT_ASSERT_MESSAGE("Wrong solution", residualNorm(D, x, g) < 1E-12);
+}
+
+void
+SparseLUTest::testSingular() {
+    // the second row is a multiple of the first
+    CSparseMatrixImpl A(2);
+    A(0, 0) =  1.0;
+    A(0, 1) = -1.0;
+    A(1, 0) = -2.0;
+    A(1, 1) =  2.0;
+    A.finalize();
+
+    SparseLU lu(SparseLU::NATURAL);
+    CPPUNIT_ASSERT_THROW_MESSAGE("Zero pivot not detected", lu.factorize(A), std::exception);
+    CPPUNIT_ASSERT_MESSAGE("Factorized", !lu.isFactorized());
+}
+
+void
+SparseLUTest::testSmallPivot() {
+    // not diagonally dominant, the first pivot is tiny relative to its row
+    CSparseMatrixImpl A(2);
+    A(0, 0) = 1E-14;
+    A(0, 1) = 1.0;
+    A(1, 0) = 1.0;
+    A(1, 1) = 1.0;
+    A.finalize();
+
+    SparseLU lu(SparseLU::NATURAL);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong default tolerance", 1E-12, lu.getPivotTolerance());
+    CPPUNIT_ASSERT_THROW_MESSAGE("Small pivot not detected", lu.factorize(A), std::exception);
+    CPPUNIT_ASSERT_MESSAGE("Factorized", !lu.isFactorized());
+
+    lu.setPivotTolerance(1E-15);
+    lu.factorize(A);
+    CPPUNIT_ASSERT_MESSAGE("Not factorized", lu.isFactorized());
+}
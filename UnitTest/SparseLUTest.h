@@ -0,0 +1,32 @@
+/*
+ * Name  : SparseLUTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class SparseLUTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(SparseLUTest);
+    CPPUNIT_TEST(testSolve);
+    CPPUNIT_TEST(testOrdering);
+    CPPUNIT_TEST(testRefactorize);
+    CPPUNIT_TEST(testSingular);
+    CPPUNIT_TEST(testSmallPivot);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testSolve();
+    void testOrdering();
+    void testRefactorize();
+    void testSingular();
+    void testSmallPivot();
+};
@@ -0,0 +1,130 @@
+#include "TestMeshFactory.h"
+
+#include "FiniteVolume2D/DiffusionFluxEvaluator.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <algorithm>
+#include <cmath>
+
+
+TestMeshFactory::TestMeshFactory(unsigned int n) : generator_(0.0, 0.0, 1.0, 1.0, n, n) {}
+
+TestMeshFactory::TestMeshFactory(double x0, double y0, double x1, double y1, unsigned int nx, unsigned int ny)
+    : generator_(x0, y0, x1, y1, nx, ny) {}
+
+TestMeshFactory &
+TestMeshFactory::setDistortion(double perturbation, unsigned int seed) {
+    generator_.setRandomDiagonals(true, seed);
+    if (perturbation > 0)
+        generator_.setPerturbation(perturbation, seed + 2);
+
+    return *this;
+}
+
+TestMeshFactory &
+TestMeshFactory::setBoundaryCondition(MeshGenerator::Side side, BoundaryConditionCollection::Type type, double value) {
+    generator_.setBoundaryCondition(side, type, value);
+    return *this;
+}
+
+TestMeshFactory &
+TestMeshFactory::setChannel(double left, double right, BoundaryConditionCollection::Type type) {
+    generator_.setBoundaryCondition(MeshGenerator::LEFT,   type, left);
+    generator_.setBoundaryCondition(MeshGenerator::RIGHT,  type, right);
+    generator_.setBoundaryCondition(MeshGenerator::TOP,    BoundaryConditionCollection::NEUMANN, 0.0);
+    generator_.setBoundaryCondition(MeshGenerator::BOTTOM, BoundaryConditionCollection::NEUMANN, 0.0);
+
+    return *this;
+}
+
+Mesh::Ptr
+TestMeshFactory::getMesh() {
+    if (!mesh_) {
+        CPPUNIT_ASSERT_MESSAGE("Mesh generation failed", generator_.generate(builder_, bc_));
+        mesh_ = *builder_.getMesh();
+    }
+
+    return mesh_;
+}
+
+BoundaryConditionCollection const &
+TestMeshFactory::getBoundaryConditions() {
+    getMesh();
+    return bc_;
+}
+
+ComputationalMesh::CPtr
+TestMeshFactory::buildComputationalMesh(std::vector<DiffusionFluxEvaluator const *> const & evaluators) {
+    ComputationalMeshBuilder builder(getMesh(), bc_);
+
+    std::for_each(evaluators.begin(), evaluators.end(), [&](DiffusionFluxEvaluator const * evaluator) {
+        builder.addComputationalVariable(evaluator->getVariableName(), std::ref(*evaluator));
+    });
+
+    // one cell evaluator for all variables
+    builder.addEvaluateCellMolecules([evaluators](ComputationalCell::Ptr const & ccell) {
+        return std::all_of(evaluators.begin(), evaluators.end(), [&ccell](DiffusionFluxEvaluator const * evaluator) { return evaluator->evaluateCell(ccell); });
+    });
+
+    return builder.build();
+}
+
+ComputationalMesh::CPtr
+TestMeshFactory::buildDiffusionMesh(std::string const & var_name, double gamma) {
+    evaluators_.push_back(std::unique_ptr<DiffusionFluxEvaluator>(new DiffusionFluxEvaluator(*getMesh(), var_name, gamma)));
+    return buildComputationalMesh({evaluators_.back().get()});
+}
+
+ComputationalMesh::CPtr
+TestMeshFactory::buildComputationalMesh(std::string const & var_name, ComputationalMeshBuilder::FluxEvaluator_t const & flux_evaluator) {
+    ComputationalMeshBuilder builder(getMesh(), bc_);
+
+    builder.addComputationalVariable(var_name, flux_evaluator);
+    builder.addEvaluateCellMolecules(cellEvaluator(var_name));
+
+    return builder.build();
+}
+
+ComputationalMeshBuilder::CellMoleculeEvaluator_t
+TestMeshFactory::cellEvaluator(std::string const & var_name) {
+    return [var_name](ComputationalCell::Ptr const & ccell) -> bool {
+        EntityCollection<ComputationalFace> const & cface_coll = ccell->getComputationalFaces();
+
+        ComputationalMolecule & cmolecule = ccell->getComputationalMolecule(var_name);
+
+        std::for_each(cface_coll.begin(), cface_coll.end(), [&](ComputationalFace::Ptr const & cface) {
+            FluxComputationalMolecule & flux_molecule = cface->getComputationalMolecule(var_name);
+
+            if (flux_molecule.getCell() != ccell)
+                flux_molecule = -flux_molecule;
+
+            cmolecule.addMolecule(flux_molecule);
+        });
+
+        return true;
+    };
+}
+
+std::vector<double>
+TestMeshFactory::cellValues(IComputationalMesh const & cmesh, std::string const & var_name) {
+    Thread<ComputationalCell> const & cells = cmesh.getCellThread();
+
+    std::vector<double> values;
+    std::for_each(cells.begin(), cells.end(), [&](ComputationalCell::Ptr const & ccell) {
+        values.push_back(ccell->getComputationalMolecule(var_name).getValue());
+    });
+
+    return values;
+}
+
+double
+TestMeshFactory::maxDifference(std::vector<double> const & a, std::vector<double> const & b) {
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Size mismatch", a.size(), b.size());
+
+    double diff = 0.0;
+    for (std::vector<double>::size_type i = 0; i < a.size(); ++i)
+        diff = std::max(diff, std::fabs(a[i] - b[i]));
+
+    return diff;
+}
@@ -0,0 +1,82 @@
+/*
+ * Name  : TestMeshFactory
+ * Path  : 
+ * Use   : Generated meshes for the unit tests. Keeps the mesh builder
+ *         the mesh depends on alive and builds computational meshes
+ *         with DiffusionFluxEvaluator variables. Also the helpers to
+ *         compare the solutions of the tests.
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include "internal/MeshBuilderMock.h"
+
+#include "FiniteVolume2D/ComputationalMesh.h"
+#include "FiniteVolume2D/ComputationalMeshBuilder.h"
+#include "FiniteVolume2D/DiffusionFluxEvaluator.h"
+
+#include "FiniteVolume2DLib/Mesh.h"
+#include "FiniteVolume2DLib/MeshGenerator.h"
+#include "FiniteVolume2DLib/BoundaryConditionCollection.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+class TestMeshFactory {
+public:
+    // cells per side large enough to be split between the threads
+    static unsigned int const THREADED_SIZE = 60;
+
+public:
+    // unit square with n x n quads, Dirichlet 0 at all sides
+    explicit TestMeshFactory(unsigned int n);
+    TestMeshFactory(double x0, double y0, double x1, double y1, unsigned int nx, unsigned int ny);
+
+    /* Random diagonals (seed) and, if perturbation > 0, interior nodes
+     * displaced by up to perturbation of a quad (seed + 2).
+     */
+    TestMeshFactory &          setDistortion(double perturbation, unsigned int seed);
+
+    TestMeshFactory &          setBoundaryCondition(MeshGenerator::Side side, BoundaryConditionCollection::Type type, double value);
+
+    // left and right of type with the values, no flux at the top and the bottom
+    TestMeshFactory &          setChannel(double left, double right, BoundaryConditionCollection::Type type = BoundaryConditionCollection::DIRICHLET);
+
+    // generated on the first call, asserts success
+    Mesh::Ptr                  getMesh();
+    BoundaryConditionCollection const & getBoundaryConditions();
+
+    /* The variables of the evaluators, evaluated by one cell evaluator.
+     * The evaluators must outlive the mesh.
+     */
+    ComputationalMesh::CPtr    buildComputationalMesh(std::vector<DiffusionFluxEvaluator const *> const & evaluators);
+
+    // one variable of a DiffusionFluxEvaluator kept by the factory
+    ComputationalMesh::CPtr    buildDiffusionMesh(std::string const & var_name, double gamma = 1.0);
+
+    // one variable of flux_evaluator, evaluated by cellEvaluator()
+    ComputationalMesh::CPtr    buildComputationalMesh(std::string const & var_name, ComputationalMeshBuilder::FluxEvaluator_t const & flux_evaluator);
+
+    // sums the face fluxes of the variable into the cell molecule
+    static ComputationalMeshBuilder::CellMoleculeEvaluator_t cellEvaluator(std::string const & var_name);
+
+    // the value of the variable per cell, in the order of the cell thread
+    static std::vector<double> cellValues(IComputationalMesh const & cmesh, std::string const & var_name);
+
+    static double              maxDifference(std::vector<double> const & a, std::vector<double> const & b);
+
+private:
+    TestMeshFactory(TestMeshFactory const & in);
+    TestMeshFactory & operator=(TestMeshFactory const & in);
+
+private:
+    MeshGenerator               generator_;
+    MeshBuilderMock             builder_;
+    BoundaryConditionCollection bc_;
+    Mesh::Ptr                   mesh_;
+
+    std::vector<std::unique_ptr<DiffusionFluxEvaluator>> evaluators_;
+};
@@ -0,0 +1,223 @@
+#include "TransientSolverTest.h"
+
+#include "TestMeshFactory.h"
+
+#include "FiniteVolume2D/TransientSolver.h"
+#include "FiniteVolume2D/ComputationalMeshSolverHelper.h"
+
+#include <vector>
+
+
+namespace {
+
+    // heat conduction in the unit square, T = 100 on the left, T = 0 on the right
+    ComputationalMesh::CPtr
+    buildMesh(TestMeshFactory & factory) {
+        return factory.setChannel(100.0, 0.0).buildDiffusionMesh("Temperature");
+    }
+
+    std::vector<double>
+    temperature(IComputationalMesh const & cmesh) {
+        return TestMeshFactory::cellValues(cmesh, "Temperature");
+    }
+
+    LinearSolver::Control
+    solverControl() {
+        LinearSolver::Control control;
+        control.relative_tolerance = 1E-13;
+
+        return control;
+    }
+
+    // T(t_end) starting from T = 0
+    std::vector<double>
+    solveTransient(TransientSolver::Scheme scheme, double t_end, double dt) {
+        TestMeshFactory factory(6);
+        ComputationalMesh::CPtr cmesh = buildMesh(factory);
+
+        TransientSolver solver(*cmesh, scheme);
+        solver.setSolverControl(solverControl());
+        CPPUNIT_ASSERT_MESSAGE("Transient solve failed", solver.run(t_end, dt));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong end time", t_end, solver.getTime(), 1E-12);
+
+        return temperature(*cmesh);
+    }
+
+}
+
+void
+TransientSolverTest::setUp() {
+}
+
+void
+TransientSolverTest::tearDown() {
+}
+
+void
+TransientSolverTest::testSteadyState() {
+    TestMeshFactory factory(6);
+    ComputationalMesh::CPtr cmesh = buildMesh(factory);
+
+    ComputationalMeshSolverHelper helper(*cmesh);
+    helper.setSolverControl(solverControl());
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+    std::vector<double> T_steady = temperature(*cmesh);
+
+    TransientSolver::Scheme const schemes[] = { TransientSolver::BACKWARD_EULER, TransientSolver::CRANK_NICOLSON, TransientSolver::BDF2 };
+
+    for (int k = 0; k < 3; ++k) {
+        TestMeshFactory factory_t(6);
+        ComputationalMesh::CPtr cmesh_t = buildMesh(factory_t);
+
+        TransientSolver solver(*cmesh_t, schemes[k]);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong scheme", schemes[k], solver.getScheme());
+
+        solver.setSolverControl(solverControl());
+        solver.setCapacity(0.5);
+        CPPUNIT_ASSERT_MESSAGE("Transient solve failed", solver.run(4.0, 0.02));
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of steps", 200u, solver.getStep());
+
+        CPPUNIT_ASSERT_MESSAGE("Steady state not reached", TestMeshFactory::maxDifference(T_steady, temperature(*cmesh_t)) < 1E-8);
+    }
+}
+
+void
+TransientSolverTest::testTimeAccuracy() {
+    double const t_end = 0.05;
+
+    std::vector<double> T_ref = solveTransient(TransientSolver::BDF2, t_end, t_end / 800.0);
+
+    TransientSolver::Scheme const schemes[] = {TransientSolver::BACKWARD_EULER, TransientSolver::CRANK_NICOLSON, TransientSolver::BDF2};
+
+    // errors at dt, dt / 2 and dt / 4
+    double error[3][3];
+    for (int k = 0; k < 3; ++k)
+        for (int j = 0; j < 3; ++j)
+            error[k][j] = TestMeshFactory::maxDifference(T_ref, solveTransient(schemes[k], t_end, t_end / (20.0 * (1 << j))));
+
+    for (int j = 0; j < 2; ++j) {
+        // first order: halving the step halves the error
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Backward Euler not first order", 2.0, error[0][j] / error[0][j + 1], 0.3);
+
+        // second order: halving the step quarters the error
+        CPPUNIT_ASSERT_MESSAGE("Crank-Nicolson not second order", error[1][j] / error[1][j + 1] > 3.5);
+        CPPUNIT_ASSERT_MESSAGE("BDF2 not second order", error[2][j] / error[2][j + 1] > 3.5);
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("BDF2 less accurate than backward Euler", error[2][0] < error[0][0]);
+    CPPUNIT_ASSERT_MESSAGE("Crank-Nicolson less accurate than backward Euler", error[1][0] < error[0][0]);
+}
+
+void
+TransientSolverTest::testOutput() {
+    TestMeshFactory factory(4);
+    ComputationalMesh::CPtr cmesh = buildMesh(factory);
+
+    TransientSolver solver(*cmesh, TransientSolver::BDF2);
+    solver.setSolverControl(solverControl());
+
+    std::vector<unsigned int> steps;
+    std::vector<double>       times;
+    solver.setOutput([&](unsigned int step, double time, IComputationalMesh const & out) {
+        CPPUNIT_ASSERT_MESSAGE("Wrong mesh", &out == cmesh.get());
+        steps.push_back(step);
+        times.push_back(time);
+    }, 3);
+
+    solver.setTime(1.0);
+    CPPUNIT_ASSERT_MESSAGE("Transient solve failed", solver.run(2.0, 0.1));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of steps", 10u, solver.getStep());
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of outputs", std::size_t(3), steps.size());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong output step", 9u, steps.back());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong output time", 1.9, times.back(), 1E-12);
+}
+
+void
+TransientSolverTest::testInvalidStep() {
+    TestMeshFactory factory(2);
+    ComputationalMesh::CPtr cmesh = buildMesh(factory);
+
+    TransientSolver solver(*cmesh);
+    CPPUNIT_ASSERT_MESSAGE("Invalid time step not detected", !solver.step(0.0));
+    CPPUNIT_ASSERT_MESSAGE("Invalid time step not detected", !solver.run(1.0, -0.1));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Step taken", 0u, solver.getStep());
+}
+
+void
+TransientSolverTest::testAdaptiveSteadyState() {
+    TestMeshFactory factory(6);
+    ComputationalMesh::CPtr cmesh = buildMesh(factory);
+
+    ComputationalMeshSolverHelper helper(*cmesh);
+    helper.setSolverControl(solverControl());
+    CPPUNIT_ASSERT_MESSAGE("Could not solve for computational mesh", helper.solve());
+    std::vector<double> T_steady = temperature(*cmesh);
+
+    TestMeshFactory factory_t(6);
+    ComputationalMesh::CPtr cmesh_t = buildMesh(factory_t);
+
+    TransientSolver solver(*cmesh_t, TransientSolver::BDF2);
+    solver.setSolverControl(solverControl());
+
+    TransientSolver::AdaptiveControl control;
+    control.absolute_tolerance = 1E-2;
+    control.steady_tolerance = 1E-8;
+
+    TransientSolver::AdaptiveStatistics stats;
+    CPPUNIT_ASSERT_MESSAGE("Adaptive solve failed", solver.runAdaptive(1E6, 1E-4, control, stats));
+
+    CPPUNIT_ASSERT_MESSAGE("Steady state not detected", stats.steady);
+    CPPUNIT_ASSERT_MESSAGE("End time reached", solver.getTime() < 1E6);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of steps", stats.accepted, solver.getStep());
+    CPPUNIT_ASSERT_MESSAGE("Step size not increased", stats.dt > 10.0);
+
+    // a fixed step of 1E-4 would need millions of steps
+    CPPUNIT_ASSERT_MESSAGE("Too many steps", stats.accepted < 300);
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of solves", stats.solves >= stats.accepted + stats.rejected);
+
+    CPPUNIT_ASSERT_MESSAGE("Steady state not reached", TestMeshFactory::maxDifference(T_steady, temperature(*cmesh_t)) < 1E-6);
+}
+
+void
+TransientSolverTest::testAdaptiveAccuracy() {
+    double const t_end = 0.05;
+
+    std::vector<double> T_ref = solveTransient(TransientSolver::BDF2, t_end, t_end / 800.0);
+
+    double const tolerances[] = { 1E-2, 1E-3 };
+    double errors[2];
+    unsigned int steps[2];
+
+    for (int k = 0; k < 2; ++k) {
+        TestMeshFactory factory(6);
+        ComputationalMesh::CPtr cmesh = buildMesh(factory);
+
+        TransientSolver solver(*cmesh, TransientSolver::BACKWARD_EULER);
+        solver.setSolverControl(solverControl());
+
+        TransientSolver::AdaptiveControl control;
+        control.relative_tolerance = tolerances[k];
+        control.absolute_tolerance = tolerances[k];
+
+        TransientSolver::AdaptiveStatistics stats;
+        CPPUNIT_ASSERT_MESSAGE("Adaptive solve failed", solver.runAdaptive(t_end, 1E-3, control, stats));
+        CPPUNIT_ASSERT_MESSAGE("Steady state detected", !stats.steady);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Wrong end time", t_end, solver.getTime(), 1E-12);
+
+        errors[k] = TestMeshFactory::maxDifference(T_ref, temperature(*cmesh));
+        steps[k] = stats.accepted;
+    }
+
+    // a tighter tolerance yields a more accurate solution with more steps
+    CPPUNIT_ASSERT_MESSAGE("Error not reduced", errors[1] < errors[0]);
+    CPPUNIT_ASSERT_MESSAGE("Number of steps not increased", steps[1] > steps[0]);
+
+    // not available for Crank-Nicolson
+    TestMeshFactory factory(2);
+    ComputationalMesh::CPtr cmesh = buildMesh(factory);
+    TransientSolver solver(*cmesh, TransientSolver::CRANK_NICOLSON);
+
+    TransientSolver::AdaptiveStatistics stats;
+    CPPUNIT_ASSERT_MESSAGE("Crank-Nicolson not rejected", !solver.runAdaptive(1.0, 0.1, TransientSolver::AdaptiveControl(), stats));
+}
@@ -0,0 +1,34 @@
+/*
+ * Name  : TransientSolverTest
+ * Path  : 
+ * Use   : 
+ * Author: Sven Schmidt
+ * Date  : 10/18/2026
+ */
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class TransientSolverTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(TransientSolverTest);
+    CPPUNIT_TEST(testSteadyState);
+    CPPUNIT_TEST(testTimeAccuracy);
+    CPPUNIT_TEST(testOutput);
+    CPPUNIT_TEST(testInvalidStep);
+    CPPUNIT_TEST(testAdaptiveSteadyState);
+    CPPUNIT_TEST(testAdaptiveAccuracy);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void testSteadyState();
+    void testTimeAccuracy();
+    void testOutput();
+    void testInvalidStep();
+    void testAdaptiveSteadyState();
+    void testAdaptiveAccuracy();
+};
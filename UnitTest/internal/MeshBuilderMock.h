@@ -44,6 +44,21 @@ public:
         return mesh_builder_->buildCell(cell_id, face_ids);
     }
 
+    bool buildNodes(std::vector<IGeometricEntity::Id_t> const & node_ids, std::vector<IGeometricEntity::Entity_t> const & entity_types,
+                    std::vector<double> const & x, std::vector<double> const & y) {
+        return mesh_builder_->buildNodes(node_ids, entity_types, x, y);
+    }
+
+    bool buildFaces(std::vector<IGeometricEntity::Id_t> const & face_ids, std::vector<IGeometricEntity::Entity_t> const & entity_types,
+                    std::vector<IGeometricEntity::Id_t> const & node_ids) {
+        return mesh_builder_->buildFaces(face_ids, entity_types, node_ids);
+    }
+
+    bool buildCells(std::vector<IGeometricEntity::Id_t> const & cell_ids, std::vector<std::size_t> const & offsets,
+                    std::vector<IGeometricEntity::Id_t> const & face_ids) {
+        return mesh_builder_->buildCells(cell_ids, offsets, face_ids);
+    }
+
     void outputReport(std::ostream & target) const {}
 
     boost::optional<Mesh::Ptr> getMesh() const {
@@ -20,6 +20,25 @@
 #include "VersteegMalalasekeraTest.h"
 #include "VersteegMalalasekeraMeshDistortedTest.h"
 #include "GeometricHelperTest.h"
+#include "ParallelASCIIMeshReaderTest.h"
+#include "MeshBuilderBulkTest.h"
+#include "MeshGeneratorTest.h"
+#include "ProfilerTest.h"
+#include "LinearSolverTest.h"
+#include "TransientSolverTest.h"
+#include "NonlinearSolverTest.h"
+#include "SparseLUTest.h"
+#include "DenseLUTest.h"
+#include "MeshGeometryTest.h"
+#include "MeshQualityTest.h"
+#include "DiffusionFluxEvaluatorTest.h"
+#include "CellGradientTest.h"
+#include "DeferredCorrectionSolverTest.h"
+#include "InterpolationOperatorTest.h"
+#include "ConvectionSchemeTest.h"
+#include "CellSourceTermsTest.h"
+#include "ParallelForTest.h"
+#include "InstructionSetTest.h"
 
 
 CPPUNIT_TEST_SUITE_REGISTRATION(ComputationalMeshSolverHelperTest);
@@ -34,6 +53,25 @@ CPPUNIT_TEST_SUITE_REGISTRATION(MeshCheckerTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(VersteegMalalasekeraTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(VersteegMalalasekeraMeshDistortedTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(GeometricHelperTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(ParallelASCIIMeshReaderTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(MeshBuilderBulkTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(MeshGeneratorTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(ProfilerTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(LinearSolverTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(TransientSolverTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(NonlinearSolverTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(SparseLUTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(DenseLUTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(MeshGeometryTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(MeshQualityTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(DiffusionFluxEvaluatorTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(CellGradientTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(DeferredCorrectionSolverTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(InterpolationOperatorTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(ConvectionSchemeTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(CellSourceTermsTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(ParallelForTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(InstructionSetTest);
 
 
 int main(int /*argc*/, char ** /*argv*/) {